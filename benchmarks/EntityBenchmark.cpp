@@ -0,0 +1,209 @@
+// Times the per-step entity systems (include/systems/EntitySystems.h) and the
+// store's queries over a crowd of NPCs, dogs and flower patches.
+//
+// Usage: yolo_entity_benchmark [entities] [iterations] [workers]
+//
+// Entities are spread in equal thirds over a square area sized for one entity per
+// SPACING x SPACING pixels (a busy farm), with the player walking through the
+// middle of it; sprites are collected for the window around the player. Queries
+// are timed from QUERIES points scattered over the same area.
+// The step passes are timed again on a JobSystem with the given number of workers
+// (one per spare core by default), after checking a few seconds of movement comes
+// out the same as on one thread.
+
+#include "EntityStore.h"
+#include "EntitySystems.h"
+#include "CollisionWorld.h"
+#include "JobSystem.h"
+#include "NPC.h"
+#include "Dog.h"
+#include "FlowerPatch.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const int SPACING = 64;
+const float STEP = 1.0f / 60.0f;
+const int QUERIES = 1000;
+const float QUERY_RANGE = 100.0f;
+const int DETERMINISM_STEPS = 300;
+const int VIEW_WIDTH = 1024;
+const int VIEW_HEIGHT = 768;
+
+// Best of the iterations, in nanoseconds per call of run
+double Time(int iterations, const std::function<void()>& run) {
+    double best = 0.0;
+    for (int i = 0; i < iterations; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        if (i == 0 || ns < best) best = ns;
+    }
+    return best;
+}
+
+void Report(const char* caseName, double ns, int entities) {
+    std::printf("%-22s %10.1f us/step %8.2f ns/entity\n", caseName, ns / 1000.0, ns / entities);
+}
+
+void ReportQuery(const char* caseName, double ns) {
+    std::printf("%-22s %10.1f ns/query\n", caseName, ns / QUERIES);
+}
+
+unsigned NextRandom(unsigned& seed) {
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 8;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int entities = argc > 1 ? std::atoi(argv[1]) : 50000;
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 100;
+    int workers = argc > 3 ? std::atoi(argv[3]) : static_cast<int>(std::thread::hardware_concurrency()) - 1;
+    if (entities <= 0 || iterations <= 0 || workers < 0) {
+        std::fprintf(stderr, "Usage: %s [entities] [iterations] [workers]\n", argv[0]);
+        return 1;
+    }
+
+    // Whole chunks, so the collision world covers all of it
+    const int CHUNK_SIZE = WorldChunkData::CHUNK_SIZE;
+    int chunks = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(entities)) * SPACING / CHUNK_SIZE));
+    const int AREA = chunks * CHUNK_SIZE;
+
+    EntityStore store;
+    store.DefineStyle(SpriteSheet::NPC, NPC::GetRenderStyle());
+    store.DefineStyle(SpriteSheet::DOG, Dog::GetRenderStyle());
+    store.DefineStyle(SpriteSheet::FLOWERS_FARM, FlowerPatch::GetRenderStyle());
+    store.DefineStyle(SpriteSheet::FLOWERS_GARDEN, FlowerPatch::GetRenderStyle());
+    store.DefineArchetype(Archetype::NPC, NPC::GetArchetypeInfo());
+    store.DefineArchetype(Archetype::DOG, Dog::GetArchetypeInfo());
+    store.DefineArchetype(Archetype::FLOWER_PATCH, FlowerPatch::GetArchetypeInfo());
+
+    // Same pseudo-random positions every run
+    const std::vector<std::string> dialogue = {"Hello!", "Nice day for it."};
+    unsigned seed = 12345;
+    for (int i = 0; i < entities; ++i) {
+        float x = static_cast<float>(NextRandom(seed) % AREA);
+        float y = static_cast<float>(NextRandom(seed) % AREA);
+        switch (i % 3) {
+            case 0: NPC::Spawn(store, x, y, dialogue); break;
+            case 1: Dog::Spawn(store, x, y); break;
+            case 2: FlowerPatch::Spawn(store, x, y, dialogue, (i / 3) % 2 ? "farm" : "garden"); break;
+        }
+    }
+
+    std::printf("%zu entities over %dx%d (best of %d iterations)\n\n", store.GetCount(), AREA, AREA, iterations);
+
+    Vector2 player(AREA / 2.0f, AREA / 2.0f);
+    // The game window around the player, plus the game's cull margin
+    Rect view(static_cast<int>(player.x) - VIEW_WIDTH / 2 - 128, static_cast<int>(player.y) - VIEW_HEIGHT / 2 - 128,
+              VIEW_WIDTH + 256, VIEW_HEIGHT + 256);
+    std::vector<Vector2> points;
+    for (int i = 0; i < QUERIES; ++i) {
+        float x = static_cast<float>(NextRandom(seed) % AREA);
+        float y = static_cast<float>(NextRandom(seed) % AREA);
+        points.push_back(Vector2(x, y));
+    }
+    std::vector<SpriteInstance> sprites;
+    std::vector<EntityId> inRange;
+    int found = 0;
+
+    // Open ground over the whole area, so moving entities only turn at each other
+    CollisionWorld collisionWorld;
+    collisionWorld.Initialize(chunks * WorldChunkData::TILES, chunks * WorldChunkData::TILES);
+    collisionWorld.SetEntityStore(&store);
+    for (int chunkY = 0; chunkY < chunks; ++chunkY) {
+        for (int chunkX = 0; chunkX < chunks; ++chunkX) {
+            WorldChunkData chunk;
+            chunk.chunkX = chunkX;
+            chunk.chunkY = chunkY;
+            collisionWorld.OnChunkLoaded(chunk);
+        }
+    }
+
+    double movement = Time(iterations, [&]() { EntitySystems::UpdateMovement(store, STEP, player); });
+    Report("movement", movement, entities);
+
+    double colliding = Time(iterations, [&]() { EntitySystems::UpdateMovement(store, STEP, player, &collisionWorld); });
+    Report("movement + collision", colliding, entities);
+
+    double animation = Time(iterations, [&]() { EntitySystems::UpdateAnimation(store, STEP); });
+    Report("animation", animation, entities);
+
+    double collect = Time(iterations, [&]() {
+        sprites.clear();
+        EntitySystems::CollectSprites(store, view, sprites);
+    });
+    Report("sprite collection", collect, entities);
+
+    Report("full step", colliding + animation + collect, entities);
+    std::printf("\n");
+
+    // Same steps from the same start on one thread and on the workers
+    JobSystem jobs;
+    jobs.Initialize(workers);
+    EntityStore serialStore = store;
+    EntityStore parallelStore = store;
+    for (int step = 0; step < DETERMINISM_STEPS; ++step) {
+        collisionWorld.SetEntityStore(&serialStore);
+        EntitySystems::UpdateMovement(serialStore, STEP, player, &collisionWorld);
+        collisionWorld.SetEntityStore(&parallelStore);
+        EntitySystems::UpdateMovement(parallelStore, STEP, player, &collisionWorld, &jobs);
+    }
+    collisionWorld.SetEntityStore(&store);
+    bool identical = serialStore.GetComponents().positionX == parallelStore.GetComponents().positionX &&
+                     serialStore.GetComponents().velocityX == parallelStore.GetComponents().velocityX;
+    std::printf("%d workers, %d steps of movement %s\n", workers, DETERMINISM_STEPS,
+                identical ? "match one thread" : "DIFFER from one thread");
+
+    double parallelColliding = Time(iterations, [&]() {
+        EntitySystems::UpdateMovement(store, STEP, player, &collisionWorld, &jobs);
+    });
+    Report("movement + collision", parallelColliding, entities);
+
+    double parallelAnimation = Time(iterations, [&]() { EntitySystems::UpdateAnimation(store, STEP, &jobs); });
+    Report("animation", parallelAnimation, entities);
+
+    Report("full step", parallelColliding + parallelAnimation + collect, entities);
+    std::printf("\n");
+
+    double interact = Time(iterations, [&]() {
+        for (const Vector2& point : points) {
+            found += store.FindInteractable(point) != INVALID_ENTITY;
+        }
+    });
+    ReportQuery("interactable", interact);
+
+    double nearest = Time(iterations, [&]() {
+        for (const Vector2& point : points) {
+            found += store.FindNearest(point, QUERY_RANGE) != INVALID_ENTITY;
+        }
+    });
+    ReportQuery("nearest", nearest);
+
+    double range = Time(iterations, [&]() {
+        inRange.clear();
+        for (const Vector2& point : points) {
+            store.FindInRange(point, QUERY_RANGE, inRange);
+        }
+    });
+    ReportQuery("in range", range);
+
+    double collide = Time(iterations, [&]() {
+        for (const Vector2& point : points) {
+            found += store.CheckCollision(Rect(static_cast<int>(point.x), static_cast<int>(point.y), 32, 32));
+        }
+    });
+    ReportQuery("collision", collide);
+
+    // Keep the queries from being optimized away
+    std::printf("\n%zu sprites, %d hits, %zu in range\n", sprites.size(), found, inRange.size());
+    return 0;
+}
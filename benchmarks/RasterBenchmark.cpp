@@ -0,0 +1,178 @@
+// Micro-benchmarks for the CPU raster kernels (include/graphics/Raster.h)
+// against SDL's software renderer drawing into the same 1024x768 surface.
+// Every instruction set the CPU supports is timed.
+//
+// Usage: yolo_raster_benchmark [iterations]
+//
+// Cases mirror what the game draws: small translucent shadows (alpha 20-80),
+// grass-tuft sized blended rects, full-screen solid clears and 64x64 sprites.
+
+#include "Raster.h"
+#include <SDL.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+namespace {
+
+const int WIDTH = 1024;
+const int HEIGHT = 768;
+const int SPRITE_SIZE = 64;
+
+struct FillCase {
+    const char* name;
+    int width;
+    int height;
+    Uint8 alpha;
+    int count; // Rects per iteration
+};
+
+const FillCase FILL_CASES[] = {
+    {"shadow 24x8 a40", 24, 8, 40, 2000},
+    {"tuft 6x4 a80", 6, 4, 80, 4000},
+    {"house shadow 160x20 a20", 160, 20, 20, 500},
+    {"solid 64x64", 64, 64, 255, 500},
+    {"clear 1024x768", WIDTH, HEIGHT, 255, 4},
+};
+
+// Same pseudo-random positions for every backend
+std::vector<SDL_Rect> MakeRects(int width, int height, int count) {
+    std::vector<SDL_Rect> rects;
+    unsigned seed = 12345;
+    for (int i = 0; i < count; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        int x = static_cast<int>((seed >> 8) % static_cast<unsigned>(WIDTH - width + 1));
+        seed = seed * 1103515245u + 12345u;
+        int y = static_cast<int>((seed >> 8) % static_cast<unsigned>(HEIGHT - height + 1));
+        rects.push_back(SDL_Rect{x, y, width, height});
+    }
+    return rects;
+}
+
+// Best of the iterations, in nanoseconds per call of run
+double Time(int iterations, const std::function<void()>& run) {
+    double best = 0.0;
+    for (int i = 0; i < iterations; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        if (i == 0 || ns < best) best = ns;
+    }
+    return best;
+}
+
+void Report(const char* caseName, const char* backend, double ns, int items, long long pixels, double baselineNs) {
+    std::printf("%-26s %-8s %10.1f ns/op %9.1f Mpx/s %7.2fx\n", caseName, backend, ns / items,
+                pixels / ns * 1000.0, baselineNs / ns);
+}
+
+// Sprite with transparent surroundings, an opaque body and a soft edge
+SDL_Surface* MakeSprite() {
+    SDL_Surface* sprite = SDL_CreateRGBSurfaceWithFormat(0, SPRITE_SIZE, SPRITE_SIZE, 32, SDL_PIXELFORMAT_ARGB8888);
+    Uint32* pixels = static_cast<Uint32*>(sprite->pixels);
+    int center = SPRITE_SIZE / 2;
+    for (int y = 0; y < SPRITE_SIZE; ++y) {
+        for (int x = 0; x < SPRITE_SIZE; ++x) {
+            int dx = x - center;
+            int dy = y - center;
+            int distance = dx * dx + dy * dy;
+            Uint32 alpha = distance < 400 ? 255 : (distance < 600 ? 128 : 0);
+            pixels[y * (sprite->pitch / 4) + x] = (alpha << 24) | 0x00C08040u;
+        }
+    }
+    return sprite;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 20;
+    if (iterations <= 0) {
+        std::fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, WIDTH, HEIGHT, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer* renderer = surface ? SDL_CreateSoftwareRenderer(surface) : nullptr;
+    if (!renderer) {
+        std::fprintf(stderr, "SDL_CreateSoftwareRenderer Error: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    const Raster::Isa ISAS[] = {Raster::Isa::SCALAR, Raster::Isa::SSE2, Raster::Isa::AVX2};
+    Raster::Isa detected = Raster::GetIsa();
+    std::printf("Raster kernels: %s (best of %d iterations, speedup vs SDL)\n\n", Raster::GetIsaName(detected), iterations);
+
+    Raster::Target target = Raster::SurfaceTarget(surface);
+
+    for (const FillCase& fill : FILL_CASES) {
+        std::vector<SDL_Rect> rects = MakeRects(fill.width, fill.height, fill.count);
+        SDL_Color color = {90, 140, 60, fill.alpha};
+        long long pixels = static_cast<long long>(fill.width) * fill.height * fill.count;
+        bool blend = fill.alpha < 255;
+
+        SDL_SetRenderDrawBlendMode(renderer, blend ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+        double sdlNs = Time(iterations, [&]() {
+            for (const SDL_Rect& rect : rects) {
+                SDL_RenderFillRect(renderer, &rect);
+            }
+            SDL_RenderFlush(renderer);
+        });
+        Report(fill.name, "SDL", sdlNs, fill.count, pixels, sdlNs);
+
+        for (Raster::Isa isa : ISAS) {
+            if (!Raster::IsSupported(isa)) continue;
+            Raster::SetIsa(isa);
+            double ns = Time(iterations, [&]() {
+                for (const SDL_Rect& rect : rects) {
+                    if (blend) {
+                        Raster::FillBlend(target, rect, color);
+                    } else {
+                        Raster::FillSolid(target, rect, color);
+                    }
+                }
+            });
+            Report(fill.name, Raster::GetIsaName(isa), ns, fill.count, pixels, sdlNs);
+        }
+        Raster::SetIsa(detected);
+        std::printf("\n");
+    }
+
+    // Sprite blits: SDL_RenderCopy of the same pixels as a texture
+    SDL_Surface* sprite = MakeSprite();
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, sprite);
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    const int SPRITES = 1000;
+    std::vector<SDL_Rect> positions = MakeRects(SPRITE_SIZE, SPRITE_SIZE, SPRITES);
+    long long spritePixels = static_cast<long long>(SPRITE_SIZE) * SPRITE_SIZE * SPRITES;
+    SDL_Rect spriteRect = {0, 0, SPRITE_SIZE, SPRITE_SIZE};
+
+    double sdlNs = Time(iterations, [&]() {
+        for (const SDL_Rect& dest : positions) {
+            SDL_RenderCopy(renderer, texture, nullptr, &dest);
+        }
+        SDL_RenderFlush(renderer);
+    });
+    Report("sprite 64x64", "SDL", sdlNs, SPRITES, spritePixels, sdlNs);
+
+    for (Raster::Isa isa : ISAS) {
+        if (!Raster::IsSupported(isa)) continue;
+        Raster::SetIsa(isa);
+        double ns = Time(iterations, [&]() {
+            for (const SDL_Rect& dest : positions) {
+                Raster::BlitBlend(target, dest.x, dest.y, sprite, spriteRect);
+            }
+        });
+        Report("sprite 64x64", Raster::GetIsaName(isa), ns, SPRITES, spritePixels, sdlNs);
+    }
+    Raster::SetIsa(detected);
+
+    SDL_DestroyTexture(texture);
+    SDL_FreeSurface(sprite);
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(surface);
+    return 0;
+}
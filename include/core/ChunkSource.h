@@ -0,0 +1,98 @@
+#pragma once
+#include <SDL.h>
+#include <string>
+#include <vector>
+#include "Renderer.h"
+
+// Base layer of a tile, always drawn first
+enum class TileGround : Uint8 {
+    NONE,   // Outside the map or not resident
+    SKY,
+    GRASS
+};
+
+// Feature drawn over the ground. Overlays are drawn in enum order across
+// the whole chunk so shadows spill onto neighbors the same way they always have.
+enum class TileOverlay : Uint8 {
+    NONE,
+    WATER_TOP,
+    WATER_BOTTOM,
+    WATER_LEFT,
+    WATER_RIGHT,
+    HOUSE_ROOF,
+    HOUSE_WALL,
+    FARM,
+    GARDEN,
+    PATH_HORIZONTAL,
+    PATH_VERTICAL,
+    COUNT
+};
+
+// Per-tile flags: collision plus decoration variants
+enum TileFlags : Uint8 {
+    TILE_SOLID      = 1 << 0,
+    TILE_FLOWER_BED = 1 << 1,  // Prepared soil under a flower patch
+    TILE_BUSH       = 1 << 2,  // Decorative garden bush
+    TILE_DOOR       = 1 << 3,  // House wall with the front door
+    TILE_ROOF_RIDGE = 1 << 4   // Roof tile with the vertical ridge line
+};
+
+struct Tile {
+    TileGround ground = TileGround::NONE;
+    TileOverlay overlay = TileOverlay::NONE;
+    Uint8 flags = 0;
+
+    bool IsSolid() const { return (flags & TILE_SOLID) != 0; }
+};
+
+enum class EntityKind {
+    NPC,
+    DOG,
+    FLOWER_PATCH,
+    LANTERN     // Light only, nothing is drawn or collided with
+};
+
+// An entity that lives in a chunk, spawned when the chunk loads
+struct EntitySpawn {
+    EntityKind kind;
+    std::string name;       // NPC name or flower patch type
+    Vector2 position;
+    float patrolWidth = 0.0f;
+    std::vector<std::string> dialogue;
+};
+
+// Everything the game needs for one resident chunk
+struct WorldChunkData {
+    static const int TILE_SIZE = 128;               // Tile edge in world pixels
+    static const int TILES = 4;                     // Chunk edge in tiles
+    static const int CHUNK_SIZE = TILES * TILE_SIZE; // Chunk edge in world pixels
+
+    int chunkX = 0;
+    int chunkY = 0;
+    Uint32 loadSerial = 0;       // Bumped every time the chunk is (re)loaded
+    Tile tiles[TILES * TILES];
+    std::vector<Rect> colliders; // Sub-tile collision (e.g. bushes), world space
+    std::vector<EntitySpawn> spawns;
+
+    Tile& At(int localX, int localY) { return tiles[localY * TILES + localX]; }
+    const Tile& At(int localX, int localY) const { return tiles[localY * TILES + localX]; }
+
+    void Reset() {
+        for (auto& tile : tiles) tile = Tile();
+        colliders.clear();
+        spawns.clear();
+    }
+};
+
+// Produces chunk contents on demand. Maps can be generated or read from a
+// compiled world file (WorldFileChunkSource); the World only ever sees this interface.
+class ChunkSource {
+public:
+    virtual ~ChunkSource() = default;
+
+    virtual int GetWidthTiles() const = 0;
+    virtual int GetHeightTiles() const = 0;
+
+    // Fills a cleared chunk; returns false if the chunk could not be produced
+    virtual bool LoadChunk(int chunkX, int chunkY, WorldChunkData* chunk) = 0;
+};
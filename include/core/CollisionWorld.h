@@ -0,0 +1,53 @@
+#pragma once
+#include "ChunkSource.h"
+#include "EntityStore.h"
+#include <SDL.h>
+#include <vector>
+
+// Everything that blocks movement, for the player and entities alike.
+//
+// Static geometry lives in a sub-tile occupancy grid: each tile is split into 8x8
+// cells of 16 pixels, one bit each, in a mask per tile. Cells entirely inside a solid
+// tile or collider are solid; cells a collider only partly covers are flagged so the
+// few colliders of that chunk get an exact test. Tiles of chunks that aren't resident
+// are solid. Moving bodies are the EntityStore's collision boxes, found through its
+// spatial hash.
+class CollisionWorld {
+public:
+    CollisionWorld();
+    ~CollisionWorld() = default;
+
+    void Initialize(int widthTiles, int heightTiles);
+    void SetEntityStore(const EntityStore* entityStore) { entityStore_ = entityStore; }
+
+    // Kept in step with the World's resident chunks
+    void OnChunkLoaded(const WorldChunkData& chunk);
+    void OnChunkUnloaded(const WorldChunkData& chunk);
+
+    // The map edge, solid tiles, colliders and chunks that aren't loaded
+    bool IsBlockedStatic(const Rect& bounds) const;
+    // Static geometry or the collision box of any entity but ignore
+    bool IsBlocked(const Rect& bounds, EntityId ignore = INVALID_ENTITY) const;
+
+private:
+    struct TileMask {
+        Uint64 solid = ~0ull;
+        Uint64 partial = 0;
+    };
+
+    // Bits of the cells firstX..lastX by firstY..lastY of a tile
+    static Uint64 CellMask(int firstX, int firstY, int lastX, int lastY);
+    void RasterizeCollider(const WorldChunkData& chunk, const Rect& collider);
+    TileMask& At(int tileX, int tileY) { return tiles_[tileY * widthTiles_ + tileX]; }
+    const TileMask& At(int tileX, int tileY) const { return tiles_[tileY * widthTiles_ + tileX]; }
+
+    std::vector<TileMask> tiles_;
+    std::vector<std::vector<Rect>> colliders_; // Per chunk, for the exact test
+    int widthTiles_;
+    int heightTiles_;
+    int widthChunks_;
+    const EntityStore* entityStore_;
+
+    static const int CELL_SIZE = 16;
+    static const int CELLS = WorldChunkData::TILE_SIZE / CELL_SIZE; // Per tile edge
+};
@@ -0,0 +1,169 @@
+#pragma once
+#include "Interactable.h"
+#include "Renderer.h"
+#include "SpatialHash.h"
+#include "SpriteCache.h"
+#include <SDL.h>
+#include <string>
+#include <vector>
+
+// Handle to an entity: slot in the low bits, the slot's generation above them,
+// so handles to despawned entities stop resolving once the slot is reused
+using EntityId = Uint32;
+const EntityId INVALID_ENTITY = 0xFFFFFFFF;
+
+// What an entity is, a tag into the store's ArchetypeInfo table
+enum class Archetype : Uint8 {
+    NPC,
+    DOG,
+    FLOWER_PATCH,
+    COUNT
+};
+
+enum EntityFlags : Uint8 {
+    ENTITY_BOUNCES_OFF_PLAYER = 1 << 0, // Walking entities turn around instead of running into the player
+    ENTITY_CYCLES_DIALOGUE = 1 << 1     // NextDialogue moves on to its following line
+};
+
+// Per-archetype behaviour, looked up by tag so adding a kind of entity adds a row
+// rather than another branch in the systems
+struct ArchetypeInfo {
+    InteractableType interaction = InteractableType::NONE;
+    int interactionPriority = 0; // Higher wins over anything closer with a lower priority
+    Uint8 flags = 0;             // EntityFlags every entity of the archetype starts with
+};
+
+// How entities with a given sprite sheet are drawn and collided with
+struct RenderStyle {
+    int frames = 1;
+    float loopSeconds = 0.0f; // Animation timer wraps after this, 0 for still sprites
+    Rect bounds;              // Render bounds relative to the entity position
+    int collisionWidth = 0;   // Collision box at the entity position
+    int collisionHeight = 0;
+};
+
+// A new entity's components
+struct EntityDesc {
+    Archetype archetype = Archetype::NPC;
+    SpriteSheet sheet = SpriteSheet::NPC;
+    float x = 0.0f;
+    float y = 0.0f;
+    float velocityX = 0.0f;
+    float patrolMinX = 0.0f; // Only used while velocityX is non-zero
+    float patrolMaxX = 0.0f;
+    float interactionRadius = 50.0f;
+    Uint8 flags = 0; // On top of the archetype's
+};
+
+// Dense component arrays; a live entity's components sit at the same index in every one
+struct EntityComponents {
+    std::vector<float> positionX;
+    std::vector<float> positionY;
+    std::vector<float> previousX; // Position at the start of the current step
+    std::vector<float> previousY;
+    std::vector<float> velocityX; // Pixels per second
+    std::vector<float> targetX;   // Where movement takes it this step, until every entity has been moved
+    std::vector<float> patrolMinX;
+    std::vector<float> patrolMaxX;
+    std::vector<float> animationTime;
+    std::vector<float> interactionRadius;
+    std::vector<Uint32> dialogue;          // Slot in the store's dialogue table
+    std::vector<Uint16> dialogueLine;      // Line currently shown
+    std::vector<SpriteSheet> renderStyle;  // Also picks the store's RenderStyle
+    std::vector<Archetype> archetype;
+    std::vector<Uint8> flags;
+    std::vector<Uint32> cell; // SpatialHash bucket it is filed under
+    std::vector<EntityId> id;
+
+    size_t Size() const { return id.size(); }
+
+    template <typename Function>
+    void ForEachColumn(Function function) {
+        function(positionX);
+        function(positionY);
+        function(previousX);
+        function(previousY);
+        function(velocityX);
+        function(targetX);
+        function(patrolMinX);
+        function(patrolMaxX);
+        function(animationTime);
+        function(interactionRadius);
+        function(dialogue);
+        function(dialogueLine);
+        function(renderStyle);
+        function(archetype);
+        function(flags);
+        function(cell);
+        function(id);
+    }
+};
+
+// Every NPC, dog and flower patch in the world as structure-of-arrays components.
+// Removal swaps the last entity into the hole, so the arrays never have gaps and
+// systems (EntitySystems.h) walk them front to back. Queries by position go
+// through a spatial hash and only look at entities in nearby cells.
+class EntityStore {
+public:
+    EntityStore();
+    ~EntityStore() = default;
+
+    void DefineStyle(SpriteSheet sheet, const RenderStyle& style);
+    const RenderStyle& GetStyle(SpriteSheet sheet) const { return styles_[static_cast<int>(sheet)]; }
+    void DefineArchetype(Archetype archetype, const ArchetypeInfo& info);
+    const ArchetypeInfo& GetArchetype(Archetype archetype) const { return archetypes_[static_cast<int>(archetype)]; }
+
+    EntityId Create(const EntityDesc& desc, const std::vector<std::string>& dialogue);
+    void Destroy(EntityId entity);
+    void Clear();
+    bool IsAlive(EntityId entity) const;
+    size_t GetCount() const { return components_.Size(); }
+
+    EntityComponents& GetComponents() { return components_; }
+    const EntityComponents& GetComponents() const { return components_; }
+
+    // Refiles the entity at index in the spatial hash after its position changed
+    void Relocate(size_t index);
+
+    // Closest entity whose interaction radius reaches position, highest interaction priority first
+    EntityId FindInteractable(const Vector2& position) const;
+    // Closest entity within maxDistance of position
+    EntityId FindNearest(const Vector2& position, float maxDistance) const;
+    // Appends every entity within range of position
+    void FindInRange(const Vector2& position, float range, std::vector<EntityId>& entities) const;
+    // Appends the index of every entity positioned inside area, in index order
+    void FindIndicesInArea(const Rect& area, std::vector<Uint32>& indices) const;
+    // Whether box overlaps the collision box of any entity but ignore
+    bool CheckCollision(const Rect& box, EntityId ignore = INVALID_ENTITY) const;
+
+    InteractableType GetInteractionType(EntityId entity) const;
+    std::string GetDialogueLine(EntityId entity) const;
+    // Moves on to the next line; false if the entity always says the same thing
+    bool AdvanceDialogue(EntityId entity);
+
+private:
+    size_t IndexOf(EntityId entity) const { return slotIndex_[entity & SLOT_MASK]; }
+    Uint32 AddDialogue(const std::vector<std::string>& dialogue);
+
+    EntityComponents components_;
+    RenderStyle styles_[static_cast<int>(SpriteSheet::COUNT)];
+    ArchetypeInfo archetypes_[static_cast<int>(Archetype::COUNT)];
+    SpatialHash spatialHash_;
+
+    // How far past its position an entity can be found, for sizing query areas
+    float maxInteractionRadius_;
+    int maxCollisionWidth_;
+    int maxCollisionHeight_;
+
+    // Slot -> index into the component arrays
+    std::vector<Uint32> slotIndex_;
+    std::vector<Uint32> slotGeneration_;
+    std::vector<Uint32> freeSlots_;
+
+    // One set of lines per entity, slots reused once it despawns
+    std::vector<std::vector<std::string>> dialogues_;
+    std::vector<Uint32> freeDialogues_;
+
+    static const int SLOT_BITS = 20;
+    static const Uint32 SLOT_MASK = (1u << SLOT_BITS) - 1;
+};
@@ -1,52 +1,147 @@
 #pragma once
 #include "Player.h"
+#include "DrawList.h"
+#include "GameOptions.h"
+#include "RenderSnapshot.h"
+#include "SpriteCache.h"
 #include <SDL.h>
 #include <SDL_image.h>
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 class Renderer;
+class WorldRenderer;
+class LightMap;
+class World;
+class WorldEntitySpawner;
 class InputManager;
 class FarmingSystem;
 class PotterySystem;
+class LightingSystem;
 class Camera;
 class DialogueSystem;
-class NPCManager;
-class DynamicObjectManager;
+class EntityStore;
+class CollisionWorld;
+class JobSystem;
+class InputRecording;
+class FrameCapture;
 
 class Game {
 public:
   Game();
   ~Game();
 
-  bool Initialize();
+  bool Initialize(const GameOptions &options = GameOptions());
   void Run();
   void Shutdown();
 
   static Game &Instance() { return *instance_; }
 
 private:
+  // Simulation thread (or the main thread in lockstep for headless runs)
+  void SimulationLoop();
+  void Step(float deltaTime);
+  // Quits after a replay's last step, reporting how it went
+  void FinishReplay();
+  // Hash of the state input can steer, for checking replays
+  Uint32 HashState() const;
   void Update(float deltaTime);
+  void PublishSnapshot(std::chrono::steady_clock::time_point stepTime);
+
+  // Main thread: SDL events and drawing the latest snapshot
   void Render();
   void HandleEvents();
-  bool CheckNPCCollision(const Vector2& playerPosition) const;
+  void RegisterDrawItems();
+  void BuildFrameSprites(const Vector2& cameraOffset);
+  void MarkDirtyRegions(const Vector2& cameraOffset, bool dialogueChanged);
+
+  // An entity sprite as drawn this frame, at its interpolated position
+  struct DrawnSprite {
+    SpriteSheet sheet;
+    int frame;
+    int facing;
+    int screenX;
+    int screenY;
+    Rect bounds;       // World space, for culling
+    Rect screenBounds; // Every pixel it covers
 
-  bool running_;
+    // Drawn identically
+    bool operator==(const DrawnSprite &other) const {
+      return sheet == other.sheet && frame == other.frame && facing == other.facing &&
+             screenX == other.screenX && screenY == other.screenY;
+    }
+    // Any order consistent with ==, for diffing frames as sorted lists
+    bool operator<(const DrawnSprite &other) const {
+      if (screenY != other.screenY) return screenY < other.screenY;
+      if (screenX != other.screenX) return screenX < other.screenX;
+      if (sheet != other.sheet) return sheet < other.sheet;
+      if (frame != other.frame) return frame < other.frame;
+      return facing < other.facing;
+    }
+  };
+
+  std::atomic<bool> running_;
   SDL_Window *window_;
+  GameOptions options_;
+  int frame_number_;
+  Uint32 step_count_; // Simulation thread only
+  double step_seconds_; // Fixed simulation step
 
   std::unique_ptr<Renderer> renderer_;
+  std::unique_ptr<WorldRenderer> world_renderer_;
+  std::unique_ptr<LightMap> light_map_;
+  std::unique_ptr<DrawList> draw_list_;
   std::unique_ptr<InputManager> input_manager_;
   std::unique_ptr<FarmingSystem> farming_system_;
   std::unique_ptr<PotterySystem> pottery_system_;
+  std::unique_ptr<LightingSystem> lighting_system_;
   std::unique_ptr<Player> player_;
   std::unique_ptr<Camera> camera_;
   std::unique_ptr<DialogueSystem> dialogue_system_;
-  std::unique_ptr<NPCManager> npc_manager_;
-  std::unique_ptr<DynamicObjectManager> dynamic_object_manager_;
+  std::unique_ptr<EntityStore> entity_store_;
+  std::unique_ptr<CollisionWorld> collision_world_;
+  std::unique_ptr<JobSystem> job_system_;
+  std::unique_ptr<WorldEntitySpawner> world_entity_spawner_;
+  std::unique_ptr<World> world_;
+  std::unique_ptr<FrameCapture> frame_capture_;
+
+  // --record and --replay, simulation thread only
+  std::unique_ptr<InputRecording> recording_;
+  std::unique_ptr<InputRecording> replay_;
+  double replay_seconds_; // Spent in replayed steps
+  double replay_worst_step_seconds_;
+
+  // Simulation -> renderer
+  RenderSnapshotBuffer snapshots_;
+  const RenderSnapshot *snapshot_; // Being drawn, main thread only
+  float render_alpha_; // Interpolation from the snapshot's previous state (0) to its current one (1)
+  std::vector<DrawnSprite> frame_sprites_;
+
+  // What the last frame showed, sorted, for dirty rect tracking
+  std::vector<DrawnSprite> last_frame_sprites_;
+  std::vector<DrawnSprite> sorted_frame_sprites_;
+  Vector2 last_camera_offset_;
+  Rect dialogue_bounds_;
+
+  // Main thread -> simulation, applied at the start of the next step
+  std::mutex event_mutex_;
+  std::vector<SDL_Event> pending_events_;
+  std::vector<SDL_Event> step_events_;
+
+  DrawHandle dialogue_draw_;
+  Uint32 dialogue_render_version_;
+  Uint32 asset_generation_;
 
   static Game *instance_;
 
   const int WINDOW_WIDTH = 1024;
   const int WINDOW_HEIGHT = 768;
   const char *WINDOW_TITLE = "Yolo";
+  const int SPRITE_CULL_MARGIN = 128; // Past the view: sprites reaching in, and camera motion until the next step
+  const double ASSET_UPLOAD_BUDGET_MS = 2.0; // Texture uploads per frame
+  const double MAX_FRAME_RATE_SECONDS = 1.0 / 60.0; // Render pacing when vsync is unavailable
+  const int MAX_CATCH_UP_STEPS = 5; // Steps run back to back before the backlog is dropped
 };
\ No newline at end of file
@@ -1,33 +1,54 @@
 #pragma once
+#include "GameOptions.h"
 #include <SDL.h>
 #include <memory>
 
 class Renderer;
+class WorldRenderer;
+class LightMap;
+class DrawList;
+class World;
+class WorldEntitySpawner;
 class InputManager;
 class FarmingSystem;
 class PotterySystem;
+class LightingSystem;
 class Player;
 class Camera;
 class DialogueSystem;
-class NPCManager;
-class DynamicObjectManager;
+class EntityStore;
+class CollisionWorld;
+class JobSystem;
 
 class GameInit {
 public:
     struct InitResult {
         std::unique_ptr<Renderer> renderer;
+        std::unique_ptr<WorldRenderer> world_renderer;
+        std::unique_ptr<LightMap> light_map;
+        std::unique_ptr<DrawList> draw_list;
         std::unique_ptr<InputManager> input_manager;
         std::unique_ptr<FarmingSystem> farming_system;
         std::unique_ptr<PotterySystem> pottery_system;
+        std::unique_ptr<LightingSystem> lighting_system;
         std::unique_ptr<Player> player;
         std::unique_ptr<Camera> camera;
         std::unique_ptr<DialogueSystem> dialogue_system;
-        std::unique_ptr<NPCManager> npc_manager;
-        std::unique_ptr<DynamicObjectManager> dynamic_object_manager;
+        std::unique_ptr<EntityStore> entity_store;
+        std::unique_ptr<CollisionWorld> collision_world;
+        std::unique_ptr<JobSystem> job_system;
+        std::unique_ptr<WorldEntitySpawner> world_entity_spawner;
+        std::unique_ptr<World> world;
     };
 
-    static bool InitializeSDL();
-    static SDL_Window* CreateGameWindow(const char* title, int width, int height);
-    static InitResult InitializeGameSystems(SDL_Window* window, int window_width, int window_height);
+    // --headless, --dirty-rects, --frames <n>, --capture <n,n,...>, --capture-dir <dir>,
+    // --sim-rate <Hz>, --pixel-scale <n>, --start-hour <0-23>, --texture-budget <MB>, --workers <n>,
+    // --seed <n>, --record <file>, --replay <file>
+    static bool ParseCommandLine(int argc, char* argv[], GameOptions& options);
+    
+    static bool InitializeSDL(bool headless = false);
+    static SDL_Window* CreateGameWindow(const char* title, int width, int height, bool headless = false);
+    static InitResult InitializeGameSystems(SDL_Window* window, int window_width, int window_height,
+                                            const GameOptions& options = GameOptions());
     static void ShutdownSDL(SDL_Window* window);
 };
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// Command-line options, see GameInit::ParseCommandLine
+struct GameOptions {
+    // No visible window: SDL's dummy video driver and a software renderer
+    // drawing into an offscreen surface. Draws one frame per simulation step.
+    bool headless = false;
+
+    // Software rendering into a persistent backbuffer, redrawing and presenting
+    // only the screen regions that changed while the camera holds still
+    bool dirtyRects = false;
+
+    // Above 1: draw at the window size divided by this into an 8-bit indexed
+    // framebuffer, upscaled to the window (4 gives 256x192). Not with dirtyRects.
+    int pixelScale = 1;
+
+    // Fixed simulation steps per second; drawing interpolates between steps,
+    // so slow machines can drop to 30 and still present smoothly
+    int simulationRate = 60;
+
+    // Quit after this many frames (0 = run until quit)
+    int frameCount = 0;
+
+    // Frames (1-based) whose framebuffer is hashed and, with captureDir set,
+    // written out as frame_<n>.bmp
+    std::vector<int> captureFrames;
+    std::string captureDir;
+
+    // Loaded texture memory kept resident, in megabytes (0 = renderer default)
+    int textureBudgetMB = 0;
+
+    // Clock hour (0-23) the day starts at; night falls around 19:00
+    int startHour = 8;
+
+    // Job system threads helping the simulation thread with each step; 0 runs every
+    // job on the simulation thread for debugging, -1 picks one per spare core
+    int workerCount = -1;
+
+    // Seeds the simulation's random numbers; one is picked at launch unless set
+    unsigned int seed = 0;
+    bool hasSeed = false;
+
+    // Writes every step's input to this file on exit (.yrep)
+    std::string recordPath;
+    // Plays a recording back instead of live input, with its rate, start hour
+    // and seed, then quits and reports whether it ended in the recorded state
+    std::string replayPath;
+};
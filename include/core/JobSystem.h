@@ -0,0 +1,86 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Jobs and the order they must run in, handed to JobSystem::Run
+class JobGraph {
+public:
+    using Job = std::function<void()>;
+
+    // Dependencies are indices returned by earlier Adds; returns this job's index
+    size_t Add(Job job, const std::vector<size_t>& dependencies = {});
+    void Clear() { nodes_.clear(); }
+    size_t GetCount() const { return nodes_.size(); }
+
+private:
+    friend class JobSystem;
+
+    struct Node {
+        Job job;
+        int dependencyCount = 0;
+        std::vector<size_t> dependents;
+    };
+
+    std::vector<Node> nodes_;
+    std::unique_ptr<std::atomic<int>[]> waiting_; // Unfinished dependencies, while running
+};
+
+// Work-stealing thread pool for the simulation step. Every thread has its own
+// queue: it pushes and pops at the back, and when that runs dry it steals the
+// oldest job from the front of another. The thread that submits work runs jobs
+// too while it waits, so a job can start more jobs (a ParallelFor inside a graph
+// job) without tying up a worker.
+//
+// Work is submitted from one thread at a time (the simulation thread).
+class JobSystem {
+public:
+    JobSystem();
+    ~JobSystem();
+
+    // 0 workers runs every job on the submitting thread, in order, for debugging
+    void Initialize(int workerCount);
+    void Shutdown();
+    int GetWorkerCount() const { return static_cast<int>(workers_.size()); }
+
+    // Calls range(begin, end) over [0, count) in pieces of at most grainSize and
+    // returns once all are done. The pieces depend only on count and grainSize, so
+    // results kept per piece merge the same way with any number of workers.
+    void ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t begin, size_t end)>& range);
+
+    // Runs every job in graph, none before the jobs it depends on, and returns once all are done
+    void Run(JobGraph& graph);
+
+private:
+    struct Task {
+        std::function<void()> run;
+        std::atomic<int>* remaining = nullptr; // Counted down once it has run
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void Push(Task&& task);
+    bool TryPop(Task& task);
+    void Execute(Task& task);
+    // Runs queued jobs until remaining reaches zero
+    void WaitFor(const std::atomic<int>& remaining);
+    void StartNode(JobGraph& graph, size_t index, std::atomic<int>* remaining);
+    int CurrentQueue() const;
+    void WorkerLoop(int queue);
+
+    std::vector<std::unique_ptr<Queue>> queues_; // [0] is the submitting thread's
+    std::vector<std::thread> workers_;
+    std::atomic<int> queued_;
+
+    std::mutex sleepMutex_;
+    std::condition_variable workReady_;
+    bool stopping_;
+};
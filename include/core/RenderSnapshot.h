@@ -0,0 +1,88 @@
+#pragma once
+#include "ChunkSource.h"
+#include "SpriteCache.h"
+#include "DialogueSystem.h"
+#include "LightMap.h"
+#include <SDL.h>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+class World;
+
+// The resident chunks' tiles, copied out of the World so the renderer can bake
+// and draw them while the simulation streams chunks in and out. Same queries
+// as World, for the parts WorldRenderer uses.
+class WorldSnapshot {
+public:
+    struct Chunk {
+        int chunkX = 0;
+        int chunkY = 0;
+        Uint32 loadSerial = 0;
+        Tile tiles[WorldChunkData::TILES * WorldChunkData::TILES];
+    };
+
+    WorldSnapshot();
+
+    void Capture(const World& world);
+
+    const Chunk* GetChunk(int chunkX, int chunkY) const;
+    const Tile* GetTile(int tileX, int tileY) const; // Null when not resident or off the map
+    Rect GetPrefetchBounds() const { return prefetchBounds_; }
+
+    int GetWidthTiles() const { return widthTiles_; }
+    int GetHeightTiles() const { return heightTiles_; }
+    int GetWidthPixels() const { return widthTiles_ * WorldChunkData::TILE_SIZE; }
+    int GetHeightPixels() const { return heightTiles_ * WorldChunkData::TILE_SIZE; }
+    int GetWidthChunks() const { return widthChunks_; }
+    int GetHeightChunks() const { return heightChunks_; }
+    int GetResidentChunkCount() const { return static_cast<int>(chunks_.size()); }
+
+private:
+    std::vector<Chunk> chunks_;
+    std::vector<int> chunkIndex_; // Per map chunk, row major: index into chunks_ or -1
+    int widthTiles_;
+    int heightTiles_;
+    int widthChunks_;
+    int heightChunks_;
+    Rect prefetchBounds_;
+};
+
+// Everything Game::Render draws, as of the end of one simulation step. Frames
+// are drawn a step behind, moving from the previous positions to the current
+// ones over the step after stepTime.
+struct RenderSnapshot {
+    Uint32 step = 0; // Simulation steps taken so far
+    std::chrono::steady_clock::time_point stepTime; // When the step was due
+    Vector2 cameraOffset;
+    Vector2 previousCameraOffset;
+    std::vector<SpriteInstance> sprites; // Entities, back to front
+    WorldSnapshot world;
+    DialogueView dialogue;
+    LightingView lighting;
+};
+
+// Triple buffer between the simulation and the renderer. The simulation always
+// has a slot to write and the renderer always holds the newest complete one,
+// so neither ever waits for the other; only the slot indices are locked.
+class RenderSnapshotBuffer {
+public:
+    RenderSnapshotBuffer();
+
+    // Simulation: fill the slot from BeginWrite, then Publish it
+    RenderSnapshot& BeginWrite() { return slots_[write_]; }
+    void Publish();
+
+    // Renderer: the newest published snapshot, valid until the next call
+    // (null until the first Publish)
+    const RenderSnapshot* AcquireLatest();
+
+private:
+    RenderSnapshot slots_[3];
+    int write_;
+    int ready_;
+    int read_;
+    bool fresh_;     // ready_ holds a snapshot the renderer hasn't taken yet
+    bool published_;
+    std::mutex mutex_;
+};
@@ -0,0 +1,59 @@
+#pragma once
+#include <SDL.h>
+#include <vector>
+
+// Uniform grid of CELL_SIZE cells hashed into a fixed number of buckets, holding
+// entity indices. Entities are filed under the cell their position is in and only
+// change buckets when they cross into a cell that hashes elsewhere, so keeping it
+// current costs nothing for entities that stand still.
+class SpatialHash {
+public:
+    SpatialHash();
+    ~SpatialHash() = default;
+
+    static Uint32 BucketOf(float x, float y) { return BucketOfCell(CellOf(x), CellOf(y)); }
+
+    void Insert(Uint32 bucket, Uint32 index);
+    void Remove(Uint32 bucket, Uint32 index);
+    // An entity changed index (its array slot was reused)
+    void Renumber(Uint32 bucket, Uint32 oldIndex, Uint32 newIndex);
+    void Clear();
+
+    // Calls visit(index) once for every entity whose position is inside the cells
+    // covering [minX, maxX] x [minY, maxY], until it returns false; callers still
+    // test the exact shape
+    template <typename Visit>
+    void ForEachInArea(float minX, float minY, float maxX, float maxY,
+                       const std::vector<float>& positionX, const std::vector<float>& positionY, Visit visit) const {
+        int firstX = CellOf(minX);
+        int firstY = CellOf(minY);
+        int lastX = CellOf(maxX);
+        int lastY = CellOf(maxY);
+        for (int cellY = firstY; cellY <= lastY; ++cellY) {
+            for (int cellX = firstX; cellX <= lastX; ++cellX) {
+                for (Uint32 index : buckets_[BucketOfCell(cellX, cellY)]) {
+                    // Buckets are shared by far apart cells, skip the other cells' entities
+                    if (CellOf(positionX[index]) != cellX || CellOf(positionY[index]) != cellY) continue;
+                    if (!visit(index)) return;
+                }
+            }
+        }
+    }
+
+    static const int CELL_SIZE = 32; // About one entity across
+
+private:
+    static int CellOf(float coordinate) {
+        // Floor without the libm call, cells left of and above the origin are negative
+        float cell = coordinate * (1.0f / CELL_SIZE);
+        int truncated = static_cast<int>(cell);
+        return truncated - (cell < static_cast<float>(truncated));
+    }
+    static Uint32 BucketOfCell(int cellX, int cellY) {
+        return (static_cast<Uint32>(cellX) * 73856093u ^ static_cast<Uint32>(cellY) * 19349663u) & (BUCKET_COUNT - 1);
+    }
+
+    std::vector<std::vector<Uint32>> buckets_;
+
+    static const Uint32 BUCKET_COUNT = 8192; // Power of two
+};
@@ -0,0 +1,77 @@
+#pragma once
+#include "ChunkSource.h"
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Chunked world model. Only chunks around the camera are resident; the
+// resident set follows the camera and runs ahead of it while it moves.
+class World {
+public:
+    using ChunkCallback = std::function<void(const WorldChunkData&)>;
+
+    World();
+    ~World();
+
+    bool Initialize(std::unique_ptr<ChunkSource> source);
+    void Shutdown();
+
+    // Called after a chunk becomes resident / right before it is dropped
+    void SetChunkCallbacks(ChunkCallback onLoaded, ChunkCallback onUnloaded);
+
+    // Streams chunks in and out for the current camera view
+    void Update(const Vector2& cameraOffset, int viewWidth, int viewHeight, float deltaTime);
+
+    const WorldChunkData* GetChunk(int chunkX, int chunkY) const;
+    void ForEachResidentChunk(const ChunkCallback& visit) const;
+    const Tile* GetTile(int tileX, int tileY) const; // Null when not resident or off the map
+
+    // World-space area the renderer should keep baked (view plus prefetch)
+    Rect GetPrefetchBounds() const { return prefetchBounds_; }
+
+    int GetWidthTiles() const { return widthTiles_; }
+    int GetHeightTiles() const { return heightTiles_; }
+    int GetWidthPixels() const { return widthTiles_ * WorldChunkData::TILE_SIZE; }
+    int GetHeightPixels() const { return heightTiles_ * WorldChunkData::TILE_SIZE; }
+    int GetWidthChunks() const { return widthChunks_; }
+    int GetHeightChunks() const { return heightChunks_; }
+    int GetResidentChunkCount() const { return static_cast<int>(chunks_.size()); }
+
+private:
+    struct ChunkRange {
+        int minX, minY, maxX, maxY; // Inclusive
+
+        bool Contains(int chunkX, int chunkY) const {
+            return chunkX >= minX && chunkX <= maxX && chunkY >= minY && chunkY <= maxY;
+        }
+    };
+
+    int ChunkKey(int chunkX, int chunkY) const { return chunkY * widthChunks_ + chunkX; }
+    ChunkRange RangeForBounds(const Rect& bounds, int marginChunks) const;
+    bool LoadChunk(int chunkX, int chunkY);
+    void UnloadChunk(std::unordered_map<int, std::unique_ptr<WorldChunkData>>::iterator it);
+
+    std::unique_ptr<ChunkSource> source_;
+    std::unordered_map<int, std::unique_ptr<WorldChunkData>> chunks_;
+    std::vector<std::unique_ptr<WorldChunkData>> chunkPool_; // Recycled chunk storage
+    std::vector<int> unloadKeys_; // Scratch for Update, in the order chunks unload
+
+    ChunkCallback onChunkLoaded_;
+    ChunkCallback onChunkUnloaded_;
+
+    int widthTiles_;
+    int heightTiles_;
+    int widthChunks_;
+    int heightChunks_;
+    Uint32 nextLoadSerial_;
+
+    Vector2 lastCameraOffset_;
+    bool hasLastCamera_;
+    Rect prefetchBounds_;
+
+    static const int LOAD_MARGIN_CHUNKS = 1;      // Ring kept resident around the prefetch area
+    static const int UNLOAD_MARGIN_CHUNKS = 2;    // Hysteresis so chunks at the edge don't thrash
+    static const int MAX_PREFETCH_LOADS = 2;      // Loads per frame outside the current view
+    static constexpr float PREFETCH_SECONDS = 0.5f; // How far ahead of camera motion to look
+};
@@ -0,0 +1,30 @@
+#pragma once
+#include "ChunkSource.h"
+#include "EntityStore.h"
+#include <unordered_map>
+#include <vector>
+
+class LightingSystem;
+
+// Creates a chunk's entities and lights (lanterns, lit house windows) when it
+// streams in and removes them when it streams out
+class WorldEntitySpawner {
+public:
+    WorldEntitySpawner(EntityStore* entityStore, LightingSystem* lightingSystem);
+    ~WorldEntitySpawner() = default;
+
+    void OnChunkLoaded(const WorldChunkData& chunk);
+    void OnChunkUnloaded(const WorldChunkData& chunk);
+
+private:
+    struct ChunkEntities {
+        std::vector<EntityId> entities;
+        std::vector<Uint32> lights;
+    };
+
+    EntityStore* entityStore_;
+    LightingSystem* lightingSystem_;
+
+    // Keyed on the chunk's load serial
+    std::unordered_map<Uint32, ChunkEntities> spawned_;
+};
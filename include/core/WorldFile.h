@@ -0,0 +1,63 @@
+#pragma once
+#include "ChunkSource.h"
+#include "MappedFile.h"
+#include "WorldFormat.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+// A compiled world (see WorldFormat.h), memory-mapped. Load only checks that
+// the header and section bounds are sane; records are read in place.
+class WorldFile {
+public:
+    WorldFile();
+    ~WorldFile() = default;
+
+    bool Load(const std::string& path);
+
+    int GetWidthTiles() const { return static_cast<int>(header_->widthTiles); }
+    int GetHeightTiles() const { return static_cast<int>(header_->heightTiles); }
+    int GetWidthChunks() const;
+
+    const WorldFormat::TileRecord& GetTile(int tileX, int tileY) const;
+    const WorldFormat::RectRecord* GetColliders() const { return Records<WorldFormat::RectRecord>(header_->colliders); }
+    const WorldFormat::SpawnRecord* GetSpawns() const { return Records<WorldFormat::SpawnRecord>(header_->spawns); }
+    const uint32_t* GetChunkColliders() const { return Records<uint32_t>(header_->chunkColliders); }
+    const WorldFormat::ChunkRecord& GetChunk(int chunkX, int chunkY) const;
+
+    size_t GetColliderCount() const { return header_->colliders.count; }
+    size_t GetSpawnCount() const { return header_->spawns.count; }
+    size_t GetChunkColliderCount() const { return header_->chunkColliders.count; }
+
+    size_t GetZoneCount() const { return header_->zones.count; }
+    const WorldFormat::ZoneRecord& GetZone(size_t index) const { return Records<WorldFormat::ZoneRecord>(header_->zones)[index]; }
+
+    // Empty string / no lines when the reference is out of range
+    const char* GetString(uint32_t offset) const;
+    std::vector<std::string> GetLines(uint32_t firstLine, uint32_t lineCount) const;
+
+private:
+    template <typename T>
+    const T* Records(const WorldFormat::Section& section) const {
+        return reinterpret_cast<const T*>(file_.GetData() + section.offset);
+    }
+
+    bool CheckSection(const WorldFormat::Section& section, size_t recordSize, const char* name) const;
+
+    MappedFile file_;
+    const WorldFormat::Header* header_;
+    std::string path_;
+};
+
+// Streams chunks out of a WorldFile
+class WorldFileChunkSource : public ChunkSource {
+public:
+    explicit WorldFileChunkSource(std::unique_ptr<WorldFile> file);
+
+    int GetWidthTiles() const override { return file_->GetWidthTiles(); }
+    int GetHeightTiles() const override { return file_->GetHeightTiles(); }
+    bool LoadChunk(int chunkX, int chunkY, WorldChunkData* chunk) override;
+
+private:
+    std::unique_ptr<WorldFile> file_;
+};
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstdint>
+
+// Compiled world file (.ywld), written by tools/WorldCompiler.cpp and mapped
+// straight into memory by WorldFile. Little-endian, every section starts on a
+// 4-byte boundary and holds fixed-size records, so nothing is parsed at load.
+//
+// Layout: Header, then the sections it points at, in any order.
+namespace WorldFormat {
+
+const char MAGIC[4] = {'Y', 'W', 'L', 'D'};
+const uint32_t VERSION = 1;
+
+struct Section {
+    uint32_t offset; // Bytes from the start of the file
+    uint32_t count;  // Records (not bytes)
+};
+
+struct Header {
+    char magic[4];
+    uint32_t version;
+    uint32_t widthTiles;
+    uint32_t heightTiles;
+    uint32_t tileSize;   // Must match WorldChunkData::TILE_SIZE
+    uint32_t chunkTiles; // Must match WorldChunkData::TILES
+
+    Section tiles;          // TileRecord, widthTiles * heightTiles, row major
+    Section colliders;      // RectRecord, sub-tile collision in world pixels
+    Section zones;          // ZoneRecord, static interaction zones
+    Section spawns;         // SpawnRecord, grouped by chunk
+    Section chunks;         // ChunkRecord, one per chunk, row major
+    Section chunkColliders; // uint32_t indices into colliders, grouped by chunk
+    Section lines;          // uint32_t offsets into strings, dialogue lines
+    Section strings;        // char, NUL-terminated strings back to back
+};
+
+struct TileRecord {
+    uint8_t ground;  // TileGround
+    uint8_t overlay; // TileOverlay
+    uint8_t flags;   // TileFlags
+    uint8_t reserved;
+};
+
+struct RectRecord {
+    int32_t x, y, w, h;
+};
+
+struct ZoneRecord {
+    RectRecord bounds;
+    uint32_t type; // InteractableType
+    uint32_t firstLine;
+    uint32_t lineCount;
+};
+
+struct SpawnRecord {
+    uint32_t kind; // EntityKind
+    uint32_t name; // Offset into strings
+    float x, y;
+    float patrolWidth;
+    uint32_t firstLine;
+    uint32_t lineCount;
+};
+
+// What streams in with a chunk: a run of spawns and a run of collider indices
+// (colliders crossing a chunk edge are listed by every chunk they touch)
+struct ChunkRecord {
+    uint32_t firstSpawn;
+    uint32_t spawnCount;
+    uint32_t firstCollider;
+    uint32_t colliderCount;
+};
+
+} // namespace WorldFormat
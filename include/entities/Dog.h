@@ -1,39 +1,25 @@
 #pragma once
-#include "InteractableObject.h"
+#include "EntityStore.h"
+#include "SpriteCache.h"
 
-class Dog : public InteractableObject {
+// Dog archetype: runs back and forth along its patrol, turning at either end and at the player
+class Dog {
 public:
-    Dog(float startX, float startY, float patrolWidth = 200.0f);
-    ~Dog() = default;
+    static EntityId Spawn(EntityStore& store, float startX, float startY, float patrolWidth = 200.0f);
     
-    void Update(float deltaTime) override;
-    void Render(Renderer* renderer, Vector2 cameraOffset) override;
+    static RenderStyle GetRenderStyle();
+    static ArchetypeInfo GetArchetypeInfo();
     
-    // Dog-specific methods
-    void SetPatrolArea(float centerX, float centerY, float width);
-    void SetSpeed(float speed) { speed_ = speed; }
-    void UpdateWithPlayerPosition(float deltaTime, const Vector2& playerPosition);
-    
-protected:
-    void RenderObject(Renderer* renderer, Vector2 cameraOffset) override;
+    // Pre-rendered animation frames, registered with the renderer's SpriteCache
+    static SpriteSheetDesc GetSpriteSheet();
     
 private:
-    void UpdateMovement(float deltaTime);
-    void CheckBounds();
-    bool CheckPlayerCollision(const Vector2& playerPosition);
-    
-    // Movement properties
-    float speed_;
-    float patrolCenterX_;
-    float patrolWidth_;
-    float minX_, maxX_;
-    int direction_; // -1 for left, 1 for right
-    
-    // Visual properties
-    bool facingRight_;
-    float animationTimer_;
+    static void PaintSprite(Renderer* renderer, int screenX, int screenY, int frame, int facing);
     
     // Dog dimensions
-    const int DOG_WIDTH = 24;
-    const int DOG_HEIGHT = 16;
+    static const int DOG_WIDTH = 24;
+    static const int DOG_HEIGHT = 16;
+    static const int DOG_FRAMES = 12; // Over the one second animation loop
+    static constexpr float SPEED = 80.0f;
+    static constexpr float INTERACTION_RADIUS = 40.0f; // Slightly larger interaction area for the dog
 };
\ No newline at end of file
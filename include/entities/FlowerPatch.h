@@ -1,25 +1,31 @@
 #pragma once
-#include "InteractableObject.h"
+#include "EntityStore.h"
+#include "SpriteCache.h"
+#include <string>
+#include <vector>
 
-class FlowerPatch : public InteractableObject {
+// Flower patch archetype: sways in place and describes itself when talked to
+class FlowerPatch {
 public:
-    FlowerPatch(float x, float y, const std::vector<std::string>& dialogue, 
-                const std::string& patchType = "mixed");
-    ~FlowerPatch() = default;
+    // patchType "farm" gets the farm flowers, anything else ("mixed", "garden") the garden ones
+    static EntityId Spawn(EntityStore& store, float x, float y, const std::vector<std::string>& dialogue,
+                          const std::string& patchType = "mixed");
     
-    void Update(float deltaTime) override;
-    void Render(Renderer* renderer, Vector2 cameraOffset) override;
+    static RenderStyle GetRenderStyle();
+    static ArchetypeInfo GetArchetypeInfo();
     
-    void SetPatchType(const std::string& type) { patchType_ = type; }
-    
-protected:
-    void RenderObject(Renderer* renderer, Vector2 cameraOffset) override;
+    // Pre-rendered sway frames for "farm" patches or all other (garden) patches
+    static SpriteSheetDesc GetSpriteSheet(bool farm);
     
 private:
-    std::string patchType_; // "mixed", "farm", "garden"
-    float animationTimer_;
+    static void PaintFarmSprite(Renderer* renderer, int screenX, int screenY, int frame, int facing);
+    static void PaintGardenSprite(Renderer* renderer, int screenX, int screenY, int frame, int facing);
+    static void PaintFlowers(Renderer* renderer, int screenX, int screenY, int frame, bool farm);
     
     // Flower patch dimensions
-    const int PATCH_WIDTH = 35;
-    const int PATCH_HEIGHT = 35;
+    static const int PATCH_WIDTH = 35;
+    static const int PATCH_HEIGHT = 35;
+    static const int FLOWER_FRAMES = 20; // Over the animation loop
+    static constexpr float ANIMATION_LOOP = 10.0f; // Seconds
+    static constexpr float INTERACTION_RADIUS = 25.0f;
 };
\ No newline at end of file
@@ -1,37 +1,25 @@
 #pragma once
-#include "Renderer.h"
-#include "Interactable.h"
+#include "EntityStore.h"
+#include "SpriteCache.h"
 #include <SDL.h>
+#include <string>
 #include <vector>
 
-class NPC : public Interactable {
+// NPC archetype: stands still, blocks the player and talks through its lines in turn
+class NPC {
 public:
-  NPC();
-  NPC(int xPosition, int yPosition);
-  NPC(int xPosition, int yPosition, const std::vector<std::string>& dialogue);
-  ~NPC();
+  static EntityId Spawn(EntityStore& store, float x, float y, const std::vector<std::string>& dialogue);
   
-  void SetDialogue(const std::vector<std::string>& dialogue);
-  Rect GetCollisionBounds() const;
-
-  // Interactable interface implementation
-  void Update(float deltaTime) override;
-  void Render(Renderer* renderer, Vector2 cameraOffset) override;
-  Vector2 GetPosition() const override;
-  Rect GetInteractionBounds() const override;
-  InteractableType GetType() const override;
-  std::vector<std::string> GetDialogue() const override;
-  float GetInteractionRadius() const override { return 45.0f; }
+  static RenderStyle GetRenderStyle();
+  static ArchetypeInfo GetArchetypeInfo();
   
-  // Dialogue management
-  std::string GetCurrentDialogue() const;
-  void NextDialogue();
+  // Pre-rendered sprite, registered with the renderer's SpriteCache
+  static SpriteSheetDesc GetSpriteSheet();
 
 private:
-  Vector2 position_;
-  std::vector<std::string> dialogue_;
-  int currentDialogueIndex_;
+  static void PaintSprite(Renderer* renderer, int screenX, int screenY, int frame, int facing);
 
-  const int NPC_WIDTH = 32;
-  const int NPC_HEIGHT = 32;
+  static const int NPC_WIDTH = 32;
+  static const int NPC_HEIGHT = 32;
+  static constexpr float INTERACTION_RADIUS = 45.0f;
 };
\ No newline at end of file
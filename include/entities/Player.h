@@ -2,6 +2,7 @@
 #include <SDL.h>
 #include <functional>
 #include "Renderer.h"
+#include "SpriteCache.h"
 
 class InputManager;
 
@@ -13,20 +14,33 @@ public:
     
     void HandleInput(InputManager* input_manager);
     void Update(float deltaTime);
-    void Render(Renderer* renderer, const Vector2& cameraOffset);
+    SpriteInstance GetSprite() const;
     
     Vector2 GetPosition() const { return position_; }
-    void SetPosition(const Vector2& position) { position_ = position; }
+    void SetPosition(const Vector2& position) { position_ = position; previousPosition_ = position; }
+    Vector2 GetVelocity() const { return velocity_; } // Also which way it faces
     
     bool CheckCollision(const Vector2& newPosition) const;
     void SetCollisionCallback(std::function<bool(const Vector2&)> callback);
+    void SetWorldSize(int width, int height);
+    
+    int GetWidth() const { return PLAYER_WIDTH; }
+    int GetHeight() const { return PLAYER_HEIGHT; }
+    
+    // Pre-rendered sprite, registered with the renderer's SpriteCache
+    static SpriteSheetDesc GetSpriteSheet();
     
 private:
+    static void PaintSprite(Renderer* renderer, int screenX, int screenY, int frame, int facing);
+    
     Vector2 position_;
+    Vector2 previousPosition_; // At the start of the current step
     Vector2 velocity_;
     float speed_;
     std::function<bool(const Vector2&)> externalCollisionCheck_;
+    int worldWidth_;
+    int worldHeight_;
     
-    const int PLAYER_WIDTH = 32;
-    const int PLAYER_HEIGHT = 32;
+    static const int PLAYER_WIDTH = 32;
+    static const int PLAYER_HEIGHT = 32;
 };
\ No newline at end of file
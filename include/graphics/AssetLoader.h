@@ -0,0 +1,74 @@
+#pragma once
+#include <SDL.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Background asset loading. Worker threads do the file I/O and image decoding;
+// the main thread only runs the completion callbacks (texture creation), within
+// a per-frame time budget.
+class AssetLoader {
+public:
+    // Decoded image, handed to the callback on the main thread, which takes
+    // ownership (null on failure)
+    using ImageCallback = std::function<void(SDL_Surface* surface)>;
+    // Raw file contents, handed to the callback on the main thread (empty on failure)
+    using FileCallback = std::function<void(std::vector<char>&& data)>;
+
+    AssetLoader();
+    ~AssetLoader();
+
+    bool Initialize(int workerCount);
+    // Pending callbacks are dropped without being called
+    void Shutdown();
+
+    // Decodes the image in the background
+    void RequestImage(const std::string& path, ImageCallback onLoaded);
+    // Reads the first of the paths that exists in the background
+    void RequestFile(const std::vector<std::string>& paths, FileCallback onLoaded);
+
+    // Main thread, once per frame: runs completion callbacks until the budget
+    // is spent (always at least one)
+    void Update(double budgetMs);
+
+    // Blocks until every request so far is loaded (startup, headless runs)
+    void Finish();
+
+    // Bumped whenever something finished loading, so cached output can be redrawn
+    Uint32 GetGeneration() const { return generation_; }
+    size_t GetPendingCount() const { return pending_; }
+
+private:
+    struct Job {
+        std::vector<std::string> paths;
+        ImageCallback onImage; // Image job when set, file job otherwise
+        FileCallback onFile;
+    };
+
+    struct Result {
+        SDL_Surface* surface = nullptr;
+        std::vector<char> data;
+        ImageCallback onImage;
+        FileCallback onFile;
+    };
+
+    void WorkerLoop();
+    void Complete(Result& result);
+    bool WaitForResult(Result& result);
+    void Enqueue(Job&& job);
+
+    size_t pending_;
+    Uint32 generation_;
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable jobReady_;
+    std::condition_variable resultReady_;
+    std::deque<Job> jobs_;
+    std::deque<Result> results_;
+    bool stopping_;
+};
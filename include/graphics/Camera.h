@@ -8,8 +8,11 @@ public:
     
     void SetTarget(const Vector2& target);
     void Update(float deltaTime);
+    // Jumps to the target with nothing to interpolate from (first frame, teleports)
+    void SnapToTarget();
     
     Vector2 GetOffset() const { return offset_; }
+    Vector2 GetPreviousOffset() const { return previousOffset_; } // At the start of the current step
     Vector2 WorldToScreen(const Vector2& worldPos) const;
     Vector2 ScreenToWorld(const Vector2& screenPos) const;
     
@@ -25,6 +28,7 @@ private:
     Vector2 position_;
     Vector2 target_;
     Vector2 offset_;
+    Vector2 previousOffset_;
     
     int viewportWidth_;
     int viewportHeight_;
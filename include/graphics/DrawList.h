@@ -0,0 +1,84 @@
+#pragma once
+#include "Renderer.h"
+#include <functional>
+#include <vector>
+
+// Submission order, back to front
+enum class DrawLayer {
+    WORLD,
+    ENTITIES,
+    LIGHTING,
+    UI,
+    COUNT
+};
+
+using DrawHandle = int;
+const DrawHandle INVALID_DRAW_HANDLE = -1;
+
+struct DrawListStats {
+    int layersDrawn = 0;     // Layers whose items were called this frame
+    int layersReplayed = 0;  // Unchanged layers replayed from their recording
+    int layersSorted = 0;    // Layers that needed re-sorting
+    int sortShifts = 0;      // Insertion sort element moves (0 when already sorted)
+};
+
+// Retained list of draw items. Items stay registered between frames; a layer
+// is only re-sorted when a sort key changes and, if cached, only re-drawn from
+// its items when something in it was invalidated.
+class DrawList {
+public:
+    using DrawCallback = std::function<void(Renderer*, const Vector2&)>;
+
+    DrawList();
+    ~DrawList() = default;
+
+    DrawHandle Add(DrawLayer layer, DrawCallback draw, float sortY = 0.0f);
+    void Remove(DrawHandle handle);
+
+    // Depth within a y-sorted layer (usually the bottom edge of the sprite)
+    void SetSortY(DrawHandle handle, float sortY);
+
+    // The item will look different next frame, its layer can't be replayed
+    void Invalidate(DrawHandle handle);
+
+    void SetLayerYSorted(DrawLayer layer, bool ySorted);
+    // Cached layers record their output and replay it while nothing changed.
+    // Screen-space layers ignore the camera; world-space ones also re-draw when it moves.
+    void SetLayerCached(DrawLayer layer, bool cached, bool screenSpace);
+
+    void Submit(Renderer* renderer, const Vector2& cameraOffset);
+
+    const DrawListStats& GetFrameStats() const { return stats_; }
+    size_t GetItemCount(DrawLayer layer) const { return layers_[static_cast<int>(layer)].order.size(); }
+
+private:
+    struct Item {
+        DrawLayer layer;
+        DrawCallback draw;
+        float sortY;
+        Uint32 sequence; // Insertion order, breaks sortY ties so the order is stable
+        bool alive;
+    };
+
+    struct Layer {
+        std::vector<DrawHandle> order;
+        bool ySorted = false;
+        bool needsSort = false;
+        bool cached = false;
+        bool screenSpace = false;
+        bool contentDirty = true;
+        DrawRecording recording;
+        Vector2 recordedOffset;
+    };
+
+    bool DrawsBefore(DrawHandle a, DrawHandle b) const;
+    void SortLayer(Layer& layer);
+    Layer& LayerOf(DrawHandle handle) { return layers_[static_cast<int>(items_[handle].layer)]; }
+    bool IsValid(DrawHandle handle) const;
+
+    std::vector<Item> items_;
+    std::vector<DrawHandle> freeHandles_;
+    Layer layers_[static_cast<int>(DrawLayer::COUNT)];
+    Uint32 nextSequence_;
+    DrawListStats stats_;
+};
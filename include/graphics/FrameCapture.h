@@ -0,0 +1,27 @@
+#pragma once
+#include <SDL.h>
+#include <string>
+#include <vector>
+
+class Renderer;
+
+// Reads back the framebuffer at chosen frames, prints an FNV-1a hash of the
+// pixels and optionally saves them as BMP. Used by the headless mode to
+// regression-test rendering changes.
+class FrameCapture {
+public:
+    FrameCapture(const std::vector<int>& frames, const std::string& directory);
+    ~FrameCapture() = default;
+
+    bool ShouldCapture(int frame) const;
+
+    // Call after the frame is drawn and before it is presented
+    bool Capture(Renderer* renderer, int frame);
+
+    // Hash of the visible pixels only (row padding is skipped)
+    static Uint64 HashPixels(const SDL_Surface* surface);
+
+private:
+    std::vector<int> frames_; // Sorted
+    std::string directory_;
+};
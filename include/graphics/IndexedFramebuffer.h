@@ -0,0 +1,45 @@
+#pragma once
+#include <SDL.h>
+#include <vector>
+
+// 8-bit palette-indexed frame at native resolution. Frames are drawn in ARGB by
+// SDL's software renderer (it can't blend into 8-bit surfaces) and quantized
+// here once; the display palette is only applied when expanding back out, so
+// palette effects like day and night cost nothing per pixel drawn.
+class IndexedFramebuffer {
+public:
+    IndexedFramebuffer();
+
+    void Initialize(int width, int height);
+
+    // Source is an ARGB8888 surface of the same size
+    void Quantize(const SDL_Surface* source);
+
+    // Display palette is the base palette multiplied by the tint (white = unchanged)
+    void SetTint(SDL_Color tint);
+    SDL_Color GetTint() const { return tint_; }
+
+    // Writes the frame as ARGB8888, each index as a scale x scale block
+    void Expand(void* pixels, int pitch, int scale) const;
+
+    int GetWidth() const { return width_; }
+    int GetHeight() const { return height_; }
+
+    static const int PALETTE_SIZE = 256;
+
+private:
+    int width_;
+    int height_;
+    std::vector<Uint8> indices_;
+
+    SDL_Color palette_[PALETTE_SIZE];
+    Uint32 display_[PALETTE_SIZE]; // ARGB8888
+    SDL_Color tint_;
+
+    // Nearest palette index for every RGB555 color
+    std::vector<Uint8> quantize_;
+
+    // Base palette: a color cube with this many levels per channel, then a gray ramp
+    static const int CUBE_LEVELS = 6;
+    static const int GRAY_LEVELS = PALETTE_SIZE - CUBE_LEVELS * CUBE_LEVELS * CUBE_LEVELS;
+};
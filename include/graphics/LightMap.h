@@ -0,0 +1,85 @@
+#pragma once
+#include "Renderer.h"
+#include <SDL.h>
+#include <vector>
+
+// A light in the world, e.g. a lit house window or a lantern
+struct PointLight {
+    Uint32 id = 0;
+    int x = 0;           // Center, world pixels
+    int y = 0;
+    int radius = 0;      // Falls off to nothing here, world pixels
+    SDL_Color color = {255, 255, 255, 255}; // Alpha is the intensity
+};
+
+// Lighting as the simulation last published it
+struct LightingView {
+    int sunStep = 0;               // Time of day in LightMap::SUN_STEPS steps from midnight
+    Uint32 version = 0;            // Bumped whenever a light is added, removed or changed
+    std::vector<PointLight> lights; // Ascending id
+};
+
+// Day/night lighting as a low-resolution map of light levels around the camera,
+// multiplied over the finished frame in a single stretched copy. Lights are
+// summed into the map once and only re-stamped when they change, and the sun
+// only re-resolves the map when it reaches the next step, so a frame costs the
+// same however many lights there are.
+class LightMap {
+public:
+    LightMap();
+    ~LightMap();
+
+    // Sized to cover a view of this many pixels wherever the camera is
+    void Initialize(int viewWidth, int viewHeight);
+    void Shutdown();
+
+    // Drops the texture (e.g. after SDL_RENDER_DEVICE_RESET); Update re-creates it
+    void Invalidate();
+
+    // Catches the map up with the lighting; true when the overlay looks
+    // different from last frame
+    bool Update(Renderer* renderer, const LightingView& lighting, const Vector2& cameraOffset);
+
+    // Multiplies the light over the screen; nothing is drawn in full daylight
+    void Render(Renderer* renderer, const Vector2& cameraOffset);
+
+    int GetLightCount() const { return static_cast<int>(lights_.size()); }
+    int GetCellsStampedLastUpdate() const { return cellsStamped_; }
+
+    static const int SUN_STEPS = 96; // Every 15 minutes of game time
+
+private:
+    void Restamp(const LightingView& lighting);
+    void ApplyLightChanges(const std::vector<PointLight>& lights);
+    void Stamp(const PointLight& light, int sign);
+    bool SetSun(int sunStep);
+    void MarkDirty(const SDL_Rect& cells);
+    void Upload();
+    SDL_Color ResolveCell(int cell) const;
+    static bool SameLight(const PointLight& a, const PointLight& b);
+
+    SDL_Texture* texture_;
+    int widthCells_;
+    int heightCells_;
+    int originX_; // World position of the first cell, snapped to ORIGIN_STEP
+    int originY_;
+    bool valid_;  // light_ holds lights_ stamped at originX_/originY_
+
+    std::vector<PointLight> lights_; // What is stamped, ascending id
+    Uint32 lightsVersion_;
+    std::vector<int> light_;         // Summed light per cell, RGB
+    std::vector<Uint32> pixels_;     // Resolved ARGB8888 texels
+
+    int sunStep_;
+    SDL_Color ambient_; // Sky light at the current sun step
+    int glow_;          // How much the lights show, 0 (noon) to 256 (night)
+    bool neutral_;      // Full daylight: the overlay would change nothing
+
+    SDL_Rect dirty_;  // Cells to resolve and upload
+    bool hasDirty_;
+    bool uploadAll_;  // Texture contents lost or never written
+    int cellsStamped_;
+
+    static const int CELL_SIZE = 16;     // World pixels per light map texel
+    static const int ORIGIN_STEP = 512;  // The map only recenters when the camera crosses these
+};
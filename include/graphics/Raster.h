@@ -0,0 +1,37 @@
+#pragma once
+#include <SDL.h>
+
+// CPU rasterization into ARGB8888 pixels, for the renderer's software paths.
+// Every kernel has a scalar, an SSE2 and an AVX2 version; the fastest one the
+// CPU supports is picked on first use. All versions produce identical pixels.
+// Blending is non-premultiplied source-over, rounded to nearest.
+namespace Raster {
+
+enum class Isa {
+    SCALAR,
+    SSE2,
+    AVX2
+};
+
+// Pixels to draw into; nothing outside clip is touched
+struct Target {
+    Uint32* pixels = nullptr;
+    int pitch = 0; // In pixels
+    SDL_Rect clip = {0, 0, 0, 0};
+};
+
+// Whole surface as the clip; the surface must be ARGB8888 and not need locking
+Target SurfaceTarget(SDL_Surface* surface);
+
+void FillSolid(const Target& target, const SDL_Rect& rect, SDL_Color color);
+void FillBlend(const Target& target, const SDL_Rect& rect, SDL_Color color);
+
+// Blends srcRect of an ARGB8888 surface with its per-pixel alpha, top left at x/y
+void BlitBlend(const Target& target, int x, int y, const SDL_Surface* source, const SDL_Rect& srcRect);
+
+Isa GetIsa();
+bool IsSupported(Isa isa);
+void SetIsa(Isa isa); // Benchmarks only; ignored when unsupported
+const char* GetIsaName(Isa isa);
+
+} // namespace Raster
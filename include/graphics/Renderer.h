@@ -4,8 +4,16 @@
 #include <string>
 #include <unordered_map>
 #include <memory>
+#include <vector>
+#include "AssetLoader.h"
+#include "TextureCache.h"
+#include "SpriteAtlas.h"
+#include "IndexedFramebuffer.h"
+#include "Raster.h"
 
 class TextRenderer;
+class SpriteCache;
+enum class SpriteSheet;
 
 struct Vector2 {
     float x, y;
@@ -17,26 +25,136 @@ struct Rect {
     Rect(int x = 0, int y = 0, int w = 0, int h = 0) : x(x), y(y), w(w), h(h) {}
 };
 
+// Per-frame submission counters
+struct RenderStats {
+    int drawCalls = 0;       // Fill/copy/geometry calls issued to SDL
+    int stateChanges = 0;    // Draw color or blend mode switches
+    int rectsSubmitted = 0;  // DrawRect calls recorded into the command buffer
+    int rectBatches = 0;     // Color/blend groups those rects were merged into
+    int drawsCulled = 0;     // Rects/textures rejected as off screen before reaching SDL
+    int tilesCulled = 0;     // World tiles and chunks skipped by the culling stage
+    int objectsCulled = 0;   // Entities skipped by the culling stage
+    int regionsRedrawn = 0;  // Dirty regions redrawn, a full redraw counts as one
+    int pixelsRedrawn = 0;   // Screen area those regions cover
+    int rasterCalls = 0;     // Rect batches and sprites drawn by the CPU kernels instead of SDL
+};
+
+// One draw call captured while recording; textures must outlive the recording
+struct RecordedDraw {
+    enum class Type { RECT, TEXTURE, TEXT, WRAPPED_TEXT };
+    
+    Type type;
+    SDL_Rect rect;          // RECT: destination, TEXTURE: x/y plus w/h when stretched, TEXT: x/y,
+                            // WRAPPED_TEXT: x/y plus w = max width
+    SDL_Rect srcRect;
+    bool hasSrcRect;
+    SDL_Texture* texture;
+    SDL_Color color;
+    SDL_BlendMode blendMode;
+    int fontSize;
+    std::string text;
+};
+using DrawRecording = std::vector<RecordedDraw>;
+
 class Renderer {
 public:
     Renderer();
     ~Renderer();
     
-    bool Initialize(SDL_Window* window);
+    // Headless renders in software into an offscreen surface instead of the window.
+    // Dirty rect tracking also renders in software into our own surface, which
+    // keeps the last frame, so only what changed needs redrawing and presenting.
+    // A pixel scale above 1 draws at the window size divided by it into an
+    // 8-bit indexed frame, upscaled to the window in one copy; drawing code
+    // keeps using window coordinates. Dirty rects need a pixel scale of 1.
+    bool Initialize(SDL_Window* window, bool headless = false, bool dirtyRects = false, int pixelScale = 1);
     void Shutdown();
     
     void Clear();
+    void Clear(SDL_Color color);
     void Present();
+    bool HasVSync() const { return vsync_; } // Present waits for the display
+    
+    // Indexed frame only: the palette is applied on Present, nothing is redrawn
+    bool IsIndexed() const { return indexed_framebuffer_ != nullptr; }
+    void SetPaletteTint(SDL_Color tint);
+    
+    // Partial redraw: mark the screen rects that changed since the last frame,
+    // then redraw each region from BuildDirtyRegions clipped to it; Present
+    // shows only those. Everything is redrawn after MarkAllDirty, on the first
+    // frame, or when the regions would cover most of the screen anyway.
+    bool IsTrackingDirtyRects() const { return dirty_tracking_; }
+    void MarkDirty(const Rect& screenRect);
+    void MarkAllDirty() { full_redraw_ = true; }
+    const std::vector<SDL_Rect>& BuildDirtyRegions(); // Valid until Present
+    
+    // Clips screen draws (not render-target draws) and narrows culling to match; null clears it
+    void SetClipRect(const SDL_Rect* rect);
+    
+    // Software modes fill screen rects with the CPU kernels in Raster.h rather than through SDL
+    bool UsesCpuRaster() const { return framebuffer_ != nullptr; }
+    // Blends srcRect of an ARGB8888 surface onto the screen with the CPU kernels.
+    // False when that isn't possible here (GPU, render target, scaled or recording);
+    // draw the equivalent texture instead.
+    bool BlitSurface(const SDL_Surface* source, const Rect& srcRect, const Vector2& position);
+    
+    // Starts loading in the background; draws show a placeholder until it resolves.
+    // Every LoadTexture needs a matching ReleaseTexture.
+    TextureHandle LoadTexture(const std::string& path);
+    void ReleaseTexture(TextureHandle handle);
+    SDL_Texture* GetTexture(TextureHandle handle) { return texture_cache_ ? texture_cache_->Get(handle) : nullptr; }
+    AssetLoader* GetAssetLoader() { return asset_loader_.get(); }
+    TextureCache* GetTextureCache() { return texture_cache_.get(); }
     
-    SDL_Texture* LoadTexture(const std::string& path);
     void DrawTexture(SDL_Texture* texture, const Vector2& position, const Rect* srcRect = nullptr);
+    void DrawTexture(TextureHandle texture, const Vector2& position, const Rect* srcRect = nullptr);
+    void DrawTextureStretched(SDL_Texture* texture, const Rect& destRect, const Rect* srcRect = nullptr);
     void DrawRect(const Rect& rect, SDL_Color color);
-    void DrawTile(SDL_Texture* texture, int tileIndex, const Vector2& position, int tileSize = 32);
+    void DrawTile(TextureHandle texture, int tileIndex, const Vector2& position, int tileSize = 32);
+    
+    // Cooked sprite atlas (see tools/AssetCooker.cpp); resolve IDs once, draw by ID
+    bool LoadSpriteAtlas(const std::string& indexPath);
+    SpriteId GetSpriteId(const std::string& name) const { return sprite_atlas_.GetSpriteId(name); }
+    void DrawSprite(SpriteId sprite, const Vector2& position);
+    
+    // Pre-rendered procedural entity sprites (see SpriteCache)
+    SpriteCache* GetSpriteCache() { return sprite_cache_.get(); }
+    void DrawCachedSprite(SpriteSheet sheet, int frame, int facing, const Vector2& position);
     
     // Camera-aware drawing methods
     void DrawTextureWorld(SDL_Texture* texture, const Vector2& worldPosition, const Vector2& cameraOffset, const Rect* srcRect = nullptr);
     void DrawRectWorld(const Rect& worldRect, const Vector2& cameraOffset, SDL_Color color);
-    void DrawTileWorld(SDL_Texture* texture, int tileIndex, const Vector2& worldPosition, const Vector2& cameraOffset, int tileSize = 32);
+    void DrawTileWorld(TextureHandle texture, int tileIndex, const Vector2& worldPosition, const Vector2& cameraOffset, int tileSize = 32);
+    void DrawSpriteWorld(SpriteId sprite, const Vector2& worldPosition, const Vector2& cameraOffset);
+    
+    // Offscreen render targets (used to bake static content once)
+    bool SupportsRenderTargets() const;
+    // Opaque targets copy back without blending, transparent ones alpha-blend
+    SDL_Texture* CreateRenderTarget(int width, int height, bool transparent = false);
+    // ARGB8888 texture the CPU rewrites with SDL_UpdateTexture (e.g. the light map)
+    SDL_Texture* CreateStreamingTexture(int width, int height);
+    bool SetRenderTarget(SDL_Texture* target);
+    SDL_Texture* GetRenderTarget() const { return render_target_; }
+    
+    // Viewport culling - returns true (and counts it) when the world-space bounds are
+    // entirely outside the current viewport
+    bool CullTile(const Rect& worldBounds, const Vector2& cameraOffset);
+    bool CullObject(const Rect& worldBounds, const Vector2& cameraOffset);
+    
+    // Rect command buffer - DrawRect calls are deferred and flushed in batches
+    void FlushRects();
+    void SetDrawBlendMode(SDL_BlendMode blendMode) { blend_mode_ = blendMode; }
+    const RenderStats& GetFrameStats() const { return last_frame_stats_; }
+    
+    // Captures screen draws (not render-target draws) into a recording for later replay
+    void BeginRecording(DrawRecording* recording);
+    void EndRecording() { recording_ = nullptr; }
+    void Replay(const DrawRecording& recording);
+    
+    // Copy of the current frame as ARGB8888, caller frees. Flushes pending rects.
+    SDL_Surface* ReadFramebuffer();
+    // Same for the bound render target (null when none is bound)
+    SDL_Surface* ReadRenderTarget();
     
     int GetWindowWidth() const { return window_width_; }
     int GetWindowHeight() const { return window_height_; }
@@ -48,9 +166,87 @@ public:
     
 private:
     SDL_Renderer* renderer_;
+    SDL_Window* window_;
+    SDL_Surface* framebuffer_; // Owned software target in headless, dirty rect and indexed modes
+    bool vsync_;
     int window_width_;
     int window_height_;
     
-    std::unordered_map<std::string, SDL_Texture*> texture_cache_;
+    // Culling viewport: the current render target, or the clip rect on screen
+    SDL_Rect cull_rect_;
+    SDL_Rect clip_rect_;
+    bool clip_enabled_;
+    
+    bool IsOnScreen(int x, int y, int w, int h) const {
+        return x < cull_rect_.x + cull_rect_.w && y < cull_rect_.y + cull_rect_.h &&
+               x + w > cull_rect_.x && y + h > cull_rect_.y;
+    }
+    void ResetCullRect();
+    bool IsVisibleWorld(const Rect& worldBounds, const Vector2& cameraOffset) const;
+    
+    std::unique_ptr<AssetLoader> asset_loader_;
+    std::unique_ptr<TextureCache> texture_cache_;
+    SpriteAtlas sprite_atlas_;
+    std::unique_ptr<SpriteCache> sprite_cache_;
     std::unique_ptr<TextRenderer> text_renderer_;
+    
+    // Consecutive rects sharing a color and blend mode
+    struct RectBatch {
+        SDL_Color color;
+        SDL_BlendMode blendMode;
+        SDL_Rect bounds;
+        std::vector<SDL_Rect> rects;
+    };
+    
+    void QueueRect(const SDL_Rect& rect, SDL_Color color);
+    // Returns how many batches it drew; any after that are left for FillRects
+    size_t FlushRectsAsGeometry();
+    void FlushRectsToFramebuffer();
+    Raster::Target GetRasterTarget() const;
+    SDL_Rect ScaleToFramebuffer(const SDL_Rect& rect) const;
+    SDL_Surface* ReadPixels(int width, int height);
+    void ApplyDrawState(SDL_Color color, SDL_BlendMode blendMode);
+    void InvalidateDrawColor() { draw_color_valid_ = false; }
+    
+    std::vector<RectBatch> rect_batches_; // Pooled, only the first batch_count_ are live
+    size_t batch_count_;
+    std::vector<SDL_Vertex> geometry_vertices_;
+    std::vector<int> geometry_indices_;
+    bool use_geometry_;
+    
+    SDL_BlendMode blend_mode_;
+    SDL_Color current_color_;
+    SDL_BlendMode current_blend_mode_;
+    bool draw_color_valid_;
+    
+    SDL_Texture* render_target_;
+    DrawRecording* recording_;
+    bool IsRecording() const { return recording_ && !render_target_; }
+    
+    // Indexed mode: framebuffer_ is native resolution, quantized on Present and
+    // shown through a streaming texture on a window renderer
+    std::unique_ptr<IndexedFramebuffer> indexed_framebuffer_;
+    SDL_Renderer* window_renderer_;
+    SDL_Texture* screen_texture_;
+    int pixel_scale_;
+    SDL_Rect GetIndexedDestRect() const;
+    void PresentIndexed();
+    
+    // Dirty rect tracking
+    bool dirty_tracking_;
+    bool present_to_window_; // Framebuffer is copied to the window surface on Present
+    bool full_redraw_;
+    std::vector<SDL_Rect> dirty_rects_;   // Marked this frame
+    std::vector<SDL_Rect> dirty_regions_; // Merged, what is redrawn and presented
+    
+    RenderStats frame_stats_;
+    RenderStats last_frame_stats_;
+    
+    // How many batches back a rect may travel to join one with the same state
+    static const int MAX_BATCH_LOOKBACK = 8;
+    static const int MAX_LOADER_THREADS = 4;
+    // Past this many separate regions, or this share of the screen, redraw it all
+    static const int MAX_DIRTY_REGIONS = 8;
+    static const int FULL_REDRAW_PERCENT = 50;
+    static const size_t DEFAULT_TEXTURE_BUDGET = 64 * 1024 * 1024;
 };
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+#include "TextureCache.h"
+#include <SDL.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Index of a sprite in the loaded atlas, resolve once by name and keep it
+using SpriteId = int;
+const SpriteId INVALID_SPRITE = -1;
+
+// Runtime side of the asset cooker: atlas pages plus named sub-rects
+class SpriteAtlas {
+public:
+    struct Sprite {
+        int page;
+        SDL_Rect rect;
+    };
+
+    SpriteAtlas();
+    ~SpriteAtlas();
+
+    // Reads the cooked index (sprites.atlas) and acquires its pages, which live
+    // in the same directory, from the texture cache
+    bool Load(TextureCache* cache, const std::string& indexPath);
+    void Unload();
+
+    SpriteId GetSpriteId(const std::string& name) const;
+    const Sprite* GetSprite(SpriteId id) const;
+    TextureHandle GetPage(int page) const;
+
+    size_t GetSpriteCount() const { return sprites_.size(); }
+    size_t GetPageCount() const { return pages_.size(); }
+
+private:
+    TextureCache* cache_;
+    std::vector<TextureHandle> pages_; // Referenced until Unload
+    std::vector<Sprite> sprites_;
+    std::unordered_map<std::string, SpriteId> ids_;
+};
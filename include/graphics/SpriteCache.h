@@ -0,0 +1,78 @@
+#pragma once
+#include "Renderer.h"
+
+// Procedurally drawn entity types with a pre-rendered sheet
+enum class SpriteSheet {
+    PLAYER,
+    NPC,
+    DOG,
+    FLOWERS_FARM,
+    FLOWERS_GARDEN,
+    COUNT
+};
+
+// How to rasterize a sheet: one cell per (animation frame, facing) pair,
+// frames along x and facings along y
+struct SpriteSheetDesc {
+    // Draws one cell with the entity's position at (x, y)
+    using PaintFunction = void (*)(Renderer* renderer, int x, int y, int frame, int facing);
+    
+    int cellWidth = 0;
+    int cellHeight = 0;
+    int originX = 0; // Entity position inside the cell (shadows and tails stick out
+    int originY = 0; // above/left of it)
+    int frames = 1;
+    int facings = 1;
+    PaintFunction paint = nullptr;
+};
+
+// One entity's sprite as the simulation last saw it; all the renderer needs to draw it
+struct SpriteInstance {
+    SpriteSheet sheet = SpriteSheet::PLAYER;
+    int frame = 0;
+    int facing = 0;
+    Vector2 position;         // Entity position, world space
+    Vector2 previousPosition; // Position one simulation step earlier, drawing interpolates between them
+    Rect bounds;              // World-space render bounds at position
+    float sortY = 0;          // Depth among entities, usually the bottom edge
+    
+    SpriteInstance() = default;
+    SpriteInstance(SpriteSheet sheet, int frame, int facing, const Vector2& position, const Rect& bounds)
+        : sheet(sheet), frame(frame), facing(facing), position(position), previousPosition(position),
+          bounds(bounds), sortY(static_cast<float>(bounds.y + bounds.h)) {}
+};
+
+// Rasterizes each sheet once into a transparent texture the first time it is
+// drawn, after that every entity is a single blit. Falls back to painting
+// directly when render targets are unavailable.
+class SpriteCache {
+public:
+    SpriteCache();
+    ~SpriteCache();
+    
+    void Define(SpriteSheet sheet, const SpriteSheetDesc& desc);
+    
+    // Draws a cell with the entity's position at screenX/screenY
+    void Draw(Renderer* renderer, SpriteSheet sheet, int frame, int facing, int screenX, int screenY);
+    
+    // Every pixel Draw can touch for an entity at x/y: its cell
+    Rect GetCellBounds(SpriteSheet sheet, int x, int y) const;
+    
+    // Drops the baked textures, they are re-baked on next use (device resets lose them)
+    void Invalidate();
+    
+    int GetBakedSheetCount() const;
+    
+private:
+    struct Entry {
+        SpriteSheetDesc desc;
+        bool defined = false;
+        bool bakeFailed = false;
+        SDL_Texture* texture = nullptr;
+        SDL_Surface* pixels = nullptr; // Copy of the texture for the CPU blitter (software renderers only)
+    };
+    
+    bool Bake(Renderer* renderer, Entry& entry);
+    
+    Entry sheets_[static_cast<int>(SpriteSheet::COUNT)];
+};
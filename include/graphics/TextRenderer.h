@@ -4,15 +4,25 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <unordered_map>
 #include "Renderer.h"
 
+// Line layout cache counters, cumulative since startup
+struct TextLayoutStats {
+    int hits = 0;
+    int misses = 0;
+    int cachedLayouts = 0;
+};
+
 class TextRenderer {
 public:
     TextRenderer();
     ~TextRenderer();
     
-    bool Initialize(SDL_Renderer* renderer);
+    // Queues the system font on the loader; text is skipped until it arrives
+    bool Initialize(SDL_Renderer* renderer, AssetLoader* loader);
     void Shutdown();
+    bool HasFonts() const { return defaultFont16_ != nullptr; }
     
     // Basic text rendering
     void RenderText(const std::string& text, int x, int y, SDL_Color color, int fontSize = 16);
@@ -34,11 +44,75 @@ public:
     TTF_Font* LoadFont(const std::string& fontPath, int fontSize);
     TTF_Font* GetDefaultFont(int fontSize);
     
+    // Drops all glyph atlases (textures are lost on SDL_RENDER_DEVICE_RESET)
+    // along with the layouts that point into them
+    void ClearGlyphAtlases();
+    
+    const TextLayoutStats& GetLayoutStats() const { return layoutStats_; }
+    
 private:
+    // A glyph rasterized once into its font's atlas
+    struct Glyph {
+        SDL_Rect atlasRect; // Empty for glyphs without pixels (e.g. space)
+        int offsetX;        // Left edge of the rasterized cell relative to the pen
+        int advance;
+    };
+    
+    // One packed texture per font (and therefore per font size)
+    struct GlyphAtlas {
+        SDL_Texture* texture = nullptr;
+        int shelfX = 0;
+        int shelfY = 0;
+        int shelfHeight = 0;
+        bool full = false;
+        std::unordered_map<Uint32, Glyph> glyphs;
+    };
+    
+    // A glyph placed by a cached layout, x is relative to the layout origin
+    struct LayoutGlyph {
+        const Glyph* glyph;
+        int x;
+        int line;
+    };
+    
+    // Line breaks and glyph positions for one (text, font size, max width)
+    struct TextLayout {
+        int fontSize;
+        int maxWidth;                   // <= 0 means a single unwrapped line
+        std::vector<std::string> lines;
+        GlyphAtlas* atlas = nullptr;    // Null when some glyph is not in the atlas
+        std::vector<LayoutGlyph> glyphs;
+    };
+    
+    GlyphAtlas* GetAtlas(TTF_Font* font);
+    const Glyph* GetGlyph(GlyphAtlas* atlas, TTF_Font* font, Uint32 codepoint);
+    bool RenderTextWithAtlas(const std::string& text, int x, int y, SDL_Color color, TTF_Font* font);
+    void AppendGlyphQuad(const Glyph& glyph, int penX, int y, SDL_Color color);
+    bool FlushGlyphQuads(GlyphAtlas* atlas);
+    int MeasureText(const std::string& text, TTF_Font* font);
+    
+    const TextLayout* GetLayout(const std::string& text, int fontSize, int maxWidth);
+    void BuildLayout(TextLayout* layout, const std::string& text, TTF_Font* font);
+    void RenderLayout(const TextLayout& layout, int x, int y, SDL_Color color, int lineHeight);
+    
+    std::unordered_map<TTF_Font*, GlyphAtlas> atlases_;
+    // Keyed on the text so lookups never allocate; few sizes/widths per string
+    std::unordered_map<std::string, std::vector<TextLayout>> layouts_;
+    TextLayoutStats layoutStats_;
+    std::vector<SDL_Vertex> glyphVertices_;
+    std::vector<int> glyphIndices_;
+    
+    static const int ATLAS_SIZE = 1024;
+    static const int GLYPH_PADDING = 1;
+    static const int MAX_CACHED_LAYOUTS = 256;
+    
     SDL_Renderer* renderer_;
     TTF_Font* defaultFont16_;
     TTF_Font* defaultFont20_;
     TTF_Font* defaultFont24_;
     
+    void OpenDefaultFonts(std::vector<char>&& data);
+    std::vector<char> fontData_; // Fonts opened from memory read from it for their lifetime
+    
     SDL_Texture* CreateTextTexture(const std::string& text, SDL_Color color, TTF_Font* font, int* width, int* height);
 };
\ No newline at end of file
@@ -0,0 +1,84 @@
+#pragma once
+#include <SDL.h>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class AssetLoader;
+
+// Handle to a texture that may still be loading; resolve it every time it is drawn
+using TextureHandle = int;
+const TextureHandle INVALID_TEXTURE_HANDLE = -1;
+
+// Texture memory counters; hits and misses are cumulative since startup
+struct TextureCacheStats {
+    size_t residentBytes = 0;
+    size_t budgetBytes = 0;
+    int residentTextures = 0;
+    int loadingTextures = 0;
+    int hits = 0;      // Acquires served by a resident or already loading texture
+    int misses = 0;    // Acquires that had to load from disk
+    int evictions = 0;
+};
+
+// Loaded textures by path. Handles are reference counted: a texture stays
+// resident while anyone holds it, and once released it is kept around until
+// the resident bytes go over budget, least recently used first.
+class TextureCache {
+public:
+    TextureCache();
+    ~TextureCache();
+
+    // Textures are decoded on the loader, which must be shut down before the cache
+    void Initialize(SDL_Renderer* renderer, AssetLoader* loader, size_t budgetBytes);
+    void Shutdown();
+
+    // Adds a reference, starting a load if the texture is not resident; the
+    // same path always gets the same handle
+    TextureHandle Acquire(const std::string& path);
+    void Release(TextureHandle handle);
+
+    // Null while loading, after a failure, or once evicted
+    SDL_Texture* Get(TextureHandle handle);
+    bool IsLoading(TextureHandle handle) const;
+
+    // Referenced textures are never evicted, so the budget may be exceeded
+    void SetBudget(size_t budgetBytes);
+    TextureCacheStats GetStats() const;
+
+private:
+    enum class State { UNLOADED, LOADING, READY, FAILED };
+
+    struct Entry {
+        std::string path;
+        State state = State::UNLOADED;
+        SDL_Texture* texture = nullptr;
+        size_t bytes = 0;
+        int refs = 0;
+        bool inLru = false;
+        std::list<TextureHandle>::iterator lruPosition;
+    };
+
+    bool IsValid(TextureHandle handle) const {
+        return handle >= 0 && handle < static_cast<TextureHandle>(entries_.size());
+    }
+    void Load(TextureHandle handle);
+    void OnLoaded(TextureHandle handle, SDL_Surface* surface);
+    void Evict(TextureHandle handle);
+    void TrimToBudget();
+    void AddToLru(TextureHandle handle);
+    void RemoveFromLru(TextureHandle handle);
+
+    SDL_Renderer* renderer_;
+    AssetLoader* loader_;
+    std::vector<Entry> entries_; // Never shrinks, handles stay valid
+    std::unordered_map<std::string, TextureHandle> handles_;
+    std::list<TextureHandle> lru_; // Resident and unreferenced, most recently used first
+
+    size_t budgetBytes_;
+    size_t residentBytes_;
+    int hits_;
+    int misses_;
+    int evictions_;
+};
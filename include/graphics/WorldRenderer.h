@@ -1,34 +1,61 @@
 #pragma once
 #include "Renderer.h"
 #include <SDL.h>
+#include <unordered_map>
+
+class WorldSnapshot;
+struct Tile;
 
 class WorldRenderer {
 public:
     WorldRenderer();
     ~WorldRenderer();
-    
-    void RenderWorld(Renderer* renderer, Vector2 cameraOffset);
-    
+
+    // Chunks are baked into textures as they stream in (falls back to immediate
+    // drawing when the renderer has no render target support)
+    bool Initialize(Renderer* renderer);
+    void Shutdown();
+
+    // Drops the baked chunks so they are rebuilt on the next frame
+    // (e.g. after SDL_RENDER_TARGETS_RESET)
+    void Invalidate();
+
+    void RenderWorld(Renderer* renderer, const WorldSnapshot* world, Vector2 cameraOffset);
+
+    int GetChunkCount() const { return static_cast<int>(chunks_.size()); }
+    int GetChunksDrawnLastFrame() const { return chunksDrawnLastFrame_; }
+
 private:
-    void RenderSky(Renderer* renderer, Vector2 cameraOffset);
-    void RenderGround(Renderer* renderer, Vector2 cameraOffset);
-    void RenderWaterBorders(Renderer* renderer, Vector2 cameraOffset);
-    void RenderHouse(Renderer* renderer, Vector2 cameraOffset);
-    void RenderFarm(Renderer* renderer, Vector2 cameraOffset);
-    void RenderGarden(Renderer* renderer, Vector2 cameraOffset);
-    void RenderPaths(Renderer* renderer, Vector2 cameraOffset);
-    
+    struct BakedChunk {
+        Rect bounds;           // World-space area covered by this chunk
+        Uint32 loadSerial;     // World chunk load this texture was baked from
+        SDL_Texture* texture;
+    };
+
+    bool BakeChunk(Renderer* renderer, const WorldSnapshot* world, int chunkX, int chunkY, Uint32 loadSerial);
+    void EvictStaleChunks(const WorldSnapshot* world);
+    void DestroyChunks();
+    Rect ChunkBounds(const WorldSnapshot* world, int chunkX, int chunkY) const;
+    bool CanBake(const WorldSnapshot* world, int chunkX, int chunkY) const;
+    void DrawTileRange(Renderer* renderer, const WorldSnapshot* world, int firstX, int firstY, int lastX, int lastY, Vector2 cameraOffset);
+    bool CullTile(Renderer* renderer, int x, int y, Vector2 cameraOffset);
+
     // Helper methods for specific rendering tasks
-    void RenderHouseTile(Renderer* renderer, int x, int y, bool isRoof, Vector2 cameraOffset);
-    void RenderFarmTile(Renderer* renderer, int x, int y, Vector2 cameraOffset);
-    void RenderGardenTile(Renderer* renderer, int x, int y, Vector2 cameraOffset);
+    void RenderGroundTile(Renderer* renderer, int x, int y, const Tile& tile, Vector2 cameraOffset);
+    void RenderWaterTile(Renderer* renderer, int x, int y, const Tile& tile, Vector2 cameraOffset);
+    void RenderHouseTile(Renderer* renderer, int x, int y, const Tile& tile, Vector2 cameraOffset);
+    void RenderFarmTile(Renderer* renderer, int x, int y, const Tile& tile, Vector2 cameraOffset);
+    void RenderGardenTile(Renderer* renderer, int x, int y, const Tile& tile, Vector2 cameraOffset);
     void RenderDirtPath(Renderer* renderer, int x, int y, bool isHorizontal, Vector2 cameraOffset);
-    
-    // World constants
+
+    std::unordered_map<int, BakedChunk> chunks_; // Keyed on world chunk index
+    bool useChunks_;
+    int chunksDrawnLastFrame_;
+
     static const int TILE_SIZE = 128;
-    static const int WORLD_WIDTH_TILES = 10;
-    static const int WORLD_HEIGHT_TILES = 8;
-    
+    static const int TILE_DRAW_MARGIN = 16; // How far tile details may spill into neighbors
+    static const int MAX_PREFETCH_BAKES = 1; // Off-screen chunks baked per frame
+
     // Color palette
     struct GhibliColors {
         SDL_Color sky = {173, 216, 230, 255};
@@ -44,4 +71,4 @@ private:
         SDL_Color windowBlue = {100, 149, 237, 255};
         SDL_Color gardenFlower = {255, 182, 193, 255};
     } colors_;
-};
\ No newline at end of file
+};
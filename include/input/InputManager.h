@@ -25,10 +25,17 @@ public:
     bool IsActionHeld(InputAction action) const;
     bool IsActionReleased(InputAction action) const;
     
+    // Every held action as one bit per InputAction, for recording and replaying
+    // input a step at a time
+    Uint32 GetActionState() const { return current_state_; }
+    void SetActionState(Uint32 actions) { current_state_ = actions; }
+    
 private:
     std::unordered_map<SDL_Keycode, InputAction> key_bindings_;
-    std::unordered_map<InputAction, bool> current_state_;
-    std::unordered_map<InputAction, bool> previous_state_;
+    Uint32 current_state_;
+    Uint32 previous_state_;
     
     void InitializeKeyBindings();
+    void SetAction(InputAction action, bool held);
+    static Uint32 ActionBit(InputAction action) { return 1u << static_cast<int>(action); }
 };
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+#include <SDL.h>
+#include <string>
+#include <vector>
+
+// Held actions for every simulation step of a session (.yrep), written with
+// --record and played back with --replay. Together with the settings that shape
+// the simulation (step rate, start hour, random seed) that is everything a step
+// depends on, so a replay runs the exact same steps.
+//
+// Little-endian: the Header, then runCount Runs of steps with the same actions,
+// so long stretches of standing still or holding a key take 8 bytes.
+class InputRecording {
+public:
+    struct Header {
+        char magic[4];
+        Uint32 version;
+        Uint32 seed;
+        Uint32 simulationRate;
+        Uint32 startHour;
+        Uint32 stepCount;
+        Uint32 runCount;
+        Uint32 stateHash; // Game state after the last step, to check the replay against
+    };
+
+    struct Run {
+        Uint32 actions; // InputManager::GetActionState
+        Uint32 steps;
+    };
+
+    InputRecording();
+    ~InputRecording() = default;
+
+    // Recording
+    void Begin(Uint32 seed, int simulationRate, int startHour);
+    void Record(Uint32 actions);
+    bool Save(const std::string& path, Uint32 stateHash);
+
+    // Playback; Next gives the following step's actions, false after the last
+    bool Load(const std::string& path);
+    bool Next(Uint32& actions);
+
+    Uint32 GetSeed() const { return header_.seed; }
+    int GetSimulationRate() const { return static_cast<int>(header_.simulationRate); }
+    int GetStartHour() const { return static_cast<int>(header_.startHour); }
+    Uint32 GetStepCount() const { return header_.stepCount; }
+    Uint32 GetStateHash() const { return header_.stateHash; }
+
+private:
+    Header header_;
+    std::vector<Run> runs_;
+    size_t run_;         // Playback position
+    Uint32 stepInRun_;
+
+    static const Uint32 VERSION = 1;
+};
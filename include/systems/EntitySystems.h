@@ -0,0 +1,27 @@
+#pragma once
+#include "EntityStore.h"
+#include "CollisionWorld.h"
+#include "JobSystem.h"
+#include "SpriteCache.h"
+#include <vector>
+
+// Per-step entity behaviour, each a single pass over EntityStore's component arrays,
+// split across the job system's workers when one is given
+namespace EntitySystems {
+
+// Remembers where everything was for interpolation, then walks moving entities
+// along their patrol, turning at either end, at the player or at anything solid
+// in the collision world (when given). Every entity decides against where the
+// others stood at the start of the step and the moves are applied afterwards in
+// index order, so the outcome doesn't depend on how the work was split.
+void UpdateMovement(EntityStore& store, float deltaTime, const Vector2& playerPosition,
+                    const CollisionWorld* collisionWorld = nullptr, JobSystem* jobs = nullptr);
+
+void UpdateAnimation(EntityStore& store, float deltaTime, JobSystem* jobs = nullptr);
+
+// Appends the current sprite of every entity positioned inside area (world space),
+// in index order, for the render snapshot. Callers widen the view by the furthest a
+// sprite reaches past its entity position.
+void CollectSprites(const EntityStore& store, const Rect& area, std::vector<SpriteInstance>& sprites);
+
+} // namespace EntitySystems
@@ -2,6 +2,7 @@
 #include <vector>
 #include <memory>
 #include "Renderer.h"
+#include "JobSystem.h"
 
 enum class CropType {
     NONE,
@@ -33,7 +34,9 @@ class FarmingSystem {
 public:
     FarmingSystem(int width, int height);
     
-    void Update(float deltaTime);
+    // Rows of the farm grow independently; a farm big enough to be worth it is split
+    // across the job system's workers when given
+    void Update(float deltaTime, JobSystem* jobs = nullptr);
     void Render(Renderer* renderer);
     
     bool TillSoil(int x, int y);
@@ -43,6 +46,7 @@ public:
     
     bool IsValidPosition(int x, int y) const;
     FarmTile* GetTile(int x, int y);
+    const std::vector<std::vector<FarmTile>>& GetGrid() const { return farm_grid_; }
     
 private:
     std::vector<std::vector<FarmTile>> farm_grid_;
@@ -50,6 +54,8 @@ private:
     int grid_height_;
     int tile_size_;
     
-    void UpdateCropGrowth(float deltaTime);
+    void UpdateCropGrowth(float deltaTime, int first_row, int last_row);
     int GetGrowthTimeForCrop(CropType cropType) const;
+    
+    static const int TILES_PER_JOB = 4096; // Smaller farms grow inline, a job costs more than they do
 };
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+#include <vector>
+#include "LightMap.h"
+
+// Game clock and the lights placed in the world. Only keeps the state; the
+// renderer's LightMap turns it into light levels.
+class LightingSystem {
+public:
+    explicit LightingSystem(int startHour = 8);
+
+    void Update(float deltaTime);
+
+    Uint32 AddLight(int x, int y, int radius, SDL_Color color);
+    void RemoveLight(Uint32 id);
+
+    float GetHour() const { return hour_; } // 0 to 24
+    int GetSunStep() const;
+
+    // Lights in ascending id; the version changes whenever they do
+    const std::vector<PointLight>& GetLights() const { return lights_; }
+    Uint32 GetVersion() const { return version_; }
+
+private:
+    std::vector<PointLight> lights_;
+    Uint32 next_light_id_;
+    Uint32 version_;
+    float hour_;
+
+    static constexpr float DAY_LENGTH_SECONDS = 480.0f; // One in-game day
+};
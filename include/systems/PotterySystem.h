@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include <string>
+#include <random>
 #include "Renderer.h"
 
 enum class ClayType {
@@ -38,13 +39,16 @@ struct PotteryItem {
 
 class PotterySystem {
 public:
-    PotterySystem();
+    // Quality rolls come from seed, so a replayed session crafts the same items
+    explicit PotterySystem(unsigned int seed = 0);
     
     void Update(float deltaTime);
     void Render(Renderer* renderer);
     
     bool StartCrafting(const PotteryRecipe& recipe);
     bool IsCrafting() const { return is_crafting_; }
+    float GetCraftingProgress() const { return crafting_progress_; } // ms
+    const std::mt19937& GetRandom() const { return random_; }
     PotteryItem* GetCompletedItem();
     
     void AddClay(ClayType clayType, int amount);
@@ -66,7 +70,8 @@ private:
     bool is_crafting_;
     PotteryRecipe* current_recipe_;
     float crafting_progress_;
+    std::mt19937 random_;
     
     void InitializeRecipes();
-    int CalculateQuality() const; // Random quality calculation
+    int CalculateQuality(); // Random quality calculation
 };
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <SDL.h>
 #include "Renderer.h"
 #include "Interactable.h"
+#include "EntityStore.h"
 
 struct InteractionZone {
     Rect bounds;
@@ -15,6 +16,14 @@ struct InteractionZone {
         : bounds(b), type(t), dialogues(d), currentDialogue(0) {}
 };
 
+// Everything Render() draws, copied into render snapshots
+struct DialogueView {
+    bool active = false;
+    bool showPrompt = false;
+    std::string text;
+    Uint32 version = 0; // DialogueSystem::GetRenderVersion() it was taken at
+};
+
 class DialogueSystem {
 public:
     DialogueSystem();
@@ -22,23 +31,28 @@ public:
     
     void Initialize();
     void Update(float deltaTime);
-    void Render(Renderer* renderer, int windowWidth, int windowHeight);
+    static void Render(Renderer* renderer, const DialogueView& view, int windowWidth, int windowHeight);
+    // Screen area Render covers for the view (empty when it draws nothing)
+    static Rect GetScreenBounds(const DialogueView& view, int windowWidth, int windowHeight);
     
     bool CheckInteraction(const Vector2& playerPosition, const Vector2& cameraOffset);
     InteractableType CheckNearbyInteraction(const Vector2& playerPosition) const;
     void ShowDialogue(InteractableType type);
-    void ShowDialogue(Interactable* specificInteractable);
-    void ShowDialogue(class InteractableObject* specificObject);
+    void ShowDialogue(EntityId entity);
     void HideDialogue();
     void NextDialogue();
     bool IsDialogueActive() const { return isActive_; }
     bool IsNearInteractable() const { return nearInteractable_; }
     void SetNearInteractable(bool near, InteractableType type = InteractableType::NONE);
     
-    void SetupInteractionZones();
-    void RegisterDynamicInteractable(Interactable* interactable);
-    InteractableType CheckNearbyDynamicInteraction(const Vector2& playerPosition);
-    Interactable* GetNearbyInteractable(const Vector2& playerPosition) const;
+    // Changes whenever what Render() draws changes
+    Uint32 GetRenderVersion() const { return renderVersion_; }
+    DialogueView GetView() const;
+    
+    // Static zones, loaded from the world file
+    void AddInteractionZone(const InteractionZone& zone);
+    // NPCs, dogs and flower patches, checked before the zones
+    void SetEntityStore(EntityStore* entityStore) { entityStore_ = entityStore; }
     
 private:
     bool isActive_;
@@ -46,14 +60,17 @@ private:
     std::string currentText_;
     InteractableType currentType_;
     InteractableType nearbyType_;
-    Interactable* currentInteractable_;
+    EntityId currentEntity_;
     float displayTimer_;
     float fadeAlpha_;
+    Uint32 renderVersion_;
     
     std::vector<InteractionZone> interactionZones_;
-    std::vector<Interactable*> dynamicInteractables_;
+    EntityStore* entityStore_;
     
-    void RenderDialogueBox(Renderer* renderer, int windowWidth, int windowHeight);
-    void RenderInteractionPrompt(Renderer* renderer, int windowWidth, int windowHeight);
+    static Rect GetDialogueBoxBounds(int windowWidth, int windowHeight);
+    static Rect GetPromptBounds(int windowWidth);
+    static void RenderDialogueBox(Renderer* renderer, const std::string& text, int windowWidth, int windowHeight);
+    static void RenderInteractionPrompt(Renderer* renderer, int windowWidth, int windowHeight);
     std::vector<std::string> GetDialogueForType(InteractableType type);
 };
\ No newline at end of file
@@ -0,0 +1,137 @@
+#include "CollisionWorld.h"
+#include <algorithm>
+
+CollisionWorld::CollisionWorld() : widthTiles_(0), heightTiles_(0), widthChunks_(0), entityStore_(nullptr) {
+}
+
+void CollisionWorld::Initialize(int widthTiles, int heightTiles) {
+    widthTiles_ = widthTiles;
+    heightTiles_ = heightTiles;
+    widthChunks_ = (widthTiles + WorldChunkData::TILES - 1) / WorldChunkData::TILES;
+    int heightChunks = (heightTiles + WorldChunkData::TILES - 1) / WorldChunkData::TILES;
+
+    // Nothing is resident yet, so everything is a wall
+    tiles_.assign(static_cast<size_t>(widthTiles) * heightTiles, TileMask());
+    colliders_.assign(static_cast<size_t>(widthChunks_) * heightChunks, std::vector<Rect>());
+}
+
+void CollisionWorld::OnChunkLoaded(const WorldChunkData& chunk) {
+    const int TILES = WorldChunkData::TILES;
+    for (int y = 0; y < TILES; ++y) {
+        for (int x = 0; x < TILES; ++x) {
+            int tileX = chunk.chunkX * TILES + x;
+            int tileY = chunk.chunkY * TILES + y;
+            if (tileX >= widthTiles_ || tileY >= heightTiles_) continue;
+
+            TileMask& mask = At(tileX, tileY);
+            mask.solid = chunk.At(x, y).IsSolid() ? ~0ull : 0;
+            mask.partial = 0;
+        }
+    }
+
+    colliders_[chunk.chunkY * widthChunks_ + chunk.chunkX] = chunk.colliders;
+    for (const Rect& collider : chunk.colliders) {
+        RasterizeCollider(chunk, collider);
+    }
+}
+
+void CollisionWorld::OnChunkUnloaded(const WorldChunkData& chunk) {
+    const int TILES = WorldChunkData::TILES;
+    for (int y = 0; y < TILES; ++y) {
+        for (int x = 0; x < TILES; ++x) {
+            int tileX = chunk.chunkX * TILES + x;
+            int tileY = chunk.chunkY * TILES + y;
+            if (tileX >= widthTiles_ || tileY >= heightTiles_) continue;
+            At(tileX, tileY) = TileMask();
+        }
+    }
+    colliders_[chunk.chunkY * widthChunks_ + chunk.chunkX].clear();
+}
+
+void CollisionWorld::RasterizeCollider(const WorldChunkData& chunk, const Rect& collider) {
+    // Clipped to its own chunk, the exact test only looks at the chunk's colliders
+    const int TILE_SIZE = WorldChunkData::TILE_SIZE;
+    int chunkLeft = chunk.chunkX * WorldChunkData::CHUNK_SIZE;
+    int chunkTop = chunk.chunkY * WorldChunkData::CHUNK_SIZE;
+    int left = std::max(collider.x, chunkLeft);
+    int top = std::max(collider.y, chunkTop);
+    int right = std::min(collider.x + collider.w, chunkLeft + WorldChunkData::CHUNK_SIZE);
+    int bottom = std::min(collider.y + collider.h, chunkTop + WorldChunkData::CHUNK_SIZE);
+    right = std::min(right, widthTiles_ * TILE_SIZE);
+    bottom = std::min(bottom, heightTiles_ * TILE_SIZE);
+    if (left >= right || top >= bottom) return;
+
+    for (int cellY = top / CELL_SIZE; cellY <= (bottom - 1) / CELL_SIZE; ++cellY) {
+        for (int cellX = left / CELL_SIZE; cellX <= (right - 1) / CELL_SIZE; ++cellX) {
+            int cellLeft = cellX * CELL_SIZE;
+            int cellTop = cellY * CELL_SIZE;
+            bool covered = left <= cellLeft && right >= cellLeft + CELL_SIZE &&
+                           top <= cellTop && bottom >= cellTop + CELL_SIZE;
+
+            TileMask& mask = At(cellX / CELLS, cellY / CELLS);
+            Uint64 bit = 1ull << ((cellY % CELLS) * CELLS + cellX % CELLS);
+            if (covered) {
+                mask.solid |= bit;
+            } else {
+                mask.partial |= bit;
+            }
+        }
+    }
+}
+
+Uint64 CollisionWorld::CellMask(int firstX, int firstY, int lastX, int lastY) {
+    Uint64 row = ((1ull << (lastX - firstX + 1)) - 1) << firstX;
+    Uint64 mask = 0;
+    for (int y = firstY; y <= lastY; ++y) {
+        mask |= row << (y * CELLS);
+    }
+    return mask;
+}
+
+bool CollisionWorld::IsBlockedStatic(const Rect& bounds) const {
+    // Leaving the map is never allowed
+    const int TILE_SIZE = WorldChunkData::TILE_SIZE;
+    if (bounds.x < 0 || bounds.y < 0 ||
+        bounds.x + bounds.w > widthTiles_ * TILE_SIZE || bounds.y + bounds.h > heightTiles_ * TILE_SIZE) {
+        return true;
+    }
+    if (bounds.w <= 0 || bounds.h <= 0) return false;
+
+    int right = bounds.x + bounds.w - 1; // Inclusive
+    int bottom = bounds.y + bounds.h - 1;
+    bool partial = false;
+    for (int tileY = bounds.y / TILE_SIZE; tileY <= bottom / TILE_SIZE; ++tileY) {
+        for (int tileX = bounds.x / TILE_SIZE; tileX <= right / TILE_SIZE; ++tileX) {
+            int tileLeft = tileX * TILE_SIZE;
+            int tileTop = tileY * TILE_SIZE;
+            Uint64 cells = CellMask((std::max(bounds.x, tileLeft) - tileLeft) / CELL_SIZE,
+                                    (std::max(bounds.y, tileTop) - tileTop) / CELL_SIZE,
+                                    (std::min(right, tileLeft + TILE_SIZE - 1) - tileLeft) / CELL_SIZE,
+                                    (std::min(bottom, tileTop + TILE_SIZE - 1) - tileTop) / CELL_SIZE);
+
+            const TileMask& mask = At(tileX, tileY);
+            if (mask.solid & cells) return true;
+            if (mask.partial & cells) partial = true;
+        }
+    }
+    if (!partial) return false;
+
+    // Only part of a cell is covered, test the colliders themselves
+    const int CHUNK_SIZE = WorldChunkData::CHUNK_SIZE;
+    for (int chunkY = bounds.y / CHUNK_SIZE; chunkY <= bottom / CHUNK_SIZE; ++chunkY) {
+        for (int chunkX = bounds.x / CHUNK_SIZE; chunkX <= right / CHUNK_SIZE; ++chunkX) {
+            for (const Rect& collider : colliders_[chunkY * widthChunks_ + chunkX]) {
+                if (bounds.x < collider.x + collider.w && bounds.x + bounds.w > collider.x &&
+                    bounds.y < collider.y + collider.h && bounds.y + bounds.h > collider.y) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+bool CollisionWorld::IsBlocked(const Rect& bounds, EntityId ignore) const {
+    if (IsBlockedStatic(bounds)) return true;
+    return entityStore_ && entityStore_->CheckCollision(bounds, ignore);
+}
@@ -0,0 +1,252 @@
+#include "EntityStore.h"
+#include <algorithm>
+#include <iostream>
+
+EntityStore::EntityStore() : maxInteractionRadius_(0.0f), maxCollisionWidth_(0), maxCollisionHeight_(0) {
+}
+
+void EntityStore::DefineStyle(SpriteSheet sheet, const RenderStyle& style) {
+    styles_[static_cast<int>(sheet)] = style;
+    maxCollisionWidth_ = std::max(maxCollisionWidth_, style.collisionWidth);
+    maxCollisionHeight_ = std::max(maxCollisionHeight_, style.collisionHeight);
+}
+
+void EntityStore::DefineArchetype(Archetype archetype, const ArchetypeInfo& info) {
+    archetypes_[static_cast<int>(archetype)] = info;
+}
+
+EntityId EntityStore::Create(const EntityDesc& desc, const std::vector<std::string>& dialogue) {
+    Uint32 slot;
+    if (!freeSlots_.empty()) {
+        slot = freeSlots_.back();
+        freeSlots_.pop_back();
+    } else {
+        if (slotIndex_.size() >= SLOT_MASK) {
+            std::cerr << "Entity store is full, can't create more than " << SLOT_MASK << " entities" << std::endl;
+            return INVALID_ENTITY;
+        }
+        slot = static_cast<Uint32>(slotIndex_.size());
+        slotIndex_.push_back(0);
+        slotGeneration_.push_back(0);
+    }
+
+    EntityId entity = (slotGeneration_[slot] << SLOT_BITS) | slot;
+    Uint32 index = static_cast<Uint32>(components_.Size());
+    slotIndex_[slot] = index;
+    
+    Uint32 cell = SpatialHash::BucketOf(desc.x, desc.y);
+    spatialHash_.Insert(cell, index);
+    maxInteractionRadius_ = std::max(maxInteractionRadius_, desc.interactionRadius);
+
+    components_.positionX.push_back(desc.x);
+    components_.positionY.push_back(desc.y);
+    components_.previousX.push_back(desc.x);
+    components_.previousY.push_back(desc.y);
+    components_.velocityX.push_back(desc.velocityX);
+    components_.targetX.push_back(desc.x);
+    components_.patrolMinX.push_back(desc.patrolMinX);
+    components_.patrolMaxX.push_back(desc.patrolMaxX);
+    components_.animationTime.push_back(0.0f);
+    components_.interactionRadius.push_back(desc.interactionRadius);
+    components_.dialogue.push_back(AddDialogue(dialogue));
+    components_.dialogueLine.push_back(0);
+    components_.renderStyle.push_back(desc.sheet);
+    components_.archetype.push_back(desc.archetype);
+    components_.flags.push_back(GetArchetype(desc.archetype).flags | desc.flags);
+    components_.cell.push_back(cell);
+    components_.id.push_back(entity);
+    return entity;
+}
+
+void EntityStore::Destroy(EntityId entity) {
+    if (!IsAlive(entity)) return;
+
+    size_t index = IndexOf(entity);
+    Uint32 slot = entity & SLOT_MASK;
+
+    dialogues_[components_.dialogue[index]].clear();
+    freeDialogues_.push_back(components_.dialogue[index]);
+
+    // Move the last entity into the hole
+    EntityId moved = components_.id.back();
+    Uint32 last = static_cast<Uint32>(components_.Size() - 1);
+    spatialHash_.Remove(components_.cell[index], static_cast<Uint32>(index));
+    if (moved != entity) {
+        spatialHash_.Renumber(components_.cell[last], last, static_cast<Uint32>(index));
+    }
+    components_.ForEachColumn([index](auto& column) {
+        column[index] = column.back();
+        column.pop_back();
+    });
+    if (moved != entity) {
+        slotIndex_[moved & SLOT_MASK] = static_cast<Uint32>(index);
+    }
+
+    // Old handles to this slot stop resolving
+    slotGeneration_[slot] = (slotGeneration_[slot] + 1) & (0xFFFFFFFFu >> SLOT_BITS);
+    freeSlots_.push_back(slot);
+}
+
+void EntityStore::Clear() {
+    components_.ForEachColumn([](auto& column) { column.clear(); });
+    spatialHash_.Clear();
+    for (Uint32& generation : slotGeneration_) {
+        generation = (generation + 1) & (0xFFFFFFFFu >> SLOT_BITS);
+    }
+    freeSlots_.clear();
+    for (Uint32 slot = static_cast<Uint32>(slotIndex_.size()); slot > 0; --slot) {
+        freeSlots_.push_back(slot - 1);
+    }
+    dialogues_.clear();
+    freeDialogues_.clear();
+}
+
+bool EntityStore::IsAlive(EntityId entity) const {
+    if (entity == INVALID_ENTITY) return false;
+    Uint32 slot = entity & SLOT_MASK;
+    if (slot >= slotIndex_.size() || (entity >> SLOT_BITS) != slotGeneration_[slot]) return false;
+    size_t index = slotIndex_[slot];
+    return index < components_.Size() && components_.id[index] == entity;
+}
+
+void EntityStore::Relocate(size_t index) {
+    Uint32 cell = SpatialHash::BucketOf(components_.positionX[index], components_.positionY[index]);
+    if (cell == components_.cell[index]) return;
+    
+    spatialHash_.Remove(components_.cell[index], static_cast<Uint32>(index));
+    spatialHash_.Insert(cell, static_cast<Uint32>(index));
+    components_.cell[index] = cell;
+}
+
+EntityId EntityStore::FindInteractable(const Vector2& position) const {
+    // Higher priority wins over anything closer, then the closest wins (lowest index on ties)
+    size_t best = components_.Size();
+    int bestPriority = 0;
+    float bestDistance = 0.0f;
+    
+    float reach = maxInteractionRadius_;
+    spatialHash_.ForEachInArea(position.x - reach, position.y - reach, position.x + reach, position.y + reach,
+                               components_.positionX, components_.positionY, [&](Uint32 i) {
+        float dx = position.x - components_.positionX[i];
+        float dy = position.y - components_.positionY[i];
+        float distance = dx * dx + dy * dy;
+        float radius = components_.interactionRadius[i];
+        if (distance > radius * radius) return true;
+        
+        int priority = GetArchetype(components_.archetype[i]).interactionPriority;
+        if (best == components_.Size() || priority > bestPriority ||
+            (priority == bestPriority && (distance < bestDistance || (distance == bestDistance && i < best)))) {
+            best = i;
+            bestPriority = priority;
+            bestDistance = distance;
+        }
+        return true;
+    });
+    return best < components_.Size() ? components_.id[best] : INVALID_ENTITY;
+}
+
+EntityId EntityStore::FindNearest(const Vector2& position, float maxDistance) const {
+    size_t best = components_.Size();
+    float bestDistance = maxDistance * maxDistance;
+    
+    spatialHash_.ForEachInArea(position.x - maxDistance, position.y - maxDistance,
+                               position.x + maxDistance, position.y + maxDistance,
+                               components_.positionX, components_.positionY, [&](Uint32 i) {
+        float dx = position.x - components_.positionX[i];
+        float dy = position.y - components_.positionY[i];
+        float distance = dx * dx + dy * dy;
+        if (distance < bestDistance || (distance == bestDistance && i < best)) {
+            best = i;
+            bestDistance = distance;
+        }
+        return true;
+    });
+    return best < components_.Size() ? components_.id[best] : INVALID_ENTITY;
+}
+
+void EntityStore::FindInRange(const Vector2& position, float range, std::vector<EntityId>& entities) const {
+    spatialHash_.ForEachInArea(position.x - range, position.y - range, position.x + range, position.y + range,
+                               components_.positionX, components_.positionY, [&](Uint32 i) {
+        float dx = position.x - components_.positionX[i];
+        float dy = position.y - components_.positionY[i];
+        if (dx * dx + dy * dy <= range * range) {
+            entities.push_back(components_.id[i]);
+        }
+        return true;
+    });
+}
+
+void EntityStore::FindIndicesInArea(const Rect& area, std::vector<Uint32>& indices) const {
+    size_t first = indices.size();
+    float left = static_cast<float>(area.x);
+    float top = static_cast<float>(area.y);
+    float right = static_cast<float>(area.x + area.w);
+    float bottom = static_cast<float>(area.y + area.h);
+    spatialHash_.ForEachInArea(left, top, right, bottom, components_.positionX, components_.positionY, [&](Uint32 i) {
+        float x = components_.positionX[i];
+        float y = components_.positionY[i];
+        if (x >= left && x < right && y >= top && y < bottom) {
+            indices.push_back(i);
+        }
+        return true;
+    });
+    // Buckets hand them out in no particular order
+    std::sort(indices.begin() + first, indices.end());
+}
+
+bool EntityStore::CheckCollision(const Rect& box, EntityId ignore) const {
+    // Entities up to a collision box left of or above box can still reach into it (plus
+    // a pixel for positions being truncated)
+    bool hit = false;
+    spatialHash_.ForEachInArea(static_cast<float>(box.x - maxCollisionWidth_ - 1),
+                               static_cast<float>(box.y - maxCollisionHeight_ - 1),
+                               static_cast<float>(box.x + box.w + 1), static_cast<float>(box.y + box.h + 1),
+                               components_.positionX, components_.positionY, [&](Uint32 i) {
+        if (components_.id[i] == ignore) return true;
+        const RenderStyle& style = GetStyle(components_.renderStyle[i]);
+        int x = static_cast<int>(components_.positionX[i]);
+        int y = static_cast<int>(components_.positionY[i]);
+        if (box.x < x + style.collisionWidth && box.x + box.w > x &&
+            box.y < y + style.collisionHeight && box.y + box.h > y) {
+            hit = true;
+        }
+        return !hit;
+    });
+    return hit;
+}
+
+InteractableType EntityStore::GetInteractionType(EntityId entity) const {
+    if (!IsAlive(entity)) return InteractableType::NONE;
+    return GetArchetype(components_.archetype[IndexOf(entity)]).interaction;
+}
+
+std::string EntityStore::GetDialogueLine(EntityId entity) const {
+    if (!IsAlive(entity)) return "";
+    size_t index = IndexOf(entity);
+    const std::vector<std::string>& lines = dialogues_[components_.dialogue[index]];
+    if (lines.empty()) return "";
+    return lines[components_.dialogueLine[index]];
+}
+
+bool EntityStore::AdvanceDialogue(EntityId entity) {
+    if (!IsAlive(entity)) return false;
+    size_t index = IndexOf(entity);
+    if (!(components_.flags[index] & ENTITY_CYCLES_DIALOGUE)) return false;
+
+    const std::vector<std::string>& lines = dialogues_[components_.dialogue[index]];
+    if (!lines.empty()) {
+        components_.dialogueLine[index] = static_cast<Uint16>((components_.dialogueLine[index] + 1) % lines.size());
+    }
+    return true;
+}
+
+Uint32 EntityStore::AddDialogue(const std::vector<std::string>& dialogue) {
+    if (!freeDialogues_.empty()) {
+        Uint32 slot = freeDialogues_.back();
+        freeDialogues_.pop_back();
+        dialogues_[slot] = dialogue;
+        return slot;
+    }
+    dialogues_.push_back(dialogue);
+    return static_cast<Uint32>(dialogues_.size() - 1);
+}
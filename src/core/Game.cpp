@@ -1,23 +1,54 @@
 #include "Game.h"
 #include "GameInit.h"
-#include "NPCManager.h"
-#include "DynamicObjectManager.h"
+#include "EntityStore.h"
+#include "CollisionWorld.h"
+#include "JobSystem.h"
 #include "Renderer.h"
+#include "SpriteCache.h"
+#include "WorldRenderer.h"
+#include "LightMap.h"
+#include "World.h"
+#include "WorldEntitySpawner.h"
+#include "TextRenderer.h"
 #include "InputManager.h"
 #include "FarmingSystem.h"
 #include "PotterySystem.h"
+#include "LightingSystem.h"
 #include "Player.h"
-#include "NPC.h"
+#include "EntitySystems.h"
 #include "Camera.h"
 #include "DialogueSystem.h"
+#include "FrameCapture.h"
+#include "InputRecording.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <chrono>
+#include <random>
+#include <sstream>
+#include <thread>
 #include <type_traits>
 
 Game* Game::instance_ = nullptr;
 
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+Clock::duration Seconds(double seconds) {
+    return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+}
+
+Vector2 Lerp(const Vector2& from, const Vector2& to, float t) {
+    return Vector2(from.x + (to.x - from.x) * t, from.y + (to.y - from.y) * t);
+}
+
+} // namespace
+
 Game::Game() 
-    : running_(false), window_(nullptr) {
+    : running_(false), window_(nullptr), frame_number_(0), step_count_(0), step_seconds_(0.0),
+      replay_seconds_(0.0), replay_worst_step_seconds_(0.0), snapshot_(nullptr), render_alpha_(1.0f),
+      dialogue_draw_(INVALID_DRAW_HANDLE), dialogue_render_version_(0), asset_generation_(0) {
     instance_ = this;
 }
 
@@ -25,63 +56,336 @@ Game::~Game() {
     Shutdown();
 }
 
-bool Game::Initialize() {
+bool Game::Initialize(const GameOptions& options) {
+    options_ = options;
+    
+    // A replay only matches when it runs with the settings it was recorded with
+    if (!options_.replayPath.empty()) {
+        replay_ = std::make_unique<InputRecording>();
+        if (!replay_->Load(options_.replayPath)) {
+            return false;
+        }
+        options_.simulationRate = replay_->GetSimulationRate();
+        options_.startHour = replay_->GetStartHour();
+        options_.seed = replay_->GetSeed();
+        options_.hasSeed = true;
+    }
+    if (!options_.hasSeed) {
+        options_.seed = std::random_device()();
+        options_.hasSeed = true;
+    }
+    if (!options_.recordPath.empty()) {
+        recording_ = std::make_unique<InputRecording>();
+        recording_->Begin(options_.seed, options_.simulationRate, options_.startHour);
+    }
+    
     // Initialize SDL
-    if (!GameInit::InitializeSDL()) {
+    if (!GameInit::InitializeSDL(options_.headless)) {
         return false;
     }
     
     // Create game window
-    window_ = GameInit::CreateGameWindow(WINDOW_TITLE, WINDOW_WIDTH, WINDOW_HEIGHT);
+    window_ = GameInit::CreateGameWindow(WINDOW_TITLE, WINDOW_WIDTH, WINDOW_HEIGHT, options_.headless);
     if (!window_) {
         return false;
     }
     
     // Initialize game systems
-    auto initResult = GameInit::InitializeGameSystems(window_, WINDOW_WIDTH, WINDOW_HEIGHT);
+    auto initResult = GameInit::InitializeGameSystems(window_, WINDOW_WIDTH, WINDOW_HEIGHT, options_);
     if (!initResult.renderer) {
         return false;
     }
     
     // Move initialized systems to member variables
     renderer_ = std::move(initResult.renderer);
+    world_renderer_ = std::move(initResult.world_renderer);
+    light_map_ = std::move(initResult.light_map);
+    draw_list_ = std::move(initResult.draw_list);
     input_manager_ = std::move(initResult.input_manager);
     farming_system_ = std::move(initResult.farming_system);
     pottery_system_ = std::move(initResult.pottery_system);
+    lighting_system_ = std::move(initResult.lighting_system);
     player_ = std::move(initResult.player);
     camera_ = std::move(initResult.camera);
     dialogue_system_ = std::move(initResult.dialogue_system);
-    npc_manager_ = std::move(initResult.npc_manager);
-    dynamic_object_manager_ = std::move(initResult.dynamic_object_manager);
+    entity_store_ = std::move(initResult.entity_store);
+    collision_world_ = std::move(initResult.collision_world);
+    job_system_ = std::move(initResult.job_system);
+    world_entity_spawner_ = std::move(initResult.world_entity_spawner);
+    world_ = std::move(initResult.world);
+    
+    if (options_.textureBudgetMB > 0) {
+        renderer_->GetTextureCache()->SetBudget(static_cast<size_t>(options_.textureBudgetMB) * 1024 * 1024);
+    }
+    
+    step_seconds_ = 1.0 / options_.simulationRate;
+    
+    // The renderer always has a snapshot to draw, even before the first step
+    PublishSnapshot(Clock::now());
+    RegisterDrawItems();
     
+    if (!options_.captureFrames.empty()) {
+        frame_capture_ = std::make_unique<FrameCapture>(options_.captureFrames, options_.captureDir);
+    }
+    
+    frame_number_ = 0;
     running_ = true;
     return true;
 }
 
+void Game::RegisterDrawItems() {
+    // Everything drawn comes from the current snapshot, never from live game state
+    
+    // Static world (resident chunks, baked into textures)
+    draw_list_->Add(DrawLayer::WORLD, [this](Renderer* renderer, const Vector2& cameraOffset) {
+        world_renderer_->RenderWorld(renderer, &snapshot_->world, cameraOffset);
+    });
+    
+    // Player, NPCs and dynamic objects, already y-sorted by the simulation
+    draw_list_->Add(DrawLayer::ENTITIES, [this](Renderer* renderer, const Vector2& cameraOffset) {
+        for (const DrawnSprite& sprite : frame_sprites_) {
+            if (renderer->CullObject(sprite.bounds, cameraOffset)) continue;
+            
+            Vector2 screenPos(static_cast<float>(sprite.screenX), static_cast<float>(sprite.screenY));
+            renderer->DrawCachedSprite(sprite.sheet, sprite.frame, sprite.facing, screenPos);
+        }
+    });
+    
+    // Day/night light, multiplied over the world and entities but not the UI
+    draw_list_->Add(DrawLayer::LIGHTING, [this](Renderer* renderer, const Vector2& cameraOffset) {
+        light_map_->Render(renderer, cameraOffset);
+    });
+    
+    // Dialogue system (UI overlay)
+    dialogue_draw_ = draw_list_->Add(DrawLayer::UI, [this](Renderer* renderer, const Vector2&) {
+        DialogueSystem::Render(renderer, snapshot_->dialogue, WINDOW_WIDTH, WINDOW_HEIGHT);
+    });
+}
+
 void Game::Run() {
-    auto lastTime = std::chrono::high_resolution_clock::now();
+    // Headless runs draw exactly one frame per simulation step, so the same
+    // frame always shows the same state
+    if (options_.headless) {
+        while (running_) {
+            HandleEvents();
+            Step(static_cast<float>(step_seconds_));
+            PublishSnapshot(Clock::now());
+            Render();
+            
+            if (options_.frameCount > 0 && frame_number_ >= options_.frameCount) {
+                running_ = false;
+            }
+        }
+        return;
+    }
+    
+    // Otherwise the simulation runs on its own thread and this one only pumps
+    // events and draws, so a frame costs max(update, render) instead of the sum
+    std::thread simulation(&Game::SimulationLoop, this);
     
     while (running_) {
-        auto currentTime = std::chrono::high_resolution_clock::now();
-        float deltaTime = std::chrono::duration<float>(currentTime - lastTime).count();
-        lastTime = currentTime;
+        Clock::time_point frameStart = Clock::now();
         
         HandleEvents();
-        Update(deltaTime);
         Render();
         
-        SDL_Delay(16); // ~60 FPS
+        if (options_.frameCount > 0 && frame_number_ >= options_.frameCount) {
+            running_ = false;
+        }
+        
+        // Present already waits for the display when vsync is on
+        if (!renderer_->HasVSync()) {
+            std::this_thread::sleep_until(frameStart + Seconds(MAX_FRAME_RATE_SECONDS));
+        }
     }
+    
+    simulation.join();
+}
+
+void Game::SimulationLoop() {
+    Clock::time_point lastTime = Clock::now();
+    double accumulator = 0.0;
+    
+    while (running_) {
+        Clock::time_point now = Clock::now();
+        accumulator += std::chrono::duration<double>(now - lastTime).count();
+        lastTime = now;
+        
+        // Run every step that is due, but only so many back to back: a machine
+        // too slow for the rate would otherwise fall further behind each time
+        int steps = 0;
+        while (accumulator >= step_seconds_ && steps < MAX_CATCH_UP_STEPS) {
+            accumulator -= step_seconds_;
+            Step(static_cast<float>(step_seconds_));
+            steps++;
+        }
+        if (accumulator >= step_seconds_) {
+            accumulator = std::fmod(accumulator, step_seconds_);
+        }
+        
+        // Only the newest state is ever drawn; it was due accumulator seconds ago
+        if (steps > 0) {
+            PublishSnapshot(now - Seconds(accumulator));
+        }
+        
+        std::this_thread::sleep_for(Seconds(step_seconds_ - accumulator));
+    }
+}
+
+void Game::Step(float deltaTime) {
+    // Input the main thread gathered since the last step
+    {
+        std::lock_guard<std::mutex> lock(event_mutex_);
+        step_events_.swap(pending_events_);
+    }
+    if (replay_) {
+        // The recording stands in for the keyboard
+        Uint32 actions = 0;
+        if (!replay_->Next(actions)) return;
+        input_manager_->SetActionState(actions);
+    } else {
+        for (const SDL_Event& event : step_events_) {
+            input_manager_->HandleEvent(event);
+        }
+    }
+    step_events_.clear();
+    
+    if (recording_) {
+        recording_->Record(input_manager_->GetActionState());
+    }
+    
+    Clock::time_point start = Clock::now();
+    Update(deltaTime);
+    step_count_++;
+    
+    if (replay_) {
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        replay_seconds_ += seconds;
+        replay_worst_step_seconds_ = std::max(replay_worst_step_seconds_, seconds);
+        
+        // Checked straight after the last step, since a recording ended with
+        // Cmd+Q has already stopped the game by now
+        if (step_count_ == replay_->GetStepCount()) {
+            FinishReplay();
+        }
+    }
+}
+
+void Game::FinishReplay() {
+    running_ = false;
+    
+    Uint32 hash = HashState();
+    double steps = std::max(1u, step_count_);
+    std::cout << "[replay] " << step_count_ << " steps, " << replay_seconds_ * 1000.0 / steps
+              << " ms per step on average, " << replay_worst_step_seconds_ * 1000.0 << " ms worst" << std::endl;
+    if (hash == replay_->GetStateHash() && step_count_ == replay_->GetStepCount()) {
+        std::cout << "[replay] ended in the recorded state" << std::endl;
+    } else {
+        std::cout << "[replay] ended in a different state than recorded (hash " << std::hex << hash
+                  << ", recorded " << replay_->GetStateHash() << std::dec << ")" << std::endl;
+    }
+}
+
+Uint32 Game::HashState() const {
+    // FNV-1a over the raw bytes, so a replay that drifts by a single bit shows up
+    Uint32 hash = 2166136261u;
+    auto mix = [&hash](const void* data, size_t size) {
+        const Uint8* bytes = static_cast<const Uint8*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 16777619u;
+        }
+    };
+    
+    auto mixString = [&mix](const std::string& text) {
+        Uint32 length = static_cast<Uint32>(text.size());
+        mix(&length, sizeof(length));
+        mix(text.data(), text.size());
+    };
+    
+    mix(&step_count_, sizeof(step_count_));
+    float hour = lighting_system_->GetHour();
+    mix(&hour, sizeof(hour));
+    
+    // The player's velocity is also the way it faces
+    Vector2 playerPosition = player_->GetPosition();
+    Vector2 playerVelocity = player_->GetVelocity();
+    mix(&playerPosition.x, sizeof(playerPosition.x));
+    mix(&playerPosition.y, sizeof(playerPosition.y));
+    mix(&playerVelocity.x, sizeof(playerVelocity.x));
+    mix(&playerVelocity.y, sizeof(playerVelocity.y));
+    
+    DialogueView dialogue = dialogue_system_->GetView();
+    mix(&dialogue.active, sizeof(dialogue.active));
+    mix(&dialogue.showPrompt, sizeof(dialogue.showPrompt));
+    mixString(dialogue.text);
+    
+    const EntityComponents& c = entity_store_->GetComponents();
+    mix(c.positionX.data(), c.positionX.size() * sizeof(float));
+    mix(c.positionY.data(), c.positionY.size() * sizeof(float));
+    mix(c.velocityX.data(), c.velocityX.size() * sizeof(float));
+    mix(c.dialogueLine.data(), c.dialogueLine.size() * sizeof(Uint16));
+    
+    // Field by field, FarmTile has padding
+    for (const std::vector<FarmTile>& row : farming_system_->GetGrid()) {
+        for (const FarmTile& tile : row) {
+            Uint8 flags[3] = {static_cast<Uint8>(tile.stage), static_cast<Uint8>(tile.crop_type), tile.watered};
+            mix(flags, sizeof(flags));
+            mix(&tile.growth_time, sizeof(tile.growth_time));
+            mix(&tile.max_growth_time, sizeof(tile.max_growth_time));
+        }
+    }
+    
+    // The engine's text form is its whole state, so the next quality roll is covered too
+    std::ostringstream random;
+    random << pottery_system_->GetRandom();
+    mixString(random.str());
+    bool crafting = pottery_system_->IsCrafting();
+    float progress = pottery_system_->GetCraftingProgress();
+    mix(&crafting, sizeof(crafting));
+    mix(&progress, sizeof(progress));
+    for (ClayType clay : {ClayType::BASIC_CLAY, ClayType::RED_CLAY, ClayType::WHITE_CLAY}) {
+        int amount = pottery_system_->GetClayAmount(clay);
+        mix(&amount, sizeof(amount));
+    }
+    for (const PotteryItem& item : pottery_system_->GetInventory()) {
+        Uint8 type = static_cast<Uint8>(item.type);
+        mix(&type, sizeof(type));
+        mix(&item.quality, sizeof(item.quality));
+        mixString(item.name);
+    }
+    return hash;
 }
 
 void Game::HandleEvents() {
     SDL_Event event;
+    std::lock_guard<std::mutex> lock(event_mutex_);
     while (SDL_PollEvent(&event)) {
         if (event.type == SDL_QUIT) {
             running_ = false;
         }
         
-        input_manager_->HandleEvent(event);
+        // Render target contents are lost on device/target resets, re-bake the world and sprites
+        if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET) {
+            world_renderer_->Invalidate();
+            renderer_->GetSpriteCache()->Invalidate();
+            renderer_->MarkAllDirty();
+        }
+        
+        // The window surface may have been drawn over or recreated
+        if (event.type == SDL_WINDOWEVENT &&
+            (event.window.event == SDL_WINDOWEVENT_EXPOSED || event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED)) {
+            renderer_->MarkAllDirty();
+        }
+        
+        // A device reset loses every texture, including the glyph atlases
+        if (event.type == SDL_RENDER_DEVICE_RESET) {
+            if (renderer_->GetTextRenderer()) {
+                renderer_->GetTextRenderer()->ClearGlyphAtlases();
+            }
+            light_map_->Invalidate();
+        }
+        
+        pending_events_.push_back(event);
     }
 }
 
@@ -105,30 +409,17 @@ void Game::Update(float deltaTime) {
     camera_->SetTarget(player_->GetPosition());
     camera_->Update(deltaTime);
     
+    // Stream world chunks around the camera
+    world_->Update(camera_->GetOffset(), WINDOW_WIDTH, WINDOW_HEIGHT, deltaTime);
+    
     // Update dialogue system
     dialogue_system_->Update(deltaTime);
     
     Vector2 playerPos = player_->GetPosition();
     
-    // Check for interactable objects first (NPCs, dynamic objects)
-    bool nearInteractableObject = false;
-    Interactable* nearbyInteractable = nullptr;
-    
-    // Priority 1: Check for NPCs
-    auto* nearbyNPC = dialogue_system_->GetNearbyInteractable(playerPos);
-    if (nearbyNPC) {
-        nearInteractableObject = true;
-        nearbyInteractable = nearbyNPC;
-    }
-    
-    // Priority 2: Check for dynamic objects (like dog)
-    if (!nearInteractableObject) {
-        auto* nearbyDynamicObj = dynamic_object_manager_->GetInteractableNear(playerPos);
-        if (nearbyDynamicObj) {
-            nearInteractableObject = true;
-            nearbyInteractable = nearbyDynamicObj;
-        }
-    }
+    // Check for interactable entities first (NPCs before dogs and flower patches)
+    EntityId nearbyEntity = entity_store_->FindInteractable(playerPos);
+    bool nearInteractableObject = nearbyEntity != INVALID_ENTITY;
     
     // Update dialogue system state - only show interaction prompt for actual interactable objects
     if (nearInteractableObject) {
@@ -139,13 +430,9 @@ void Game::Update(float deltaTime) {
     
     // Handle dialogue interactions - only for interactable objects
     if (input_manager_->IsActionPressed(InputAction::INTERACT)) {
-        if (nearInteractableObject && nearbyInteractable) {
-            // Interact with the specific object
-            if (auto npc = dynamic_cast<NPC*>(nearbyInteractable)) {
-                dialogue_system_->ShowDialogue(npc);
-            } else if (auto dynamicObj = dynamic_cast<InteractableObject*>(nearbyInteractable)) {
-                dialogue_system_->ShowDialogue(dynamicObj);
-            }
+        if (nearInteractableObject) {
+            // Interact with the specific entity
+            dialogue_system_->ShowDialogue(nearbyEntity);
         } else if (dialogue_system_->IsDialogueActive()) {
             // Hide dialogue if not near anything and dialogue is active
             dialogue_system_->HideDialogue();
@@ -159,510 +446,260 @@ void Game::Update(float deltaTime) {
     
     
     // === Loading Objects ===
-    farming_system_->Update(deltaTime);
     pottery_system_->Update(deltaTime);
-    npc_manager_->UpdateAll(deltaTime);
-    dynamic_object_manager_->UpdateAll(deltaTime, player_->GetPosition());
+    lighting_system_->Update(deltaTime);
+    
+    // The farm only takes the job system once it is big enough to split
+    JobSystem* jobs = job_system_.get();
+    farming_system_->Update(deltaTime, jobs);
+    
+    // Movement and animation touch disjoint columns, so they run side by side
+    // and each splits its own loop further
+    Vector2 playerPosition = player_->GetPosition();
+    JobGraph graph;
+    graph.Add([this, deltaTime, jobs, playerPosition] {
+        EntitySystems::UpdateMovement(*entity_store_, deltaTime, playerPosition, collision_world_.get(), jobs);
+    });
+    graph.Add([this, deltaTime, jobs] { EntitySystems::UpdateAnimation(*entity_store_, deltaTime, jobs); });
+    job_system_->Run(graph);
     
     // Update input manager at the end to prepare for next frame
     input_manager_->Update();
 }
 
-void Game::Render() {
-    renderer_->Clear();
-    
-    Vector2 cameraOffset = camera_->GetOffset();
-    
-    const int TILE_SIZE = 128;
-    const int WORLD_WIDTH_TILES = 10;  
-    const int WORLD_HEIGHT_TILES = 8;  
-    
-    SDL_Color ghibliSky = {173, 216, 230, 255};          // Soft powder blue sky
-    SDL_Color ghibliGrass = {118, 154, 57, 255};         // Warmer, more golden grass
-    SDL_Color ghibliGarden = {95, 127, 58, 255};         // Lush garden green
-    SDL_Color ghibliWater = {79, 143, 186, 255};         // Clearer, more vibrant water
-    SDL_Color houseRoof = {165, 42, 42, 255};            // Warmer red roof
-    SDL_Color houseWalls = {237, 201, 175, 255};         // Cream-colored walls
-    SDL_Color houseBrown = {101, 67, 33, 255};           // Rich wood brown
-    SDL_Color farmSoil = {139, 90, 43, 255};             // Rich earth brown
-    SDL_Color dirtPath = {160, 130, 98, 255};            // Warm dirt path color
-    
-    SDL_Color roofAccent = {139, 26, 26, 255};           // Darker roof edges
-    SDL_Color windowBlue = {100, 149, 237, 255};         // Window accents
-    SDL_Color gardenFlower = {255, 182, 193, 255};       // Light pink flowers
-    
-    // Fill sky background (top portion)
-    for (int y = 0; y < 2; y++) {
-        for (int x = 0; x < WORLD_WIDTH_TILES; x++) {
-            Rect skyRect(x * TILE_SIZE, y * TILE_SIZE, TILE_SIZE, TILE_SIZE);
-            renderer_->DrawRectWorld(skyRect, cameraOffset, ghibliSky);
-        }
+void Game::PublishSnapshot(Clock::time_point stepTime) {
+    RenderSnapshot& snapshot = snapshots_.BeginWrite();
+    snapshot.step = step_count_;
+    snapshot.stepTime = stepTime;
+    snapshot.cameraOffset = camera_->GetOffset();
+    snapshot.previousCameraOffset = camera_->GetPreviousOffset();
+    
+    // Entities back to front by depth; ties keep collection order so they don't flicker
+    snapshot.sprites.clear();
+    Vector2 view = camera_->GetOffset();
+    Rect area(static_cast<int>(view.x) - SPRITE_CULL_MARGIN, static_cast<int>(view.y) - SPRITE_CULL_MARGIN,
+              camera_->GetViewportWidth() + 2 * SPRITE_CULL_MARGIN, camera_->GetViewportHeight() + 2 * SPRITE_CULL_MARGIN);
+    EntitySystems::CollectSprites(*entity_store_, area, snapshot.sprites);
+    snapshot.sprites.push_back(player_->GetSprite());
+    std::stable_sort(snapshot.sprites.begin(), snapshot.sprites.end(),
+                     [](const SpriteInstance& a, const SpriteInstance& b) { return a.sortY < b.sortY; });
+    
+    snapshot.world.Capture(*world_);
+    
+    // Slots are reused, the dialogue text is only copied when it changed
+    if (snapshot.dialogue.version != dialogue_system_->GetRenderVersion()) {
+        snapshot.dialogue = dialogue_system_->GetView();
     }
     
-    // Ground base layer
-    for (int y = 2; y < WORLD_HEIGHT_TILES; y++) {
-        for (int x = 0; x < WORLD_WIDTH_TILES; x++) {
-            Rect groundRect(x * TILE_SIZE, y * TILE_SIZE, TILE_SIZE, TILE_SIZE);
-            renderer_->DrawRectWorld(groundRect, cameraOffset, ghibliGrass);
-        }
+    // Lights are only copied when one was added, removed or changed
+    snapshot.lighting.sunStep = lighting_system_->GetSunStep();
+    if (snapshot.lighting.version != lighting_system_->GetVersion()) {
+        snapshot.lighting.lights = lighting_system_->GetLights();
+        snapshot.lighting.version = lighting_system_->GetVersion();
     }
     
-    // Top border
-    for (int x = 0; x < WORLD_WIDTH_TILES; x++) {
-        Rect waterRect(x * TILE_SIZE, 0, TILE_SIZE, TILE_SIZE);
-        renderer_->DrawRectWorld(waterRect, cameraOffset, ghibliWater);
-        // Add wave lines
-        for (int i = 0; i < 3; i++) {
-            Rect waveRect(x * TILE_SIZE + 10 + i * 35, 20 + i * 25, 60, 6);
-            renderer_->DrawRectWorld(waveRect, cameraOffset, SDL_Color{100, 160, 200, 255}); // Lighter blue waves
-        }
+    snapshots_.Publish();
+}
+
+void Game::Render() {
+    frame_number_++;
+    
+    // Newest finished simulation step; keep drawing the last one if none arrived
+    if (const RenderSnapshot* latest = snapshots_.AcquireLatest()) {
+        snapshot_ = latest;
     }
-    // Bottom border
-    for (int x = 0; x < WORLD_WIDTH_TILES; x++) {
-        Rect waterRect(x * TILE_SIZE, (WORLD_HEIGHT_TILES-1) * TILE_SIZE, TILE_SIZE, TILE_SIZE);
-        renderer_->DrawRectWorld(waterRect, cameraOffset, ghibliWater);
-        // Add wave lines
-        for (int i = 0; i < 3; i++) {
-            Rect waveRect(x * TILE_SIZE + 15 + i * 30, (WORLD_HEIGHT_TILES-1) * TILE_SIZE + 30 + i * 20, 50, 6);
-            renderer_->DrawRectWorld(waveRect, cameraOffset, SDL_Color{100, 160, 200, 255});
-        }
+    
+    // How far into the step after the snapshot we are. Headless frames show
+    // each step exactly.
+    render_alpha_ = 1.0f;
+    if (!options_.headless) {
+        float elapsed = std::chrono::duration<float>(Clock::now() - snapshot_->stepTime).count();
+        render_alpha_ = std::min(std::max(elapsed / static_cast<float>(step_seconds_), 0.0f), 1.0f);
     }
-    // Left border
-    for (int y = 1; y < WORLD_HEIGHT_TILES-1; y++) {
-        Rect waterRect(0, y * TILE_SIZE, TILE_SIZE, TILE_SIZE);
-        renderer_->DrawRectWorld(waterRect, cameraOffset, ghibliWater);
-        // Add wave lines
-        for (int i = 0; i < 3; i++) {
-            Rect waveRect(20 + i * 25, y * TILE_SIZE + 10 + i * 35, 6, 60);
-            renderer_->DrawRectWorld(waveRect, cameraOffset, SDL_Color{100, 160, 200, 255});
-        }
+    Vector2 cameraOffset = Lerp(snapshot_->previousCameraOffset, snapshot_->cameraOffset, render_alpha_);
+    
+    // Cached UI is re-drawn only when the dialogue changed
+    bool dialogueChanged = snapshot_->dialogue.version != dialogue_render_version_;
+    if (dialogueChanged) {
+        dialogue_render_version_ = snapshot_->dialogue.version;
+        draw_list_->Invalidate(dialogue_draw_);
     }
-    // Right border
-    for (int y = 1; y < WORLD_HEIGHT_TILES-1; y++) {
-        Rect waterRect((WORLD_WIDTH_TILES-1) * TILE_SIZE, y * TILE_SIZE, TILE_SIZE, TILE_SIZE);
-        renderer_->DrawRectWorld(waterRect, cameraOffset, ghibliWater);
-        // Add wave lines
-        for (int i = 0; i < 3; i++) {
-            Rect waveRect((WORLD_WIDTH_TILES-1) * TILE_SIZE + 30 + i * 20, y * TILE_SIZE + 15 + i * 30, 6, 50);
-            renderer_->DrawRectWorld(waveRect, cameraOffset, SDL_Color{100, 160, 200, 255});
-        }
+    
+    // Upload whatever the loader threads finished, within a budget so it never hitches
+    AssetLoader* assetLoader = renderer_->GetAssetLoader();
+    assetLoader->Update(ASSET_UPLOAD_BUDGET_MS);
+    if (assetLoader->GetGeneration() != asset_generation_) {
+        // Cached UI may have been recorded before its font arrived, and pages
+        // or fonts may have popped in anywhere
+        asset_generation_ = assetLoader->GetGeneration();
+        draw_list_->Invalidate(dialogue_draw_);
+        renderer_->MarkAllDirty();
     }
     
-    // Detailed 3D-style house with shadows and depth (top-left area)
-    for (int y = 2; y < 4; y++) {
-        for (int x = 2; x < 4; x++) {
-            if (y == 2) {
-                // Drop shadow for roof
-                Rect roofShadow(x * TILE_SIZE + 8, y * TILE_SIZE + 8, TILE_SIZE, TILE_SIZE);
-                renderer_->DrawRectWorld(roofShadow, cameraOffset, SDL_Color{0, 0, 0, 80});
-                
-                // Roof base with gradient effect
-                Rect roofRect(x * TILE_SIZE, y * TILE_SIZE, TILE_SIZE, TILE_SIZE);
-                renderer_->DrawRectWorld(roofRect, cameraOffset, houseRoof);
-                
-                // Roof highlight (top edge)
-                Rect roofHighlight(x * TILE_SIZE, y * TILE_SIZE, TILE_SIZE, 12);
-                renderer_->DrawRectWorld(roofHighlight, cameraOffset, SDL_Color{220, 60, 60, 255});
-                
-                // Roof shadow (bottom edge)
-                Rect roofShadowEdge(x * TILE_SIZE, y * TILE_SIZE + 116, TILE_SIZE, 12);
-                renderer_->DrawRectWorld(roofShadowEdge, cameraOffset, roofAccent);
-                
-                // Ghibli-style organic roof tiles with irregular spacing
-                for (int i = 0; i < 4; i++) {
-                    // Irregular tile rows for hand-drawn feel
-                    int tileY = y * TILE_SIZE + i * 28 + ((i % 2) * 4); // Slightly uneven rows
-                    
-                    // Dark tile lines with slight curves
-                    Rect tileLineH(x * TILE_SIZE, tileY, TILE_SIZE, 4);
-                    renderer_->DrawRectWorld(tileLineH, cameraOffset, roofAccent);
-                    
-                    // Add individual tile highlights with variation
-                    for (int j = 0; j < 4; j++) {
-                        int tileX = x * TILE_SIZE + j * 30 + ((j % 2) * 3);
-                        Rect tileHighlight(tileX, tileY + 4, 26, 3);
-                        SDL_Color highlightColor = {
-                            static_cast<Uint8>(180 + (j * 5)), 
-                            static_cast<Uint8>(45 + (j * 3)), 
-                            static_cast<Uint8>(45 + (j * 2)), 
-                            255
-                        };
-                        renderer_->DrawRectWorld(tileHighlight, cameraOffset, highlightColor);
-                    }
-                }
-                
-                // Vertical roof divisions with 3D effect
-                if (x == 3) {
-                    Rect tileLineV(x * TILE_SIZE + 60, y * TILE_SIZE, 8, TILE_SIZE);
-                    renderer_->DrawRectWorld(tileLineV, cameraOffset, roofAccent);
-                    Rect tileHighlightV(x * TILE_SIZE + 62, y * TILE_SIZE, 4, TILE_SIZE);
-                    renderer_->DrawRectWorld(tileHighlightV, cameraOffset, SDL_Color{200, 50, 50, 255});
-                }
-            } else {
-                // Wall shadow
-                Rect wallShadow(x * TILE_SIZE + 6, y * TILE_SIZE + 6, TILE_SIZE, TILE_SIZE);
-                renderer_->DrawRectWorld(wallShadow, cameraOffset, SDL_Color{0, 0, 0, 60});
-                
-                // Wall base with gradient
-                Rect wallRect(x * TILE_SIZE, y * TILE_SIZE, TILE_SIZE, TILE_SIZE);
-                renderer_->DrawRectWorld(wallRect, cameraOffset, houseWalls);
-                
-                // Wall highlight (top)
-                Rect wallHighlight(x * TILE_SIZE, y * TILE_SIZE, TILE_SIZE, 8);
-                renderer_->DrawRectWorld(wallHighlight, cameraOffset, SDL_Color{240, 200, 155, 255});
-                
-                // Wall shadow (bottom)
-                Rect wallShadowEdge(x * TILE_SIZE, y * TILE_SIZE + 120, TILE_SIZE, 8);
-                renderer_->DrawRectWorld(wallShadowEdge, cameraOffset, SDL_Color{190, 160, 115, 255});
-                
-                if (x == 2) {
-                    // Enhanced door with depth
-                    Rect doorShadow(x * TILE_SIZE + 42, y * TILE_SIZE + 22, 40, 80);
-                    renderer_->DrawRectWorld(doorShadow, cameraOffset, SDL_Color{0, 0, 0, 40});
-                    
-                    Rect doorRect(x * TILE_SIZE + 40, y * TILE_SIZE + 20, 40, 80);
-                    renderer_->DrawRectWorld(doorRect, cameraOffset, SDL_Color{139, 69, 19, 255});
-                    
-                    // Ghibli-style door with organic wood grain
-                    Rect doorPanel1(x * TILE_SIZE + 44, y * TILE_SIZE + 25, 32, 30);
-                    renderer_->DrawRectWorld(doorPanel1, cameraOffset, SDL_Color{160, 82, 22, 255});
-                    Rect doorPanel2(x * TILE_SIZE + 44, y * TILE_SIZE + 60, 32, 30);
-                    renderer_->DrawRectWorld(doorPanel2, cameraOffset, SDL_Color{160, 82, 22, 255});
-                    
-                    // Add wood grain lines
-                    for (int k = 0; k < 8; k++) {
-                        int grainY = y * TILE_SIZE + 28 + k * 8 + ((k % 2) * 2);
-                        Rect woodGrain(x * TILE_SIZE + 45, grainY, 30, 1 + (k % 2));
-                        SDL_Color grainColor = {
-                            static_cast<Uint8>(120 + (k * 3)), 
-                            static_cast<Uint8>(52 + (k * 2)), 
-                            static_cast<Uint8>(12 + k), 
-                            255
-                        };
-                        renderer_->DrawRectWorld(woodGrain, cameraOffset, grainColor);
-                    }
-                    
-                    // Door knob with highlight
-                    Rect knobShadow(x * TILE_SIZE + 73, y * TILE_SIZE + 56, 6, 6);
-                    renderer_->DrawRectWorld(knobShadow, cameraOffset, SDL_Color{0, 0, 0, 60});
-                    Rect knobRect(x * TILE_SIZE + 72, y * TILE_SIZE + 55, 6, 6);
-                    renderer_->DrawRectWorld(knobRect, cameraOffset, SDL_Color{255, 215, 0, 255});
-                    Rect knobHighlight(x * TILE_SIZE + 72, y * TILE_SIZE + 55, 3, 3);
-                    renderer_->DrawRectWorld(knobHighlight, cameraOffset, SDL_Color{255, 255, 200, 255});
-                } else {
-                    // Enhanced window with depth and reflection
-                    Rect windowShadow(x * TILE_SIZE + 32, y * TILE_SIZE + 32, 60, 50);
-                    renderer_->DrawRectWorld(windowShadow, cameraOffset, SDL_Color{0, 0, 0, 40});
-                    
-                    Rect windowRect(x * TILE_SIZE + 30, y * TILE_SIZE + 30, 60, 50);
-                    renderer_->DrawRectWorld(windowRect, cameraOffset, windowBlue);
-                    
-                    // Window reflection
-                    Rect windowReflection(x * TILE_SIZE + 35, y * TILE_SIZE + 35, 25, 20);
-                    renderer_->DrawRectWorld(windowReflection, cameraOffset, SDL_Color{200, 220, 255, 180});
-                    
-                    // Enhanced window frame with beveled edges
-                    Rect frameH1(x * TILE_SIZE + 26, y * TILE_SIZE + 26, 68, 6);
-                    Rect frameH2(x * TILE_SIZE + 26, y * TILE_SIZE + 78, 68, 6);
-                    Rect frameV1(x * TILE_SIZE + 26, y * TILE_SIZE + 26, 6, 58);
-                    Rect frameV2(x * TILE_SIZE + 86, y * TILE_SIZE + 26, 6, 58);
-                    renderer_->DrawRectWorld(frameH1, cameraOffset, houseBrown);
-                    renderer_->DrawRectWorld(frameH2, cameraOffset, houseBrown);
-                    renderer_->DrawRectWorld(frameV1, cameraOffset, houseBrown);
-                    renderer_->DrawRectWorld(frameV2, cameraOffset, houseBrown);
-                    
-                    // Frame highlights
-                    Rect frameHighlightH1(x * TILE_SIZE + 26, y * TILE_SIZE + 26, 68, 2);
-                    Rect frameHighlightV1(x * TILE_SIZE + 26, y * TILE_SIZE + 26, 2, 58);
-                    renderer_->DrawRectWorld(frameHighlightH1, cameraOffset, SDL_Color{180, 100, 40, 255});
-                    renderer_->DrawRectWorld(frameHighlightV1, cameraOffset, SDL_Color{180, 100, 40, 255});
-                    
-                    // Window cross with depth
-                    Rect crossH(x * TILE_SIZE + 30, y * TILE_SIZE + 50, 60, 6);
-                    Rect crossV(x * TILE_SIZE + 56, y * TILE_SIZE + 30, 6, 50);
-                    renderer_->DrawRectWorld(crossH, cameraOffset, houseBrown);
-                    renderer_->DrawRectWorld(crossV, cameraOffset, houseBrown);
-                    
-                    // Cross highlights
-                    Rect crossHighlightH(x * TILE_SIZE + 30, y * TILE_SIZE + 50, 60, 2);
-                    Rect crossHighlightV(x * TILE_SIZE + 56, y * TILE_SIZE + 30, 2, 50);
-                    renderer_->DrawRectWorld(crossHighlightH, cameraOffset, SDL_Color{180, 100, 40, 255});
-                    renderer_->DrawRectWorld(crossHighlightV, cameraOffset, SDL_Color{180, 100, 40, 255});
-                }
-            }
-        }
+    // Re-stamps changed lights and re-resolves on a new sun step; either recolors
+    // the whole overlay
+    if (light_map_->Update(renderer_.get(), snapshot_->lighting, cameraOffset)) {
+        renderer_->MarkAllDirty();
     }
     
-    // Farm area with prepared flower beds (top-right, visible from start)
-    for (int y = 2; y < 5; y++) {
-        for (int x = 6; x < 9; x++) {
-            // Base farm soil
-            SDL_Color farmBase = {139, 90, 43, 255}; // Rich brown soil
-            Rect farmRect(x * TILE_SIZE, y * TILE_SIZE, TILE_SIZE, TILE_SIZE);
-            renderer_->DrawRectWorld(farmRect, cameraOffset, farmBase);
-            
-            // Check if this tile has a flower patch and create prepared bed
-            bool hasFlowerPatch = (x == 6 && y == 2) || (x == 8 && y == 4);
-            
-            if (hasFlowerPatch) {
-                // Create a prepared flower bed with darker, richer soil
-                SDL_Color preparedSoil = {95, 127, 58, 255}; // Garden-like soil for flowers
-                Rect flowerBed(x * TILE_SIZE + 25, y * TILE_SIZE + 25, 65, 65);
-                renderer_->DrawRectWorld(flowerBed, cameraOffset, preparedSoil);
-                
-                // Add subtle prepared soil texture
-                for (int i = 0; i < 4; i++) {
-                    int soilX = x * TILE_SIZE + 30 + (i % 2) * 25;
-                    int soilY = y * TILE_SIZE + 30 + (i / 2) * 25;
-                    Rect soilPatch(soilX, soilY, 15, 15);
-                    SDL_Color soilVariation = ((i % 2) == 0) ? 
-                        SDL_Color{105, 137, 68, 255} : SDL_Color{85, 117, 48, 255};
-                    renderer_->DrawRectWorld(soilPatch, cameraOffset, soilVariation);
-                }
-            } else {
-                // Regular farm soil texture for non-flower areas
-                for (int i = 0; i < 6; i++) {
-                    int soilX = x * TILE_SIZE + 15 + (i % 3) * 32;
-                    int soilY = y * TILE_SIZE + 15 + (i / 3) * 32;
-                    Rect soilPatch(soilX, soilY, 20, 20);
-                    SDL_Color soilVariation = ((i % 2) == 0) ? 
-                        SDL_Color{125, 80, 38, 255} : SDL_Color{155, 100, 48, 255};
-                    renderer_->DrawRectWorld(soilPatch, cameraOffset, soilVariation);
-                }
-            }
+    BuildFrameSprites(cameraOffset);
+    
+    // World, y-sorted entities and UI, back to front
+    if (renderer_->IsTrackingDirtyRects()) {
+        // Only the regions that changed; the rest of the backbuffer is still last frame's
+        MarkDirtyRegions(cameraOffset, dialogueChanged);
+        for (const SDL_Rect& region : renderer_->BuildDirtyRegions()) {
+            renderer_->SetClipRect(&region);
+            renderer_->Clear();
+            draw_list_->Submit(renderer_.get(), cameraOffset);
         }
+        renderer_->SetClipRect(nullptr);
+    } else {
+        renderer_->Clear();
+        draw_list_->Submit(renderer_.get(), cameraOffset);
     }
     
-    // Garden area with prepared flower beds (bottom-center, visible from start)
-    for (int y = 5; y < 7; y++) {
-        for (int x = 3; x < 7; x++) {
-            // Garden grass base
-            Rect gardenRect(x * TILE_SIZE, y * TILE_SIZE, TILE_SIZE, TILE_SIZE);
-            renderer_->DrawRectWorld(gardenRect, cameraOffset, ghibliGarden);
-            
-            // Check if this tile has a flower patch and create prepared bed
-            bool hasFlowerPatch = (x == 4 && y == 5) || (x == 6 && y == 6);
-            
-            if (hasFlowerPatch) {
-                // Create a prepared flower bed with richer garden soil
-                SDL_Color preparedGarden = {75, 97, 37, 255}; // Darker garden soil for flowers
-                Rect flowerBed(x * TILE_SIZE + 30, y * TILE_SIZE + 30, 55, 55);
-                renderer_->DrawRectWorld(flowerBed, cameraOffset, preparedGarden);
-                
-                // Add subtle prepared garden texture
-                for (int i = 0; i < 4; i++) {
-                    int soilX = x * TILE_SIZE + 35 + (i % 2) * 20;
-                    int soilY = y * TILE_SIZE + 35 + (i / 2) * 20;
-                    Rect soilPatch(soilX, soilY, 12, 12);
-                    SDL_Color soilVariation = ((i % 2) == 0) ? 
-                        SDL_Color{85, 107, 47, 255} : SDL_Color{65, 87, 27, 255};
-                    renderer_->DrawRectWorld(soilPatch, cameraOffset, soilVariation);
-                }
-            } else {
-                // Regular grass texture for non-flower areas
-                for (int i = 0; i < 15; i++) {
-                    int grassX = x * TILE_SIZE + 10 + (i % 5) * 22;
-                    int grassY = y * TILE_SIZE + 10 + (i / 5) * 22;
-                    Rect grassPatch(grassX, grassY, 14, 14);
-                    SDL_Color grassVariation = ((i % 3) == 0) ? 
-                        SDL_Color{95, 117, 42, 255} : SDL_Color{75, 97, 37, 255};
-                    renderer_->DrawRectWorld(grassPatch, cameraOffset, grassVariation);
-                }
-            }
-            
-            // Enhanced 3D bushes
-            if ((x + y) % 3 == 1) {
-                // Bush shadow
-                Rect bushShadow(x * TILE_SIZE + 43, y * TILE_SIZE + 43, 40, 30);
-                renderer_->DrawRectWorld(bushShadow, cameraOffset, SDL_Color{0, 0, 0, 50});
-                
-                // Bush base
-                Rect bushRect(x * TILE_SIZE + 40, y * TILE_SIZE + 40, 40, 30);
-                renderer_->DrawRectWorld(bushRect, cameraOffset, SDL_Color{34, 85, 34, 255});
-                
-                // Bush layers for depth
-                Rect bushLayer1(x * TILE_SIZE + 42, y * TILE_SIZE + 38, 36, 25);
-                renderer_->DrawRectWorld(bushLayer1, cameraOffset, SDL_Color{44, 95, 44, 255});
-                
-                Rect bushLayer2(x * TILE_SIZE + 45, y * TILE_SIZE + 35, 30, 20);
-                renderer_->DrawRectWorld(bushLayer2, cameraOffset, SDL_Color{54, 105, 54, 255});
-                
-                // Bush highlights
-                Rect bushHighlight1(x * TILE_SIZE + 40, y * TILE_SIZE + 37, 20, 6);
-                renderer_->DrawRectWorld(bushHighlight1, cameraOffset, SDL_Color{70, 130, 70, 255});
-                
-                Rect bushHighlight2(x * TILE_SIZE + 55, y * TILE_SIZE + 40, 15, 4);
-                renderer_->DrawRectWorld(bushHighlight2, cameraOffset, SDL_Color{80, 140, 80, 255});
-            }
-            
-            // Enhanced grass blade details with shadows
-            for (int i = 0; i < 12; i++) {
-                int grassX = x * TILE_SIZE + 8 + (i % 4) * 28;
-                int grassY = y * TILE_SIZE + 8 + (i / 4) * 28;
-                
-                // Grass shadow
-                Rect grassShadow(grassX + 1, grassY + 1, 3, 12);
-                renderer_->DrawRectWorld(grassShadow, cameraOffset, SDL_Color{0, 0, 0, 20});
-                
-                // Grass blade
-                Rect grassDetail(grassX, grassY, 3, 12);
-                SDL_Color grassColor = ((i % 3) == 0) ? 
-                    SDL_Color{120, 160, 50, 255} : SDL_Color{100, 140, 40, 255};
-                renderer_->DrawRectWorld(grassDetail, cameraOffset, grassColor);
-                
-                // Grass highlight
-                Rect grassHighlight(grassX, grassY, 1, 6);
-                renderer_->DrawRectWorld(grassHighlight, cameraOffset, SDL_Color{140, 180, 60, 255});
-            }
-        }
+    // Read back before presenting, the back buffer is undefined afterwards
+    if (frame_capture_ && frame_capture_->ShouldCapture(frame_number_)) {
+        frame_capture_->Capture(renderer_.get(), frame_number_);
     }
     
-    // Ghibli-style organic dirt paths - horizontal path from house to farm
-    for (int x = 4; x < 6; x++) {
-        // Worn dirt path base with natural variation
-        Rect pathRect(x * TILE_SIZE, 3 * TILE_SIZE, TILE_SIZE, TILE_SIZE);
-        renderer_->DrawRectWorld(pathRect, cameraOffset, dirtPath);
-        
-        // Add natural dirt texture with organic patches
-        for (int i = 0; i < 24; i++) {
-            int dirtX = x * TILE_SIZE + 8 + (i % 6) * 18 + ((i % 3) * 4); // Irregular spacing
-            int dirtY = 3 * TILE_SIZE + 8 + (i / 6) * 25 + ((i % 2) * 6);
-            int patchSize = 12 + (i % 8); // Varied patch sizes
-            
-            SDL_Color dirtVariation;
-            if (i % 4 == 0) {
-                dirtVariation = {140, 110, 78, 255}; // Darker dirt
-            } else if (i % 4 == 1) {
-                dirtVariation = {175, 145, 118, 255}; // Lighter dirt
-            } else if (i % 4 == 2) {
-                dirtVariation = {155, 120, 85, 255}; // Medium dirt
-            } else {
-                dirtVariation = {130, 105, 70, 255}; // Rich earth
-            }
-            
-            Rect dirtPatch(dirtX, dirtY, patchSize, patchSize - 2);
-            renderer_->DrawRectWorld(dirtPatch, cameraOffset, dirtVariation);
-        }
-        
-        // Add small pebbles and natural debris
-        for (int i = 0; i < 8; i++) {
-            int pebbleX = x * TILE_SIZE + 15 + (i % 3) * 35 + ((i % 2) * 10);
-            int pebbleY = 3 * TILE_SIZE + 20 + (i / 3) * 30 + ((i % 3) * 8);
-            
-            // Small pebble
-            Rect pebble(pebbleX, pebbleY, 4 + (i % 3), 3 + (i % 2));
-            SDL_Color pebbleColor = ((i % 2) == 0) ? 
-                SDL_Color{120, 115, 110, 255} : SDL_Color{105, 100, 95, 255};
-            renderer_->DrawRectWorld(pebble, cameraOffset, pebbleColor);
+    renderer_->Present();
+    
+#ifdef DEBUG
+    // Periodic renderer submission stats
+    static int statsFrame = 0;
+    if (++statsFrame % 300 == 0) {
+        const RenderStats& stats = renderer_->GetFrameStats();
+        std::cout << "[render] draw calls: " << stats.drawCalls
+                  << ", state changes: " << stats.stateChanges
+                  << ", rects: " << stats.rectsSubmitted
+                  << " in " << stats.rectBatches << " batches"
+                  << ", culled draws/tiles/objects: " << stats.drawsCulled
+                  << "/" << stats.tilesCulled << "/" << stats.objectsCulled << std::endl;
+        if (renderer_->IsTrackingDirtyRects()) {
+            std::cout << "[dirty rects] regions: " << stats.regionsRedrawn
+                      << ", pixels: " << stats.pixelsRedrawn
+                      << " of " << WINDOW_WIDTH * WINDOW_HEIGHT << std::endl;
         }
+        const DrawListStats& drawStats = draw_list_->GetFrameStats();
+        std::cout << "[draw list] layers drawn: " << drawStats.layersDrawn
+                  << ", replayed: " << drawStats.layersReplayed
+                  << ", sorted: " << drawStats.layersSorted
+                  << " (" << drawStats.sortShifts << " shifts)" << std::endl;
+        std::cout << "[world] resident chunks: " << snapshot_->world.GetResidentChunkCount()
+                  << ", baked: " << world_renderer_->GetChunkCount()
+                  << ", drawn: " << world_renderer_->GetChunksDrawnLastFrame() << std::endl;
+        std::cout << "[lighting] lights: " << light_map_->GetLightCount()
+                  << ", cells stamped: " << light_map_->GetCellsStampedLastUpdate() << std::endl;
+        std::cout << "[sprites] baked sheets: " << renderer_->GetSpriteCache()->GetBakedSheetCount()
+                  << ", assets loading: " << renderer_->GetAssetLoader()->GetPendingCount() << std::endl;
+        TextureCacheStats textureStats = renderer_->GetTextureCache()->GetStats();
+        std::cout << "[textures] resident: " << textureStats.residentTextures
+                  << " (" << textureStats.residentBytes / 1024 << " / " << textureStats.budgetBytes / 1024 << " KB)"
+                  << ", hits: " << textureStats.hits
+                  << ", misses: " << textureStats.misses
+                  << ", evictions: " << textureStats.evictions << std::endl;
         
-        // Natural grass edges bleeding into path
-        for (int i = 0; i < 6; i++) {
-            int grassX = x * TILE_SIZE + (i % 2) * 110 + ((i % 3) * 8);
-            int grassY = 3 * TILE_SIZE + (i / 2) * 40 + ((i % 2) * 12);
-            
-            Rect grassTuft(grassX, grassY, 8, 6);
-            renderer_->DrawRectWorld(grassTuft, cameraOffset, SDL_Color{108, 144, 47, 200}); // Semi-transparent grass
+        if (TextRenderer* text = renderer_->GetTextRenderer()) {
+            const TextLayoutStats& layoutStats = text->GetLayoutStats();
+            std::cout << "[text] layout cache hits: " << layoutStats.hits
+                      << ", misses: " << layoutStats.misses
+                      << ", cached: " << layoutStats.cachedLayouts << std::endl;
         }
     }
+#endif
+}
+
+void Game::BuildFrameSprites(const Vector2& cameraOffset) {
+    SpriteCache* spriteCache = renderer_->GetSpriteCache();
+    frame_sprites_.clear();
     
-    // Ghibli-style organic dirt path - vertical path from center to garden
-    for (int y = 4; y < 5; y++) {
-        for (int pathX = 4; pathX < 6; pathX++) {
-            // Worn dirt path base
-            Rect pathRect(pathX * TILE_SIZE, y * TILE_SIZE, TILE_SIZE, TILE_SIZE);
-            renderer_->DrawRectWorld(pathRect, cameraOffset, dirtPath);
-            
-            // Add natural dirt texture with organic patches
-            for (int i = 0; i < 20; i++) {
-                int dirtX = pathX * TILE_SIZE + 6 + (i % 5) * 22 + ((i % 3) * 5);
-                int dirtY = y * TILE_SIZE + 6 + (i / 5) * 28 + ((i % 2) * 7);
-                int patchSize = 10 + (i % 6);
-                
-                SDL_Color dirtVariation;
-                if (i % 5 == 0) {
-                    dirtVariation = {135, 105, 75, 255}; // Rich earth
-                } else if (i % 5 == 1) {
-                    dirtVariation = {170, 140, 115, 255}; // Light dirt
-                } else if (i % 5 == 2) {
-                    dirtVariation = {145, 115, 80, 255}; // Medium dirt
-                } else if (i % 5 == 3) {
-                    dirtVariation = {125, 95, 65, 255}; // Dark soil
-                } else {
-                    dirtVariation = {160, 125, 90, 255}; // Sandy dirt
-                }
-                
-                Rect dirtPatch(dirtX, dirtY, patchSize, patchSize - 1);
-                renderer_->DrawRectWorld(dirtPatch, cameraOffset, dirtVariation);
-            }
-            
-            // Add footprint-like indentations for Ghibli charm
-            for (int i = 0; i < 6; i++) {
-                int footX = pathX * TILE_SIZE + 25 + (i % 2) * 45 + ((i % 3) * 6);
-                int footY = y * TILE_SIZE + 15 + (i / 2) * 35;
-                
-                // Footprint depression
-                Rect footprint(footX, footY, 18, 10);
-                renderer_->DrawRectWorld(footprint, cameraOffset, SDL_Color{125, 95, 65, 255});
-                
-                // Footprint toes
-                for (int j = 0; j < 3; j++) {
-                    Rect toe(footX + 2 + j * 4, footY - 2, 3, 3);
-                    renderer_->DrawRectWorld(toe, cameraOffset, SDL_Color{120, 90, 60, 255});
-                }
-            }
-            
-            // Scattered pebbles and organic elements
-            for (int i = 0; i < 10; i++) {
-                int pebbleX = pathX * TILE_SIZE + 10 + (i % 4) * 28 + ((i % 2) * 12);
-                int pebbleY = y * TILE_SIZE + 12 + (i / 4) * 35 + ((i % 3) * 10);
-                
-                Rect pebble(pebbleX, pebbleY, 3 + (i % 4), 2 + (i % 3));
-                SDL_Color pebbleColor = ((i % 3) == 0) ? 
-                    SDL_Color{115, 110, 105, 255} : SDL_Color{95, 90, 85, 255};
-                renderer_->DrawRectWorld(pebble, cameraOffset, pebbleColor);
-            }
-            
-            // Natural grass tufts growing along path edges
-            for (int i = 0; i < 8; i++) {
-                int grassX = pathX * TILE_SIZE + (i % 2) * 115 + ((i % 4) * 6);
-                int grassY = y * TILE_SIZE + 5 + (i / 2) * 28 + ((i % 3) * 8);
-                
-                Rect grassTuft(grassX, grassY, 6 + (i % 3), 8);
-                renderer_->DrawRectWorld(grassTuft, cameraOffset, SDL_Color{108, 144, 47, 180});
-            }
-        }
+    for (const SpriteInstance& sprite : snapshot_->sprites) {
+        Vector2 position = Lerp(sprite.previousPosition, sprite.position, render_alpha_);
+        
+        DrawnSprite drawn;
+        drawn.sheet = sprite.sheet;
+        drawn.frame = sprite.frame;
+        drawn.facing = sprite.facing;
+        drawn.screenX = static_cast<int>(position.x - cameraOffset.x);
+        drawn.screenY = static_cast<int>(position.y - cameraOffset.y);
+        drawn.screenBounds = spriteCache->GetCellBounds(sprite.sheet, drawn.screenX, drawn.screenY);
+        
+        // The cell in world space, a pixel wider on each side for the rounding
+        Rect cell = spriteCache->GetCellBounds(sprite.sheet, static_cast<int>(std::floor(position.x)),
+                                               static_cast<int>(std::floor(position.y)));
+        drawn.bounds = Rect(cell.x - 1, cell.y - 1, cell.w + 2, cell.h + 2);
+        frame_sprites_.push_back(drawn);
     }
-    
+}
 
-    // Render all NPCs
-    npc_manager_->RenderAll(renderer_.get(), cameraOffset);
+void Game::MarkDirtyRegions(const Vector2& cameraOffset, bool dialogueChanged) {
+    Rect dialogueBounds = DialogueSystem::GetScreenBounds(snapshot_->dialogue, WINDOW_WIDTH, WINDOW_HEIGHT);
     
-    // Render all dynamic objects (including dog)
-    dynamic_object_manager_->RenderAll(renderer_.get(), cameraOffset);
-    
-    // Render player with camera offset
-    player_->Render(renderer_.get(), cameraOffset);
-    
-    // Render dialogue system (UI overlay)
-    dialogue_system_->Render(renderer_.get(), WINDOW_WIDTH, WINDOW_HEIGHT);
+    // Scrolling moves every pixel on screen
+    if (cameraOffset.x != last_camera_offset_.x || cameraOffset.y != last_camera_offset_.y) {
+        renderer_->MarkAllDirty();
+    }
+    last_camera_offset_ = cameraOffset;
+    
+    // Sprites that moved, animated, appeared or went away: where they were and
+    // where they are now. Both frames sorted, so one merge pass finds them.
+    sorted_frame_sprites_.assign(frame_sprites_.begin(), frame_sprites_.end());
+    std::sort(sorted_frame_sprites_.begin(), sorted_frame_sprites_.end());
+    auto current = sorted_frame_sprites_.begin();
+    auto last = last_frame_sprites_.begin();
+    while (current != sorted_frame_sprites_.end() || last != last_frame_sprites_.end()) {
+        if (last == last_frame_sprites_.end() || (current != sorted_frame_sprites_.end() && *current < *last)) {
+            renderer_->MarkDirty(current->screenBounds);
+            ++current;
+        } else if (current == sorted_frame_sprites_.end() || *last < *current) {
+            renderer_->MarkDirty(last->screenBounds);
+            ++last;
+        } else {
+            ++current;
+            ++last;
+        }
+    }
+    last_frame_sprites_.swap(sorted_frame_sprites_);
     
-    renderer_->Present();
-}
-
-bool Game::CheckNPCCollision(const Vector2& playerPosition) const {
-    return npc_manager_ ? npc_manager_->CheckCollisionWithAny(playerPosition) : false;
+    if (dialogueChanged) {
+        renderer_->MarkDirty(dialogue_bounds_);
+        renderer_->MarkDirty(dialogueBounds);
+    }
+    dialogue_bounds_ = dialogueBounds;
 }
 
 void Game::Shutdown() {
+    // Written now, while the state it ended in can still be hashed
+    if (recording_ && player_ && entity_store_ && dialogue_system_ &&
+        farming_system_ && pottery_system_ && lighting_system_) {
+        if (recording_->Save(options_.recordPath, HashState())) {
+            std::cout << "[record] " << recording_->GetStepCount() << " steps written to "
+                      << options_.recordPath << std::endl;
+        }
+    }
+    recording_.reset();
+    
+    // No jobs run outside a step, but stop the workers before anything they touch goes away
+    job_system_.reset();
+    
+    // The world despawns chunk entities on shutdown, release it while the entity store exists
+    world_.reset();
+    world_entity_spawner_.reset();
+    collision_world_.reset();
     dialogue_system_.reset();
-    dynamic_object_manager_.reset();
-    npc_manager_.reset();
+    entity_store_.reset();
     camera_.reset();
     pottery_system_.reset();
+    lighting_system_.reset();
     farming_system_.reset();
     input_manager_.reset();
     player_.reset();
+    world_renderer_.reset();
+    light_map_.reset();
+    draw_list_.reset();
+    frame_capture_.reset();
     renderer_.reset();
     
     GameInit::ShutdownSDL(window_);
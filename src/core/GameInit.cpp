@@ -1,19 +1,177 @@
 #include "GameInit.h"
 #include "Renderer.h"
+#include "SpriteCache.h"
+#include "WorldRenderer.h"
+#include "DrawList.h"
 #include "InputManager.h"
 #include "FarmingSystem.h"
 #include "PotterySystem.h"
+#include "LightingSystem.h"
+#include "LightMap.h"
 #include "Player.h"
-#include "NPCManager.h"
-#include "DynamicObjectManager.h"
+#include "NPC.h"
 #include "Dog.h"
 #include "FlowerPatch.h"
+#include "EntityStore.h"
+#include "CollisionWorld.h"
+#include "JobSystem.h"
+#include "World.h"
+#include "WorldFile.h"
+#include "WorldEntitySpawner.h"
 #include "Camera.h"
 #include "DialogueSystem.h"
+#include <algorithm>
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
 
-bool GameInit::InitializeSDL() {
-    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) != 0) {
+namespace {
+
+const int DEFAULT_HEADLESS_FRAMES = 600;
+const int MAX_JOB_WORKERS = 7;
+
+// Cooked assets live next to the executable
+std::string AssetPath(const std::string& relativePath) {
+    std::string path = relativePath;
+    if (char* basePath = SDL_GetBasePath()) {
+        path = std::string(basePath) + relativePath;
+        SDL_free(basePath);
+    }
+    return path;
+}
+
+bool ParsePositiveInt(const std::string& text, int& value) {
+    std::istringstream stream(text);
+    return (stream >> value) && stream.eof() && value > 0;
+}
+
+bool ParseNonNegativeInt(const std::string& text, int& value) {
+    std::istringstream stream(text);
+    return (stream >> value) && stream.eof() && value >= 0;
+}
+
+bool ParseHour(const std::string& text, int& value) {
+    std::istringstream stream(text);
+    return (stream >> value) && stream.eof() && value >= 0 && value < 24;
+}
+
+// Any 32-bit value, so every seed a recording can hold can be given back
+bool ParseSeed(const std::string& text, unsigned int& value) {
+    if (text.empty() || text.size() > 10 || text.find_first_not_of("0123456789") != std::string::npos) {
+        return false;
+    }
+    unsigned long long parsed = std::stoull(text); // Can't overflow at 10 digits
+    if (parsed > 0xFFFFFFFFull) return false;
+    value = static_cast<unsigned int>(parsed);
+    return true;
+}
+
+} // namespace
+
+bool GameInit::ParseCommandLine(int argc, char* argv[], GameOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        
+        if (arg == "--headless") {
+            options.headless = true;
+        } else if (arg == "--dirty-rects") {
+            options.dirtyRects = true;
+        } else if (arg == "--frames" && hasValue) {
+            if (!ParsePositiveInt(argv[++i], options.frameCount)) {
+                std::cerr << "Invalid frame count: " << argv[i] << std::endl;
+                return false;
+            }
+        } else if (arg == "--capture" && hasValue) {
+            std::istringstream frames(argv[++i]);
+            std::string frameText;
+            while (std::getline(frames, frameText, ',')) {
+                int frame = 0;
+                if (!ParsePositiveInt(frameText, frame)) {
+                    std::cerr << "Invalid capture frame: " << frameText << std::endl;
+                    return false;
+                }
+                options.captureFrames.push_back(frame);
+            }
+        } else if (arg == "--capture-dir" && hasValue) {
+            options.captureDir = argv[++i];
+        } else if (arg == "--sim-rate" && hasValue) {
+            if (!ParsePositiveInt(argv[++i], options.simulationRate)) {
+                std::cerr << "Invalid simulation rate: " << argv[i] << std::endl;
+                return false;
+            }
+        } else if (arg == "--pixel-scale" && hasValue) {
+            if (!ParsePositiveInt(argv[++i], options.pixelScale)) {
+                std::cerr << "Invalid pixel scale: " << argv[i] << std::endl;
+                return false;
+            }
+        } else if (arg == "--start-hour" && hasValue) {
+            if (!ParseHour(argv[++i], options.startHour)) {
+                std::cerr << "Invalid start hour: " << argv[i] << std::endl;
+                return false;
+            }
+        } else if (arg == "--texture-budget" && hasValue) {
+            if (!ParsePositiveInt(argv[++i], options.textureBudgetMB)) {
+                std::cerr << "Invalid texture budget: " << argv[i] << std::endl;
+                return false;
+            }
+        } else if (arg == "--seed" && hasValue) {
+            if (!ParseSeed(argv[++i], options.seed)) {
+                std::cerr << "Invalid seed: " << argv[i] << std::endl;
+                return false;
+            }
+            options.hasSeed = true;
+        } else if (arg == "--record" && hasValue) {
+            options.recordPath = argv[++i];
+        } else if (arg == "--replay" && hasValue) {
+            options.replayPath = argv[++i];
+        } else if (arg == "--workers" && hasValue) {
+            if (!ParseNonNegativeInt(argv[++i], options.workerCount)) {
+                std::cerr << "Invalid worker count: " << argv[i] << std::endl;
+                return false;
+            }
+        } else {
+            std::cerr << "Unknown or incomplete option: " << arg << std::endl;
+            std::cerr << "Usage: " << argv[0]
+                      << " [--headless] [--dirty-rects] [--frames <n>] [--capture <n,n,...>] [--capture-dir <dir>]"
+                      << " [--sim-rate <Hz>] [--pixel-scale <n>] [--start-hour <0-23>] [--texture-budget <MB>]"
+                      << " [--workers <n>] [--seed <n>] [--record <file>] [--replay <file>]"
+                      << std::endl;
+            return false;
+        }
+    }
+    
+    if (!options.recordPath.empty() && !options.replayPath.empty()) {
+        std::cerr << "--record and --replay can't be combined" << std::endl;
+        return false;
+    }
+    
+    if (options.dirtyRects && options.pixelScale > 1) {
+        std::cerr << "--dirty-rects and --pixel-scale can't be combined" << std::endl;
+        return false;
+    }
+    
+    // A headless run always ends: at the last capture, the end of the replay, or after a default length
+    if (options.headless && options.frameCount == 0 && options.replayPath.empty()) {
+        if (options.captureFrames.empty()) {
+            options.frameCount = DEFAULT_HEADLESS_FRAMES;
+        } else {
+            options.frameCount = *std::max_element(options.captureFrames.begin(), options.captureFrames.end());
+        }
+    }
+    
+    return true;
+}
+
+bool GameInit::InitializeSDL(bool headless) {
+    // Build machines have no display or audio device
+    if (headless) {
+        SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+    }
+    
+    Uint32 subsystems = headless ? SDL_INIT_VIDEO : (SDL_INIT_VIDEO | SDL_INIT_AUDIO);
+    if (SDL_Init(subsystems) != 0) {
         std::cerr << "SDL_Init Error: " << SDL_GetError() << std::endl;
         return false;
     }
@@ -26,14 +184,14 @@ bool GameInit::InitializeSDL() {
     return true;
 }
 
-SDL_Window* GameInit::CreateGameWindow(const char* title, int width, int height) {
+SDL_Window* GameInit::CreateGameWindow(const char* title, int width, int height, bool headless) {
     SDL_Window* window = SDL_CreateWindow(
         title,
         SDL_WINDOWPOS_CENTERED,
         SDL_WINDOWPOS_CENTERED,
         width,
         height,
-        SDL_WINDOW_SHOWN
+        headless ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN
     );
     
     if (!window) {
@@ -44,22 +202,52 @@ SDL_Window* GameInit::CreateGameWindow(const char* title, int width, int height)
     return window;
 }
 
-GameInit::InitResult GameInit::InitializeGameSystems(SDL_Window* window, int window_width, int window_height) {
+GameInit::InitResult GameInit::InitializeGameSystems(SDL_Window* window, int window_width, int window_height, const GameOptions& options) {
     InitResult result;
     
     // Initialize renderer
     result.renderer = std::make_unique<Renderer>();
-    if (!result.renderer->Initialize(window)) {
+    if (!result.renderer->Initialize(window, options.headless, options.dirtyRects, options.pixelScale)) {
         std::cerr << "Failed to initialize renderer!" << std::endl;
         return {};
     }
     
+    // Sprite atlas produced by the cook_assets target
+    result.renderer->LoadSpriteAtlas(AssetPath("assets/cooked/sprites.atlas"));
+    
+    // Pages and fonts normally pop in over the first frames; headless frames
+    // must not depend on load timing
+    if (options.headless) {
+        result.renderer->GetAssetLoader()->Finish();
+    }
+    
+    // Procedurally drawn entities are rasterized once per frame/facing, then blitted
+    SpriteCache* spriteCache = result.renderer->GetSpriteCache();
+    spriteCache->Define(SpriteSheet::PLAYER, Player::GetSpriteSheet());
+    spriteCache->Define(SpriteSheet::NPC, NPC::GetSpriteSheet());
+    spriteCache->Define(SpriteSheet::DOG, Dog::GetSpriteSheet());
+    spriteCache->Define(SpriteSheet::FLOWERS_FARM, FlowerPatch::GetSpriteSheet(true));
+    spriteCache->Define(SpriteSheet::FLOWERS_GARDEN, FlowerPatch::GetSpriteSheet(false));
+    
+    // World chunks are baked into textures as they stream in
+    result.world_renderer = std::make_unique<WorldRenderer>();
+    result.world_renderer->Initialize(result.renderer.get());
+    
+    // Day/night overlay, covering the window wherever the camera goes
+    result.light_map = std::make_unique<LightMap>();
+    result.light_map->Initialize(window_width, window_height);
+    
+    // Retained draw list: world, entities, then UI replayed while unchanged
+    result.draw_list = std::make_unique<DrawList>();
+    result.draw_list->SetLayerCached(DrawLayer::UI, true, true);
+    
     // Initialize input manager
     result.input_manager = std::make_unique<InputManager>();
     
     // Initialize game systems
     result.farming_system = std::make_unique<FarmingSystem>(6, 4);
-    result.pottery_system = std::make_unique<PotterySystem>();
+    result.pottery_system = std::make_unique<PotterySystem>(options.seed);
+    result.lighting_system = std::make_unique<LightingSystem>(options.startHour);
     
     // Initialize player
     result.player = std::make_unique<Player>();
@@ -73,71 +261,82 @@ GameInit::InitResult GameInit::InitializeGameSystems(SDL_Window* window, int win
     result.dialogue_system = std::make_unique<DialogueSystem>();
     result.dialogue_system->Initialize();
     
-    // Initialize NPC manager and create NPCs
-    result.npc_manager = std::make_unique<NPCManager>();
-    
-    const int TILE_SIZE = 128;
-    
-    // Create breeder NPC (bottom left grass area)
-    std::vector<std::string> breederDialogue = {
-        "Hello there, traveler!",
-        "I'm the village breeder.",
-        "I take care of the animals around here.",
-    };
-    result.npc_manager->AddNPC("breeder", 1 * TILE_SIZE + 32, 6 * TILE_SIZE + 32, breederDialogue);
-    
-    // Create fisher NPC (top part near water)
-    std::vector<std::string> fisherDialogue = {
-        "Good day, friend!",
-        "The fish are biting well today.",
-        "Would you like to learn about fishing?",
-    };
-    result.npc_manager->AddNPC("fisher", 4 * TILE_SIZE + 32, 1 * TILE_SIZE + 32, fisherDialogue);
-    
-    // Register all NPCs with dialogue system
-    result.npc_manager->RegisterAllWithDialogue(result.dialogue_system.get());
-    
-    // Initialize dynamic object manager and create dynamic objects
-    result.dynamic_object_manager = std::make_unique<DynamicObjectManager>();
-    
-    // Create a dog that patrols in the garden area
-    auto dog = std::make_unique<Dog>(4 * TILE_SIZE, 6 * TILE_SIZE + 50, 300.0f);
-    result.dynamic_object_manager->AddObject(std::move(dog));
-    
-    // Create flower patches in the garden area
-    std::vector<std::string> gardenFlowerDialogue = {
-        "Beautiful flowers bloom here in vibrant colors.",
-        "The sweet fragrance fills the air.",
-        "These flowers attract butterflies and bees."
-    };
-    auto gardenFlowers1 = std::make_unique<FlowerPatch>(4 * TILE_SIZE + 40, 5 * TILE_SIZE + 40, gardenFlowerDialogue, "garden");
-    auto gardenFlowers2 = std::make_unique<FlowerPatch>(6 * TILE_SIZE + 40, 6 * TILE_SIZE + 40, gardenFlowerDialogue, "garden");
-    result.dynamic_object_manager->AddObject(std::move(gardenFlowers1));
-    result.dynamic_object_manager->AddObject(std::move(gardenFlowers2));
-    
-    // Create flower patches in the farm area (where we rendered flowers)
-    std::vector<std::string> farmFlowerDialogue1 = {
-        "These lovely flowers brighten up the farm area.",
-        "Pink, yellow, and coral blooms dance in the breeze.",
-        "The flowers seem well-tended and healthy."
-    };
-    std::vector<std::string> farmFlowerDialogue2 = {
-        "A colorful patch of flowers adds beauty to this corner.",
-        "The farmer must have a soft spot for flowers.",
-        "These blooms provide a nice contrast to the crops."
-    };
-    auto farmFlowers1 = std::make_unique<FlowerPatch>(6 * TILE_SIZE + 35, 2 * TILE_SIZE + 35, farmFlowerDialogue1, "farm");
-    auto farmFlowers2 = std::make_unique<FlowerPatch>(8 * TILE_SIZE + 35, 4 * TILE_SIZE + 35, farmFlowerDialogue2, "farm");
-    result.dynamic_object_manager->AddObject(std::move(farmFlowers1));
-    result.dynamic_object_manager->AddObject(std::move(farmFlowers2));
-    
-    // Set up collision callback for NPCs and dynamic objects
-    result.player->SetCollisionCallback([npcManager = result.npc_manager.get(), 
-                                        dynamicObjManager = result.dynamic_object_manager.get()]
+    // NPCs, dogs and flower patches are spawned by the world as their chunks stream in
+    result.entity_store = std::make_unique<EntityStore>();
+    result.entity_store->DefineStyle(SpriteSheet::NPC, NPC::GetRenderStyle());
+    result.entity_store->DefineStyle(SpriteSheet::DOG, Dog::GetRenderStyle());
+    result.entity_store->DefineStyle(SpriteSheet::FLOWERS_FARM, FlowerPatch::GetRenderStyle());
+    result.entity_store->DefineStyle(SpriteSheet::FLOWERS_GARDEN, FlowerPatch::GetRenderStyle());
+    result.entity_store->DefineArchetype(Archetype::NPC, NPC::GetArchetypeInfo());
+    result.entity_store->DefineArchetype(Archetype::DOG, Dog::GetArchetypeInfo());
+    result.entity_store->DefineArchetype(Archetype::FLOWER_PATCH, FlowerPatch::GetArchetypeInfo());
+    result.dialogue_system->SetEntityStore(result.entity_store.get());
+    result.world_entity_spawner = std::make_unique<WorldEntitySpawner>(
+        result.entity_store.get(), result.lighting_system.get());
+    
+    // The starting farm, compiled from assets/worlds/farm.world by the cook_assets target
+    auto worldFile = std::make_unique<WorldFile>();
+    if (!worldFile->Load(AssetPath("assets/cooked/worlds/farm.ywld"))) {
+        std::cerr << "Failed to load world file!" << std::endl;
+        return {};
+    }
+    
+    for (size_t i = 0; i < worldFile->GetZoneCount(); ++i) {
+        const WorldFormat::ZoneRecord& zone = worldFile->GetZone(i);
+        result.dialogue_system->AddInteractionZone(InteractionZone(
+            Rect(zone.bounds.x, zone.bounds.y, zone.bounds.w, zone.bounds.h),
+            static_cast<InteractableType>(zone.type),
+            worldFile->GetLines(zone.firstLine, zone.lineCount)));
+    }
+    
+    // Initialize the chunked world, streamed out of the mapped file
+    result.world = std::make_unique<World>();
+    if (!result.world->Initialize(std::make_unique<WorldFileChunkSource>(std::move(worldFile)))) {
+        std::cerr << "Failed to initialize world!" << std::endl;
+        return {};
+    }
+    
+    // Static geometry follows the resident chunks; entities are the moving bodies
+    result.collision_world = std::make_unique<CollisionWorld>();
+    result.collision_world->Initialize(result.world->GetWidthTiles(), result.world->GetHeightTiles());
+    result.collision_world->SetEntityStore(result.entity_store.get());
+    
+    result.world->SetChunkCallbacks(
+        [spawner = result.world_entity_spawner.get(), collision = result.collision_world.get()]
+        (const WorldChunkData& chunk) {
+            collision->OnChunkLoaded(chunk);
+            spawner->OnChunkLoaded(chunk);
+        },
+        [spawner = result.world_entity_spawner.get(), collision = result.collision_world.get()]
+        (const WorldChunkData& chunk) {
+            spawner->OnChunkUnloaded(chunk);
+            collision->OnChunkUnloaded(chunk);
+        });
+    
+    result.camera->SetWorldSize(result.world->GetWidthPixels(), result.world->GetHeightPixels());
+    result.player->SetWorldSize(result.world->GetWidthPixels(), result.world->GetHeightPixels());
+    
+    // Stream in the chunks around the start position before the first frame
+    result.camera->SnapToTarget();
+    result.world->Update(result.camera->GetOffset(), window_width, window_height, 0.0f);
+    
+    // Simulation systems split their per-entity and per-tile work across these;
+    // the main thread draws and the simulation thread joins in, so leave them a core each
+    int workers = options.workerCount;
+    if (workers < 0) {
+        workers = static_cast<int>(std::thread::hardware_concurrency()) - 2;
+        workers = std::max(0, std::min(workers, MAX_JOB_WORKERS));
+    }
+    result.job_system = std::make_unique<JobSystem>();
+    result.job_system->Initialize(workers);
+    
+    // The player collides with the same world as everything else
+    result.player->SetCollisionCallback([collision = result.collision_world.get(),
+                                        playerWidth = result.player->GetWidth(),
+                                        playerHeight = result.player->GetHeight()]
                                        (const Vector2& position) {
-        bool npcCollision = npcManager ? npcManager->CheckCollisionWithAny(position) : false;
-        bool dynamicCollision = dynamicObjManager ? dynamicObjManager->CheckCollisionWithAny(position) : false;
-        return npcCollision || dynamicCollision;
+        Rect playerRect(static_cast<int>(position.x), static_cast<int>(position.y), playerWidth, playerHeight);
+        return collision->IsBlocked(playerRect);
     });
     
     return result;
@@ -0,0 +1,197 @@
+#include "JobSystem.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+// Which queue the running thread owns; anything that isn't a worker uses queue 0
+thread_local const JobSystem* currentSystem = nullptr;
+thread_local int currentQueue = 0;
+
+} // namespace
+
+size_t JobGraph::Add(Job job, const std::vector<size_t>& dependencies) {
+    size_t index = nodes_.size();
+    Node node;
+    node.job = std::move(job);
+    for (size_t dependency : dependencies) {
+        if (dependency >= index) {
+            std::cerr << "Job " << index << " can't depend on job " << dependency
+                      << ", which isn't added yet" << std::endl;
+            continue;
+        }
+        nodes_[dependency].dependents.push_back(index);
+        node.dependencyCount++;
+    }
+    nodes_.push_back(std::move(node));
+    return index;
+}
+
+JobSystem::JobSystem() : queued_(0), stopping_(false) {
+}
+
+JobSystem::~JobSystem() {
+    Shutdown();
+}
+
+void JobSystem::Initialize(int workerCount) {
+    stopping_ = false;
+    queues_.clear();
+    for (int i = 0; i <= workerCount; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+    for (int i = 1; i <= workerCount; ++i) {
+        workers_.emplace_back(&JobSystem::WorkerLoop, this, i);
+    }
+}
+
+void JobSystem::Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stopping_ = true;
+    }
+    workReady_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+}
+
+void JobSystem::ParallelFor(size_t count, size_t grainSize,
+                            const std::function<void(size_t begin, size_t end)>& range) {
+    if (count == 0) return;
+    if (grainSize == 0) grainSize = 1;
+    size_t pieces = (count + grainSize - 1) / grainSize;
+
+    if (workers_.empty() || pieces == 1) {
+        for (size_t begin = 0; begin < count; begin += grainSize) {
+            range(begin, std::min(begin + grainSize, count));
+        }
+        return;
+    }
+
+    // Hand out all but the first piece, which this thread runs straight away
+    std::atomic<int> remaining(static_cast<int>(pieces - 1));
+    for (size_t begin = grainSize; begin < count; begin += grainSize) {
+        size_t end = std::min(begin + grainSize, count);
+        Task task;
+        task.run = [&range, begin, end] { range(begin, end); };
+        task.remaining = &remaining;
+        Push(std::move(task));
+    }
+    range(0, grainSize);
+    WaitFor(remaining);
+}
+
+void JobSystem::Run(JobGraph& graph) {
+    size_t count = graph.nodes_.size();
+    if (count == 0) return;
+
+    // Dependencies always come first, so index order is a valid order
+    if (workers_.empty()) {
+        for (JobGraph::Node& node : graph.nodes_) {
+            node.job();
+        }
+        return;
+    }
+
+    graph.waiting_.reset(new std::atomic<int>[count]);
+    for (size_t i = 0; i < count; ++i) {
+        graph.waiting_[i] = graph.nodes_[i].dependencyCount;
+    }
+
+    std::atomic<int> remaining(static_cast<int>(count));
+    for (size_t i = 0; i < count; ++i) {
+        if (graph.nodes_[i].dependencyCount == 0) {
+            StartNode(graph, i, &remaining);
+        }
+    }
+    WaitFor(remaining);
+}
+
+void JobSystem::StartNode(JobGraph& graph, size_t index, std::atomic<int>* remaining) {
+    Task task;
+    task.run = [this, &graph, index, remaining] {
+        graph.nodes_[index].job();
+        for (size_t dependent : graph.nodes_[index].dependents) {
+            if (graph.waiting_[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                StartNode(graph, dependent, remaining);
+            }
+        }
+    };
+    task.remaining = remaining;
+    Push(std::move(task));
+}
+
+int JobSystem::CurrentQueue() const {
+    return currentSystem == this ? currentQueue : 0;
+}
+
+void JobSystem::Push(Task&& task) {
+    {
+        Queue& queue = *queues_[CurrentQueue()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    queued_.fetch_add(1, std::memory_order_release);
+
+    // Taking the lock orders this with a worker about to sleep, so the wakeup isn't lost
+    { std::lock_guard<std::mutex> lock(sleepMutex_); }
+    workReady_.notify_one();
+}
+
+bool JobSystem::TryPop(Task& task) {
+    // Newest of our own first (still warm in cache), then the oldest of anyone else's
+    int own = CurrentQueue();
+    int queueCount = static_cast<int>(queues_.size());
+    for (int i = 0; i < queueCount; ++i) {
+        Queue& queue = *queues_[(own + i) % queueCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) continue;
+
+        if (i == 0) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::Execute(Task& task) {
+    task.run();
+    task.remaining->fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void JobSystem::WaitFor(const std::atomic<int>& remaining) {
+    while (remaining.load(std::memory_order_acquire) > 0) {
+        Task task;
+        if (TryPop(task)) {
+            Execute(task);
+        } else {
+            // Whatever is left is running on other threads
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::WorkerLoop(int queue) {
+    currentSystem = this;
+    currentQueue = queue;
+
+    while (true) {
+        Task task;
+        if (TryPop(task)) {
+            Execute(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        workReady_.wait(lock, [this] { return stopping_ || queued_.load(std::memory_order_acquire) > 0; });
+        if (stopping_) return;
+    }
+}
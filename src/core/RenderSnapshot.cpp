@@ -0,0 +1,77 @@
+#include "RenderSnapshot.h"
+#include "World.h"
+#include <algorithm>
+
+WorldSnapshot::WorldSnapshot()
+    : widthTiles_(0), heightTiles_(0), widthChunks_(0), heightChunks_(0) {
+}
+
+void WorldSnapshot::Capture(const World& world) {
+    widthTiles_ = world.GetWidthTiles();
+    heightTiles_ = world.GetHeightTiles();
+    widthChunks_ = world.GetWidthChunks();
+    heightChunks_ = world.GetHeightChunks();
+    prefetchBounds_ = world.GetPrefetchBounds();
+
+    // Only the previously resident entries need clearing
+    size_t mapChunks = static_cast<size_t>(widthChunks_) * heightChunks_;
+    if (chunkIndex_.size() != mapChunks) {
+        chunkIndex_.assign(mapChunks, -1);
+    } else {
+        for (const Chunk& chunk : chunks_) {
+            chunkIndex_[chunk.chunkY * widthChunks_ + chunk.chunkX] = -1;
+        }
+    }
+    chunks_.clear();
+
+    world.ForEachResidentChunk([this](const WorldChunkData& data) {
+        chunkIndex_[data.chunkY * widthChunks_ + data.chunkX] = static_cast<int>(chunks_.size());
+        chunks_.emplace_back();
+        Chunk& chunk = chunks_.back();
+        chunk.chunkX = data.chunkX;
+        chunk.chunkY = data.chunkY;
+        chunk.loadSerial = data.loadSerial;
+        std::copy(std::begin(data.tiles), std::end(data.tiles), chunk.tiles);
+    });
+}
+
+const WorldSnapshot::Chunk* WorldSnapshot::GetChunk(int chunkX, int chunkY) const {
+    if (chunkX < 0 || chunkY < 0 || chunkX >= widthChunks_ || chunkY >= heightChunks_) {
+        return nullptr;
+    }
+
+    int index = chunkIndex_[chunkY * widthChunks_ + chunkX];
+    return index >= 0 ? &chunks_[index] : nullptr;
+}
+
+const Tile* WorldSnapshot::GetTile(int tileX, int tileY) const {
+    if (tileX < 0 || tileY < 0 || tileX >= widthTiles_ || tileY >= heightTiles_) {
+        return nullptr;
+    }
+
+    const int TILES = WorldChunkData::TILES;
+    const Chunk* chunk = GetChunk(tileX / TILES, tileY / TILES);
+    if (!chunk) return nullptr;
+
+    return &chunk->tiles[(tileY % TILES) * TILES + tileX % TILES];
+}
+
+RenderSnapshotBuffer::RenderSnapshotBuffer()
+    : write_(0), ready_(1), read_(2), fresh_(false), published_(false) {
+}
+
+void RenderSnapshotBuffer::Publish() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::swap(write_, ready_);
+    fresh_ = true;
+    published_ = true;
+}
+
+const RenderSnapshot* RenderSnapshotBuffer::AcquireLatest() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fresh_) {
+        std::swap(read_, ready_);
+        fresh_ = false;
+    }
+    return published_ ? &slots_[read_] : nullptr;
+}
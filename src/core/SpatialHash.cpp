@@ -0,0 +1,28 @@
+#include "SpatialHash.h"
+#include <algorithm>
+
+SpatialHash::SpatialHash() : buckets_(BUCKET_COUNT) {
+}
+
+void SpatialHash::Insert(Uint32 bucket, Uint32 index) {
+    buckets_[bucket].push_back(index);
+}
+
+void SpatialHash::Remove(Uint32 bucket, Uint32 index) {
+    std::vector<Uint32>& entries = buckets_[bucket];
+    auto it = std::find(entries.begin(), entries.end(), index);
+    if (it == entries.end()) return;
+    *it = entries.back();
+    entries.pop_back();
+}
+
+void SpatialHash::Renumber(Uint32 bucket, Uint32 oldIndex, Uint32 newIndex) {
+    std::vector<Uint32>& entries = buckets_[bucket];
+    std::replace(entries.begin(), entries.end(), oldIndex, newIndex);
+}
+
+void SpatialHash::Clear() {
+    for (std::vector<Uint32>& entries : buckets_) {
+        entries.clear();
+    }
+}
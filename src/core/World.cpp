@@ -0,0 +1,184 @@
+#include "World.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+World::World()
+    : widthTiles_(0), heightTiles_(0), widthChunks_(0), heightChunks_(0), nextLoadSerial_(1),
+      hasLastCamera_(false) {
+}
+
+World::~World() {
+    Shutdown();
+}
+
+bool World::Initialize(std::unique_ptr<ChunkSource> source) {
+    if (!source) {
+        std::cerr << "World::Initialize Error: no chunk source" << std::endl;
+        return false;
+    }
+
+    source_ = std::move(source);
+    widthTiles_ = source_->GetWidthTiles();
+    heightTiles_ = source_->GetHeightTiles();
+    widthChunks_ = (widthTiles_ + WorldChunkData::TILES - 1) / WorldChunkData::TILES;
+    heightChunks_ = (heightTiles_ + WorldChunkData::TILES - 1) / WorldChunkData::TILES;
+    hasLastCamera_ = false;
+    return true;
+}
+
+void World::Shutdown() {
+    while (!chunks_.empty()) {
+        UnloadChunk(chunks_.begin());
+    }
+    chunkPool_.clear();
+    source_.reset();
+}
+
+void World::SetChunkCallbacks(ChunkCallback onLoaded, ChunkCallback onUnloaded) {
+    onChunkLoaded_ = onLoaded;
+    onChunkUnloaded_ = onUnloaded;
+}
+
+void World::Update(const Vector2& cameraOffset, int viewWidth, int viewHeight, float deltaTime) {
+    if (!source_) return;
+
+    Rect view(static_cast<int>(cameraOffset.x), static_cast<int>(cameraOffset.y), viewWidth, viewHeight);
+
+    // Stretch the view in the direction the camera is moving
+    Vector2 lead(0.0f, 0.0f);
+    if (hasLastCamera_ && deltaTime > 0.0f) {
+        lead.x = (cameraOffset.x - lastCameraOffset_.x) / deltaTime * PREFETCH_SECONDS;
+        lead.y = (cameraOffset.y - lastCameraOffset_.y) / deltaTime * PREFETCH_SECONDS;
+    }
+    lastCameraOffset_ = cameraOffset;
+    hasLastCamera_ = true;
+
+    Rect prefetch = view;
+    int leadX = static_cast<int>(lead.x);
+    int leadY = static_cast<int>(lead.y);
+    if (leadX < 0) prefetch.x += leadX;
+    if (leadY < 0) prefetch.y += leadY;
+    prefetch.w += std::abs(leadX);
+    prefetch.h += std::abs(leadY);
+    prefetchBounds_ = prefetch;
+
+    ChunkRange viewRange = RangeForBounds(view, LOAD_MARGIN_CHUNKS);
+    ChunkRange prefetchRange = RangeForBounds(prefetch, LOAD_MARGIN_CHUNKS);
+    ChunkRange keepRange = RangeForBounds(prefetch, UNLOAD_MARGIN_CHUNKS);
+
+    // Drop chunks that fell well behind the camera. Their entities leave the
+    // store in this order, so it is sorted rather than left to the hash map's
+    // layout, or replays would depend on the standard library they run on.
+    unloadKeys_.clear();
+    for (const auto& pair : chunks_) {
+        const WorldChunkData& chunk = *pair.second;
+        if (!keepRange.Contains(chunk.chunkX, chunk.chunkY)) {
+            unloadKeys_.push_back(pair.first);
+        }
+    }
+    std::sort(unloadKeys_.begin(), unloadKeys_.end());
+    for (int key : unloadKeys_) {
+        UnloadChunk(chunks_.find(key));
+    }
+
+    // Everything around the current view must be resident this frame
+    for (int chunkY = viewRange.minY; chunkY <= viewRange.maxY; chunkY++) {
+        for (int chunkX = viewRange.minX; chunkX <= viewRange.maxX; chunkX++) {
+            if (chunks_.find(ChunkKey(chunkX, chunkY)) == chunks_.end()) {
+                LoadChunk(chunkX, chunkY);
+            }
+        }
+    }
+
+    // Chunks the camera is heading towards trickle in a few per frame
+    int prefetchLoads = 0;
+    for (int chunkY = prefetchRange.minY; chunkY <= prefetchRange.maxY && prefetchLoads < MAX_PREFETCH_LOADS; chunkY++) {
+        for (int chunkX = prefetchRange.minX; chunkX <= prefetchRange.maxX && prefetchLoads < MAX_PREFETCH_LOADS; chunkX++) {
+            if (chunks_.find(ChunkKey(chunkX, chunkY)) == chunks_.end()) {
+                LoadChunk(chunkX, chunkY);
+                prefetchLoads++;
+            }
+        }
+    }
+}
+
+const WorldChunkData* World::GetChunk(int chunkX, int chunkY) const {
+    if (chunkX < 0 || chunkY < 0 || chunkX >= widthChunks_ || chunkY >= heightChunks_) {
+        return nullptr;
+    }
+
+    auto it = chunks_.find(ChunkKey(chunkX, chunkY));
+    return it != chunks_.end() ? it->second.get() : nullptr;
+}
+
+void World::ForEachResidentChunk(const ChunkCallback& visit) const {
+    for (const auto& pair : chunks_) {
+        visit(*pair.second);
+    }
+}
+
+const Tile* World::GetTile(int tileX, int tileY) const {
+    if (tileX < 0 || tileY < 0 || tileX >= widthTiles_ || tileY >= heightTiles_) {
+        return nullptr;
+    }
+
+    const WorldChunkData* chunk = GetChunk(tileX / WorldChunkData::TILES, tileY / WorldChunkData::TILES);
+    if (!chunk) return nullptr;
+
+    return &chunk->At(tileX % WorldChunkData::TILES, tileY % WorldChunkData::TILES);
+}
+
+World::ChunkRange World::RangeForBounds(const Rect& bounds, int marginChunks) const {
+    const int CHUNK_SIZE = WorldChunkData::CHUNK_SIZE;
+
+    ChunkRange range;
+    range.minX = static_cast<int>(std::floor(static_cast<float>(bounds.x) / CHUNK_SIZE)) - marginChunks;
+    range.minY = static_cast<int>(std::floor(static_cast<float>(bounds.y) / CHUNK_SIZE)) - marginChunks;
+    range.maxX = static_cast<int>(std::floor(static_cast<float>(bounds.x + bounds.w - 1) / CHUNK_SIZE)) + marginChunks;
+    range.maxY = static_cast<int>(std::floor(static_cast<float>(bounds.y + bounds.h - 1) / CHUNK_SIZE)) + marginChunks;
+
+    range.minX = std::max(range.minX, 0);
+    range.minY = std::max(range.minY, 0);
+    range.maxX = std::min(range.maxX, widthChunks_ - 1);
+    range.maxY = std::min(range.maxY, heightChunks_ - 1);
+    return range;
+}
+
+bool World::LoadChunk(int chunkX, int chunkY) {
+    std::unique_ptr<WorldChunkData> chunk;
+    if (!chunkPool_.empty()) {
+        chunk = std::move(chunkPool_.back());
+        chunkPool_.pop_back();
+        chunk->Reset();
+    } else {
+        chunk = std::make_unique<WorldChunkData>();
+    }
+
+    chunk->chunkX = chunkX;
+    chunk->chunkY = chunkY;
+    chunk->loadSerial = nextLoadSerial_++;
+
+    if (!source_->LoadChunk(chunkX, chunkY, chunk.get())) {
+        std::cerr << "Warning: Failed to load world chunk " << chunkX << "," << chunkY << std::endl;
+        chunkPool_.push_back(std::move(chunk));
+        return false;
+    }
+
+    const WorldChunkData& loaded = *chunk;
+    chunks_[ChunkKey(chunkX, chunkY)] = std::move(chunk);
+
+    if (onChunkLoaded_) {
+        onChunkLoaded_(loaded);
+    }
+    return true;
+}
+
+void World::UnloadChunk(std::unordered_map<int, std::unique_ptr<WorldChunkData>>::iterator it) {
+    if (onChunkUnloaded_) {
+        onChunkUnloaded_(*it->second);
+    }
+
+    chunkPool_.push_back(std::move(it->second));
+    chunks_.erase(it);
+}
@@ -0,0 +1,78 @@
+#include "WorldEntitySpawner.h"
+#include "NPC.h"
+#include "Dog.h"
+#include "FlowerPatch.h"
+#include "LightingSystem.h"
+
+namespace {
+
+// Warm light from house windows (the window sits around the middle of the wall tile)
+const int WINDOW_LIGHT_X = 62;
+const int WINDOW_LIGHT_Y = 57;
+const int WINDOW_LIGHT_RADIUS = 200;
+const SDL_Color WINDOW_LIGHT_COLOR = {255, 200, 120, 220};
+
+const int LANTERN_RADIUS = 240;
+const SDL_Color LANTERN_COLOR = {255, 170, 80, 255};
+
+} // namespace
+
+WorldEntitySpawner::WorldEntitySpawner(EntityStore* entityStore, LightingSystem* lightingSystem)
+    : entityStore_(entityStore), lightingSystem_(lightingSystem) {
+}
+
+void WorldEntitySpawner::OnChunkLoaded(const WorldChunkData& chunk) {
+    ChunkEntities entities;
+
+    // Every house wall without a door has a window
+    for (int y = 0; y < WorldChunkData::TILES; ++y) {
+        for (int x = 0; x < WorldChunkData::TILES; ++x) {
+            const Tile& tile = chunk.At(x, y);
+            if (tile.overlay != TileOverlay::HOUSE_WALL || (tile.flags & TILE_DOOR)) continue;
+
+            int tileX = chunk.chunkX * WorldChunkData::CHUNK_SIZE + x * WorldChunkData::TILE_SIZE;
+            int tileY = chunk.chunkY * WorldChunkData::CHUNK_SIZE + y * WorldChunkData::TILE_SIZE;
+            entities.lights.push_back(lightingSystem_->AddLight(tileX + WINDOW_LIGHT_X, tileY + WINDOW_LIGHT_Y,
+                                                                WINDOW_LIGHT_RADIUS, WINDOW_LIGHT_COLOR));
+        }
+    }
+
+    for (const auto& spawn : chunk.spawns) {
+        switch (spawn.kind) {
+            case EntityKind::NPC:
+                entities.entities.push_back(NPC::Spawn(*entityStore_, spawn.position.x, spawn.position.y, spawn.dialogue));
+                break;
+            case EntityKind::DOG:
+                entities.entities.push_back(Dog::Spawn(*entityStore_, spawn.position.x, spawn.position.y, spawn.patrolWidth));
+                break;
+            case EntityKind::FLOWER_PATCH:
+                entities.entities.push_back(FlowerPatch::Spawn(*entityStore_, spawn.position.x, spawn.position.y,
+                                                               spawn.dialogue, spawn.name));
+                break;
+            case EntityKind::LANTERN:
+                entities.lights.push_back(lightingSystem_->AddLight(static_cast<int>(spawn.position.x),
+                                                                    static_cast<int>(spawn.position.y),
+                                                                    LANTERN_RADIUS, LANTERN_COLOR));
+                break;
+        }
+    }
+
+    if (!entities.entities.empty() || !entities.lights.empty()) {
+        spawned_[chunk.loadSerial] = std::move(entities);
+    }
+}
+
+void WorldEntitySpawner::OnChunkUnloaded(const WorldChunkData& chunk) {
+    auto it = spawned_.find(chunk.loadSerial);
+    if (it == spawned_.end()) return;
+
+    // The dialogue system lets go of anything it was talking to on its next update
+    for (EntityId entity : it->second.entities) {
+        entityStore_->Destroy(entity);
+    }
+    for (Uint32 light : it->second.lights) {
+        lightingSystem_->RemoveLight(light);
+    }
+
+    spawned_.erase(it);
+}
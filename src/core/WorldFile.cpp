@@ -0,0 +1,156 @@
+#include "WorldFile.h"
+#include <cstring>
+#include <iostream>
+
+using namespace WorldFormat;
+
+WorldFile::WorldFile()
+    : header_(nullptr) {
+}
+
+bool WorldFile::Load(const std::string& path) {
+    header_ = nullptr;
+    path_ = path;
+    if (!file_.Open(path)) {
+        return false;
+    }
+
+    if (file_.GetSize() < sizeof(Header)) {
+        std::cerr << "World file " << path << " is truncated" << std::endl;
+        return false;
+    }
+
+    const Header* header = reinterpret_cast<const Header*>(file_.GetData());
+    if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION) {
+        std::cerr << "World file " << path << " has the wrong magic or version, recompile it" << std::endl;
+        return false;
+    }
+    if (header->tileSize != WorldChunkData::TILE_SIZE || header->chunkTiles != WorldChunkData::TILES) {
+        std::cerr << "World file " << path << " was compiled for a different tile or chunk size" << std::endl;
+        return false;
+    }
+    header_ = header;
+
+    uint32_t chunkTiles = header->chunkTiles;
+    uint32_t widthChunks = (header->widthTiles + chunkTiles - 1) / chunkTiles;
+    uint32_t heightChunks = (header->heightTiles + chunkTiles - 1) / chunkTiles;
+
+    bool ok = CheckSection(header->tiles, sizeof(TileRecord), "tiles") &&
+              CheckSection(header->colliders, sizeof(RectRecord), "colliders") &&
+              CheckSection(header->zones, sizeof(ZoneRecord), "zones") &&
+              CheckSection(header->spawns, sizeof(SpawnRecord), "spawns") &&
+              CheckSection(header->chunks, sizeof(ChunkRecord), "chunks") &&
+              CheckSection(header->chunkColliders, sizeof(uint32_t), "chunk colliders") &&
+              CheckSection(header->lines, sizeof(uint32_t), "lines") &&
+              CheckSection(header->strings, sizeof(char), "strings");
+
+    if (ok && (static_cast<uint64_t>(header->widthTiles) * header->heightTiles != header->tiles.count ||
+               static_cast<uint64_t>(widthChunks) * heightChunks != header->chunks.count)) {
+        std::cerr << "World file " << path << " has mismatched tile or chunk counts" << std::endl;
+        ok = false;
+    }
+
+    // Strings are read in place, make sure the last one is terminated
+    if (ok && (header->strings.count == 0 || Records<char>(header->strings)[header->strings.count - 1] != '\0')) {
+        std::cerr << "World file " << path << " has an unterminated string table" << std::endl;
+        ok = false;
+    }
+
+    if (!ok) {
+        header_ = nullptr;
+        file_.Close();
+    }
+    return ok;
+}
+
+bool WorldFile::CheckSection(const Section& section, size_t recordSize, const char* name) const {
+    uint64_t end = static_cast<uint64_t>(section.offset) + static_cast<uint64_t>(section.count) * recordSize;
+    if (section.offset % 4 != 0 || end > file_.GetSize()) {
+        std::cerr << "World file " << path_ << " has a bad " << name << " section" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int WorldFile::GetWidthChunks() const {
+    return static_cast<int>((header_->widthTiles + header_->chunkTiles - 1) / header_->chunkTiles);
+}
+
+const TileRecord& WorldFile::GetTile(int tileX, int tileY) const {
+    return Records<TileRecord>(header_->tiles)[tileY * header_->widthTiles + tileX];
+}
+
+const ChunkRecord& WorldFile::GetChunk(int chunkX, int chunkY) const {
+    return Records<ChunkRecord>(header_->chunks)[chunkY * GetWidthChunks() + chunkX];
+}
+
+const char* WorldFile::GetString(uint32_t offset) const {
+    if (offset >= header_->strings.count) return "";
+    return Records<char>(header_->strings) + offset;
+}
+
+std::vector<std::string> WorldFile::GetLines(uint32_t firstLine, uint32_t lineCount) const {
+    std::vector<std::string> lines;
+    if (static_cast<uint64_t>(firstLine) + lineCount > header_->lines.count) return lines;
+
+    const uint32_t* offsets = Records<uint32_t>(header_->lines);
+    lines.reserve(lineCount);
+    for (uint32_t i = 0; i < lineCount; ++i) {
+        lines.push_back(GetString(offsets[firstLine + i]));
+    }
+    return lines;
+}
+
+WorldFileChunkSource::WorldFileChunkSource(std::unique_ptr<WorldFile> file)
+    : file_(std::move(file)) {
+}
+
+bool WorldFileChunkSource::LoadChunk(int chunkX, int chunkY, WorldChunkData* chunk) {
+    const int TILES = WorldChunkData::TILES;
+    int widthTiles = file_->GetWidthTiles();
+    int heightTiles = file_->GetHeightTiles();
+
+    for (int localY = 0; localY < TILES; localY++) {
+        int y = chunkY * TILES + localY;
+        if (y >= heightTiles) break;
+
+        for (int localX = 0; localX < TILES; localX++) {
+            int x = chunkX * TILES + localX;
+            if (x >= widthTiles) break;
+
+            const TileRecord& record = file_->GetTile(x, y);
+            Tile& tile = chunk->At(localX, localY);
+            tile.ground = static_cast<TileGround>(record.ground);
+            tile.overlay = static_cast<TileOverlay>(record.overlay);
+            tile.flags = record.flags;
+        }
+    }
+
+    const ChunkRecord& record = file_->GetChunk(chunkX, chunkY);
+    if (static_cast<uint64_t>(record.firstCollider) + record.colliderCount > file_->GetChunkColliderCount() ||
+        static_cast<uint64_t>(record.firstSpawn) + record.spawnCount > file_->GetSpawnCount()) {
+        return false;
+    }
+
+    const uint32_t* colliderIndices = file_->GetChunkColliders() + record.firstCollider;
+    for (uint32_t i = 0; i < record.colliderCount; ++i) {
+        if (colliderIndices[i] >= file_->GetColliderCount()) return false;
+
+        const RectRecord& collider = file_->GetColliders()[colliderIndices[i]];
+        chunk->colliders.push_back(Rect(collider.x, collider.y, collider.w, collider.h));
+    }
+
+    const SpawnRecord* spawns = file_->GetSpawns() + record.firstSpawn;
+    for (uint32_t i = 0; i < record.spawnCount; ++i) {
+        const SpawnRecord& spawnRecord = spawns[i];
+        EntitySpawn spawn;
+        spawn.kind = static_cast<EntityKind>(spawnRecord.kind);
+        spawn.name = file_->GetString(spawnRecord.name);
+        spawn.position = Vector2(spawnRecord.x, spawnRecord.y);
+        spawn.patrolWidth = spawnRecord.patrolWidth;
+        spawn.dialogue = file_->GetLines(spawnRecord.firstLine, spawnRecord.lineCount);
+        chunk->spawns.push_back(spawn);
+    }
+
+    return true;
+}
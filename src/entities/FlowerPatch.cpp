@@ -1,41 +1,64 @@
 #include "FlowerPatch.h"
 #include "Renderer.h"
+#include "SpriteCache.h"
 #include <cmath>
 
-FlowerPatch::FlowerPatch(float x, float y, const std::vector<std::string>& dialogue, 
-                        const std::string& patchType)
-    : InteractableObject(x, y, InteractableType::GARDEN_FLOWER, dialogue, true),
-      patchType_(patchType), animationTimer_(0.0f) {
-    
-    // Set smaller interaction radius for flower patches
-    interactionRadius_ = 25.0f;
+EntityId FlowerPatch::Spawn(EntityStore& store, float x, float y, const std::vector<std::string>& dialogue,
+                            const std::string& patchType) {
+    EntityDesc desc;
+    desc.archetype = Archetype::FLOWER_PATCH;
+    desc.sheet = (patchType == "farm") ? SpriteSheet::FLOWERS_FARM : SpriteSheet::FLOWERS_GARDEN;
+    desc.x = x;
+    desc.y = y;
+    desc.interactionRadius = INTERACTION_RADIUS;
+    return store.Create(desc, dialogue);
 }
 
-void FlowerPatch::Update(float deltaTime) {
-    InteractableObject::Update(deltaTime);
-    
-    // Update animation timer for gentle swaying effect
-    animationTimer_ += deltaTime;
-    if (animationTimer_ > 10.0f) {
-        animationTimer_ = 0.0f;
-    }
+RenderStyle FlowerPatch::GetRenderStyle() {
+    RenderStyle style;
+    style.frames = FLOWER_FRAMES;
+    style.loopSeconds = ANIMATION_LOOP;
+    style.bounds = Rect(-2, 0, PATCH_WIDTH + 4, PATCH_HEIGHT + 4); // Swaying flowers drift a pixel or two outside the patch
+    style.collisionWidth = 24;
+    style.collisionHeight = 16;
+    return style;
+}
+
+ArchetypeInfo FlowerPatch::GetArchetypeInfo() {
+    ArchetypeInfo info;
+    info.interaction = InteractableType::GARDEN_FLOWER;
+    return info;
+}
+
+SpriteSheetDesc FlowerPatch::GetSpriteSheet(bool farm) {
+    // Cell matches the render style bounds, swaying flowers drift a little outside the patch
+    SpriteSheetDesc desc;
+    desc.cellWidth = PATCH_WIDTH + 4;
+    desc.cellHeight = PATCH_HEIGHT + 4;
+    desc.originX = 2;
+    desc.originY = 0;
+    desc.frames = FLOWER_FRAMES;
+    desc.paint = farm ? &FlowerPatch::PaintFarmSprite : &FlowerPatch::PaintGardenSprite;
+    return desc;
+}
+
+void FlowerPatch::PaintFarmSprite(Renderer* renderer, int screenX, int screenY, int frame, int /*facing*/) {
+    PaintFlowers(renderer, screenX, screenY, frame, true);
 }
 
-void FlowerPatch::Render(Renderer* renderer, Vector2 cameraOffset) {
-    RenderObject(renderer, cameraOffset);
+void FlowerPatch::PaintGardenSprite(Renderer* renderer, int screenX, int screenY, int frame, int /*facing*/) {
+    PaintFlowers(renderer, screenX, screenY, frame, false);
 }
 
-void FlowerPatch::RenderObject(Renderer* renderer, Vector2 cameraOffset) {
-    // Calculate screen position
-    int screenX = static_cast<int>(position_.x - cameraOffset.x);
-    int screenY = static_cast<int>(position_.y - cameraOffset.y);
+void FlowerPatch::PaintFlowers(Renderer* renderer, int screenX, int screenY, int frame, bool farm) {
+    float animationTimer = static_cast<float>(frame) * ANIMATION_LOOP / FLOWER_FRAMES;
     
     // Render individual flowers
-    int flowerCount = (patchType_ == "farm") ? 4 : 6;
+    int flowerCount = farm ? 4 : 6;
     for (int i = 0; i < flowerCount; i++) {
         // Arrange flowers in a natural pattern
         int flowerX, flowerY;
-        if (patchType_ == "farm") {
+        if (farm) {
             flowerX = screenX + 5 + (i % 2) * 18;
             flowerY = screenY + 5 + (i / 2) * 18;
         } else {
@@ -44,7 +67,7 @@ void FlowerPatch::RenderObject(Renderer* renderer, Vector2 cameraOffset) {
         }
         
         // Add gentle swaying animation
-        float sway = std::sin(animationTimer_ * 2.0f + i * 0.5f) * 1.0f;
+        float sway = std::sin(animationTimer * 2.0f + i * 0.5f) * 1.0f;
         flowerX += static_cast<int>(sway);
         
         // Flower stem
@@ -53,7 +76,7 @@ void FlowerPatch::RenderObject(Renderer* renderer, Vector2 cameraOffset) {
         
         // Flower head - different colors based on type and index
         SDL_Color flowerColor;
-        if (patchType_ == "farm") {
+        if (farm) {
             // Farm flowers: pink, yellow, coral
             if (i % 3 == 0) {
                 flowerColor = {255, 182, 193, 255}; // Light pink
@@ -1,90 +1,74 @@
 #include "NPC.h"
+#include "SpriteCache.h"
 
-NPC::NPC() : position_(0, 0), currentDialogueIndex_(0) {
-    dialogue_ = {"Hello, I'm a generic NPC!"};
+EntityId NPC::Spawn(EntityStore& store, float x, float y, const std::vector<std::string>& dialogue) {
+    EntityDesc desc;
+    desc.archetype = Archetype::NPC;
+    desc.sheet = SpriteSheet::NPC;
+    desc.x = x;
+    desc.y = y;
+    desc.interactionRadius = INTERACTION_RADIUS;
+    return store.Create(desc, dialogue);
 }
 
-NPC::NPC(int xPosition, int yPosition) : position_(xPosition, yPosition), currentDialogueIndex_(0) {
-    dialogue_ = {"Hello, I'm a generic NPC!"};
+RenderStyle NPC::GetRenderStyle() {
+    // Body plus the drop shadow offset; only the body blocks
+    RenderStyle style;
+    style.bounds = Rect(0, 0, NPC_WIDTH + 4, NPC_HEIGHT + 4);
+    style.collisionWidth = NPC_WIDTH;
+    style.collisionHeight = NPC_HEIGHT;
+    return style;
 }
 
-NPC::NPC(int xPosition, int yPosition, const std::vector<std::string>& dialogue) 
-    : position_(xPosition, yPosition), dialogue_(dialogue), currentDialogueIndex_(0) {
+ArchetypeInfo NPC::GetArchetypeInfo() {
+    // Talked to before anything else in reach, one line after another
+    ArchetypeInfo info;
+    info.interaction = InteractableType::NPC;
+    info.interactionPriority = 1;
+    info.flags = ENTITY_CYCLES_DIALOGUE;
+    return info;
 }
 
-NPC::~NPC() {}
-
-void NPC::Update(float deltaTime) {
-    // NPCs can have idle animations, movement patterns, etc.
-    // For now, the breeder NPC is stationary
+SpriteSheetDesc NPC::GetSpriteSheet() {
+    // Body plus the drop shadow offset, same as the render style bounds
+    SpriteSheetDesc desc;
+    desc.cellWidth = NPC_WIDTH + 4;
+    desc.cellHeight = NPC_HEIGHT + 4;
+    desc.paint = &NPC::PaintSprite;
+    return desc;
 }
 
-void NPC::Render(Renderer* renderer, Vector2 cameraOffset) {
+void NPC::PaintSprite(Renderer* renderer, int screenX, int screenY, int /*frame*/, int /*facing*/) {
     // Render blue block NPC
     SDL_Color npcBlue = {50, 100, 200, 255};
     SDL_Color npcHighlight = {80, 130, 230, 255};
     SDL_Color npcShadow = {30, 60, 120, 255};
     
     // NPC shadow
-    Rect shadowRect(position_.x + 4, position_.y + 4, NPC_WIDTH, NPC_HEIGHT);
-    renderer->DrawRectWorld(shadowRect, cameraOffset, SDL_Color{0, 0, 0, 60});
+    Rect shadowRect(screenX + 4, screenY + 4, NPC_WIDTH, NPC_HEIGHT);
+    renderer->DrawRect(shadowRect, SDL_Color{0, 0, 0, 60});
     
     // Main NPC body
-    Rect npcRect(position_.x, position_.y, NPC_WIDTH, NPC_HEIGHT);
-    renderer->DrawRectWorld(npcRect, cameraOffset, npcBlue);
+    Rect npcRect(screenX, screenY, NPC_WIDTH, NPC_HEIGHT);
+    renderer->DrawRect(npcRect, npcBlue);
     
     // NPC highlight (top edge)
-    Rect highlightRect(position_.x, position_.y, NPC_WIDTH, 6);
-    renderer->DrawRectWorld(highlightRect, cameraOffset, npcHighlight);
+    Rect highlightRect(screenX, screenY, NPC_WIDTH, 6);
+    renderer->DrawRect(highlightRect, npcHighlight);
     
     // NPC depth edge (right side)
-    Rect depthRect(position_.x + NPC_WIDTH - 4, position_.y + 6, 4, NPC_HEIGHT - 6);
-    renderer->DrawRectWorld(depthRect, cameraOffset, npcShadow);
+    Rect depthRect(screenX + NPC_WIDTH - 4, screenY + 6, 4, NPC_HEIGHT - 6);
+    renderer->DrawRect(depthRect, npcShadow);
     
     // Simple face (eyes)
-    Rect leftEye(position_.x + 8, position_.y + 10, 4, 4);
-    Rect rightEye(position_.x + 20, position_.y + 10, 4, 4);
-    renderer->DrawRectWorld(leftEye, cameraOffset, SDL_Color{255, 255, 255, 255});
-    renderer->DrawRectWorld(rightEye, cameraOffset, SDL_Color{255, 255, 255, 255});
+    Rect leftEye(screenX + 8, screenY + 10, 4, 4);
+    Rect rightEye(screenX + 20, screenY + 10, 4, 4);
+    renderer->DrawRect(leftEye, SDL_Color{255, 255, 255, 255});
+    renderer->DrawRect(rightEye, SDL_Color{255, 255, 255, 255});
     
     // Eye pupils
-    Rect leftPupil(position_.x + 9, position_.y + 11, 2, 2);
-    Rect rightPupil(position_.x + 21, position_.y + 11, 2, 2);
-    renderer->DrawRectWorld(leftPupil, cameraOffset, SDL_Color{0, 0, 0, 255});
-    renderer->DrawRectWorld(rightPupil, cameraOffset, SDL_Color{0, 0, 0, 255});
-}
-
-Vector2 NPC::GetPosition() const {
-    return position_;
-}
-
-Rect NPC::GetInteractionBounds() const {
-    return Rect(position_.x - 16, position_.y - 16, NPC_WIDTH + 32, NPC_HEIGHT + 32);
-}
-
-InteractableType NPC::GetType() const {
-    return InteractableType::NPC;
-}
-
-std::vector<std::string> NPC::GetDialogue() const {
-    return dialogue_;
-}
-
-void NPC::SetDialogue(const std::vector<std::string>& dialogue) {
-    dialogue_ = dialogue;
-}
-
-Rect NPC::GetCollisionBounds() const {
-    return Rect(position_.x, position_.y, NPC_WIDTH, NPC_HEIGHT);
-}
-
-std::string NPC::GetCurrentDialogue() const {
-    if (dialogue_.empty()) return "";
-    return dialogue_[currentDialogueIndex_];
-}
-
-void NPC::NextDialogue() {
-    if (!dialogue_.empty()) {
-        currentDialogueIndex_ = (currentDialogueIndex_ + 1) % dialogue_.size();
-    }
+    Rect leftPupil(screenX + 9, screenY + 11, 2, 2);
+    Rect rightPupil(screenX + 21, screenY + 11, 2, 2);
+    renderer->DrawRect(leftPupil, SDL_Color{0, 0, 0, 255});
+    renderer->DrawRect(rightPupil, SDL_Color{0, 0, 0, 255});
 }
@@ -0,0 +1,150 @@
+#include "AssetLoader.h"
+#include <SDL_image.h>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+AssetLoader::AssetLoader()
+    : pending_(0), generation_(0), stopping_(false) {
+}
+
+AssetLoader::~AssetLoader() {
+    Shutdown();
+}
+
+bool AssetLoader::Initialize(int workerCount) {
+    stopping_ = false;
+
+    for (int i = 0; i < workerCount; ++i) {
+        workers_.emplace_back(&AssetLoader::WorkerLoop, this);
+    }
+    return !workers_.empty();
+}
+
+void AssetLoader::Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        jobs_.clear();
+    }
+    jobReady_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+
+    // Decoded but never uploaded
+    for (Result& result : results_) {
+        if (result.surface) SDL_FreeSurface(result.surface);
+    }
+    results_.clear();
+    pending_ = 0;
+}
+
+void AssetLoader::RequestImage(const std::string& path, ImageCallback onLoaded) {
+    Job job;
+    job.paths.push_back(path);
+    job.onImage = std::move(onLoaded);
+    Enqueue(std::move(job));
+}
+
+void AssetLoader::RequestFile(const std::vector<std::string>& paths, FileCallback onLoaded) {
+    Job job;
+    job.paths = paths;
+    job.onFile = std::move(onLoaded);
+    Enqueue(std::move(job));
+}
+
+void AssetLoader::Enqueue(Job&& job) {
+    pending_++;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push_back(std::move(job));
+    }
+    jobReady_.notify_one();
+}
+
+void AssetLoader::WorkerLoop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            jobReady_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+            if (stopping_) return;
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+
+        Result result;
+        result.onImage = std::move(job.onImage);
+        result.onFile = std::move(job.onFile);
+
+        if (result.onImage) {
+            result.surface = IMG_Load(job.paths.front().c_str());
+            if (!result.surface) {
+                std::cerr << "IMG_Load Error: " << IMG_GetError() << std::endl;
+            }
+        } else {
+            for (const std::string& path : job.paths) {
+                std::ifstream file(path, std::ios::binary);
+                if (!file) continue;
+                result.data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+                break;
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            results_.push_back(std::move(result));
+        }
+        resultReady_.notify_one();
+    }
+}
+
+void AssetLoader::Update(double budgetMs) {
+    Uint64 start = SDL_GetPerformanceCounter();
+    double ticksPerMs = static_cast<double>(SDL_GetPerformanceFrequency()) / 1000.0;
+
+    while (pending_ > 0) {
+        Result result;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (results_.empty()) break;
+            result = std::move(results_.front());
+            results_.pop_front();
+        }
+        Complete(result);
+
+        if (static_cast<double>(SDL_GetPerformanceCounter() - start) / ticksPerMs >= budgetMs) break;
+    }
+}
+
+void AssetLoader::Finish() {
+    Result result;
+    while (pending_ > 0 && WaitForResult(result)) {
+        Complete(result);
+    }
+}
+
+bool AssetLoader::WaitForResult(Result& result) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    resultReady_.wait(lock, [this] { return !results_.empty() || workers_.empty(); });
+    if (results_.empty()) return false;
+
+    result = std::move(results_.front());
+    results_.pop_front();
+    return true;
+}
+
+void AssetLoader::Complete(Result& result) {
+    pending_--;
+    generation_++;
+
+    if (result.onImage) {
+        SDL_Surface* surface = result.surface;
+        result.surface = nullptr;
+        result.onImage(surface);
+    } else if (result.onFile) {
+        result.onFile(std::move(result.data));
+    }
+}
@@ -2,7 +2,7 @@
 #include <cstdio>
 
 Camera::Camera() 
-    : position_(4608.0f, 3456.0f), target_(4608.0f, 3456.0f), offset_(0.0f, 0.0f),
+    : position_(4608.0f, 3456.0f), target_(4608.0f, 3456.0f), offset_(0.0f, 0.0f), previousOffset_(0.0f, 0.0f),
       viewportWidth_(1024), viewportHeight_(768), 
       worldWidth_(9216), worldHeight_(6912), followSpeed_(5.0f) {
     // Initialize at world center to match player starting position
@@ -16,6 +16,8 @@ void Camera::SetTarget(const Vector2& target) {
 }
 
 void Camera::Update(float deltaTime) {
+    previousOffset_ = offset_;
+    
     // Snap camera directly to target for immediate following
     position_ = target_;
     
@@ -27,6 +29,11 @@ void Camera::Update(float deltaTime) {
     ClampToWorldBounds();
 }
 
+void Camera::SnapToTarget() {
+    Update(0.0f);
+    previousOffset_ = offset_;
+}
+
 Vector2 Camera::WorldToScreen(const Vector2& worldPos) const {
     return Vector2(worldPos.x - offset_.x, worldPos.y - offset_.y);
 }
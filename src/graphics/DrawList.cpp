@@ -0,0 +1,139 @@
+#include "DrawList.h"
+#include <algorithm>
+
+DrawList::DrawList()
+    : nextSequence_(0) {
+}
+
+DrawHandle DrawList::Add(DrawLayer layer, DrawCallback draw, float sortY) {
+    DrawHandle handle;
+    if (!freeHandles_.empty()) {
+        handle = freeHandles_.back();
+        freeHandles_.pop_back();
+    } else {
+        handle = static_cast<DrawHandle>(items_.size());
+        items_.emplace_back();
+    }
+
+    Item& item = items_[handle];
+    item.layer = layer;
+    item.draw = std::move(draw);
+    item.sortY = sortY;
+    item.sequence = nextSequence_++;
+    item.alive = true;
+
+    Layer& target = LayerOf(handle);
+    target.order.push_back(handle);
+    target.needsSort = target.ySorted;
+    target.contentDirty = true;
+    return handle;
+}
+
+void DrawList::Remove(DrawHandle handle) {
+    if (!IsValid(handle)) return;
+
+    Layer& layer = LayerOf(handle);
+    layer.order.erase(std::find(layer.order.begin(), layer.order.end(), handle));
+    layer.contentDirty = true;
+
+    Item& item = items_[handle];
+    item.alive = false;
+    item.draw = nullptr;
+    freeHandles_.push_back(handle);
+}
+
+void DrawList::SetSortY(DrawHandle handle, float sortY) {
+    if (!IsValid(handle)) return;
+
+    Item& item = items_[handle];
+    if (item.sortY == sortY) return;
+
+    item.sortY = sortY;
+    Layer& layer = LayerOf(handle);
+    layer.needsSort = layer.ySorted;
+    layer.contentDirty = true;
+}
+
+void DrawList::Invalidate(DrawHandle handle) {
+    if (!IsValid(handle)) return;
+    LayerOf(handle).contentDirty = true;
+}
+
+void DrawList::SetLayerYSorted(DrawLayer layer, bool ySorted) {
+    Layer& target = layers_[static_cast<int>(layer)];
+    target.ySorted = ySorted;
+    target.needsSort = ySorted;
+    target.contentDirty = true;
+}
+
+void DrawList::SetLayerCached(DrawLayer layer, bool cached, bool screenSpace) {
+    Layer& target = layers_[static_cast<int>(layer)];
+    target.cached = cached;
+    target.screenSpace = screenSpace;
+    target.contentDirty = true;
+    target.recording.clear();
+}
+
+void DrawList::Submit(Renderer* renderer, const Vector2& cameraOffset) {
+    stats_ = DrawListStats();
+
+    for (Layer& layer : layers_) {
+        bool cameraMatches = layer.screenSpace ||
+            (layer.recordedOffset.x == cameraOffset.x && layer.recordedOffset.y == cameraOffset.y);
+
+        // Nothing in the layer changed, replay what it drew last time
+        if (layer.cached && !layer.contentDirty && cameraMatches) {
+            renderer->Replay(layer.recording);
+            stats_.layersReplayed++;
+            continue;
+        }
+
+        if (layer.needsSort) {
+            SortLayer(layer);
+            stats_.layersSorted++;
+        }
+
+        if (layer.cached) {
+            renderer->BeginRecording(&layer.recording);
+        }
+
+        for (DrawHandle handle : layer.order) {
+            items_[handle].draw(renderer, cameraOffset);
+        }
+
+        if (layer.cached) {
+            renderer->EndRecording();
+            layer.recordedOffset = cameraOffset;
+            layer.contentDirty = false;
+        }
+        stats_.layersDrawn++;
+    }
+}
+
+bool DrawList::DrawsBefore(DrawHandle a, DrawHandle b) const {
+    const Item& itemA = items_[a];
+    const Item& itemB = items_[b];
+    if (itemA.sortY != itemB.sortY) return itemA.sortY < itemB.sortY;
+    return itemA.sequence < itemB.sequence;
+}
+
+void DrawList::SortLayer(Layer& layer) {
+    // Entities move a little each frame so the order is almost always nearly
+    // sorted already; insertion sort is linear in that case
+    std::vector<DrawHandle>& order = layer.order;
+    for (size_t i = 1; i < order.size(); ++i) {
+        DrawHandle handle = order[i];
+        size_t j = i;
+        while (j > 0 && DrawsBefore(handle, order[j - 1])) {
+            order[j] = order[j - 1];
+            --j;
+            stats_.sortShifts++;
+        }
+        order[j] = handle;
+    }
+    layer.needsSort = false;
+}
+
+bool DrawList::IsValid(DrawHandle handle) const {
+    return handle >= 0 && handle < static_cast<DrawHandle>(items_.size()) && items_[handle].alive;
+}
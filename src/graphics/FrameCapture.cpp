@@ -0,0 +1,55 @@
+#include "FrameCapture.h"
+#include "Renderer.h"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+FrameCapture::FrameCapture(const std::vector<int>& frames, const std::string& directory)
+    : frames_(frames), directory_(directory) {
+    std::sort(frames_.begin(), frames_.end());
+}
+
+bool FrameCapture::ShouldCapture(int frame) const {
+    return std::binary_search(frames_.begin(), frames_.end(), frame);
+}
+
+bool FrameCapture::Capture(Renderer* renderer, int frame) {
+    SDL_Surface* pixels = renderer->ReadFramebuffer();
+    if (!pixels) {
+        return false;
+    }
+
+    char hash[17];
+    std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(HashPixels(pixels)));
+    std::cout << "[capture] frame " << frame << " hash " << hash << std::endl;
+
+    bool ok = true;
+    if (!directory_.empty()) {
+        char fileName[32];
+        std::snprintf(fileName, sizeof(fileName), "frame_%06d.bmp", frame);
+        std::string path = directory_ + "/" + fileName;
+        if (SDL_SaveBMP(pixels, path.c_str()) != 0) {
+            std::cerr << "SDL_SaveBMP Error: " << SDL_GetError() << std::endl;
+            ok = false;
+        }
+    }
+
+    SDL_FreeSurface(pixels);
+    return ok;
+}
+
+Uint64 FrameCapture::HashPixels(const SDL_Surface* surface) {
+    const Uint64 FNV_OFFSET = 14695981039346656037ULL;
+    const Uint64 FNV_PRIME = 1099511628211ULL;
+
+    Uint64 hash = FNV_OFFSET;
+    int rowBytes = surface->w * surface->format->BytesPerPixel;
+    for (int y = 0; y < surface->h; ++y) {
+        const Uint8* row = static_cast<const Uint8*>(surface->pixels) + y * surface->pitch;
+        for (int i = 0; i < rowBytes; ++i) {
+            hash ^= row[i];
+            hash *= FNV_PRIME;
+        }
+    }
+    return hash;
+}
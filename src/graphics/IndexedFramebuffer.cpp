@@ -0,0 +1,104 @@
+#include "IndexedFramebuffer.h"
+#include <cstring>
+
+namespace {
+
+Uint8 LevelValue(int level, int levels) {
+    return static_cast<Uint8>(level * 255 / (levels - 1));
+}
+
+int NearestLevel(int value, int levels) {
+    return (value * (levels - 1) + 127) / 255;
+}
+
+int DistanceSquared(SDL_Color color, int r, int g, int b) {
+    return (color.r - r) * (color.r - r) + (color.g - g) * (color.g - g) + (color.b - b) * (color.b - b);
+}
+
+} // namespace
+
+IndexedFramebuffer::IndexedFramebuffer()
+    : width_(0), height_(0), tint_{255, 255, 255, 255} {
+    const int CUBE_SIZE = CUBE_LEVELS * CUBE_LEVELS * CUBE_LEVELS;
+    for (int r = 0; r < CUBE_LEVELS; ++r) {
+        for (int g = 0; g < CUBE_LEVELS; ++g) {
+            for (int b = 0; b < CUBE_LEVELS; ++b) {
+                palette_[(r * CUBE_LEVELS + g) * CUBE_LEVELS + b] = SDL_Color{
+                    LevelValue(r, CUBE_LEVELS), LevelValue(g, CUBE_LEVELS), LevelValue(b, CUBE_LEVELS), 255};
+            }
+        }
+    }
+    for (int i = 0; i < GRAY_LEVELS; ++i) {
+        Uint8 value = LevelValue(i, GRAY_LEVELS);
+        palette_[CUBE_SIZE + i] = SDL_Color{value, value, value, 255};
+    }
+
+    // The nearest cube entry is the nearest level per channel and the nearest
+    // gray the one closest to the mean, so only those two need comparing
+    quantize_.resize(32 * 32 * 32);
+    for (int color = 0; color < 32 * 32 * 32; ++color) {
+        int r = ((color >> 10) & 0x1F) * 255 / 31;
+        int g = ((color >> 5) & 0x1F) * 255 / 31;
+        int b = (color & 0x1F) * 255 / 31;
+
+        int cube = (NearestLevel(r, CUBE_LEVELS) * CUBE_LEVELS + NearestLevel(g, CUBE_LEVELS)) * CUBE_LEVELS +
+                   NearestLevel(b, CUBE_LEVELS);
+        int gray = CUBE_SIZE + NearestLevel((r + g + b) / 3, GRAY_LEVELS);
+        bool grayCloser = DistanceSquared(palette_[gray], r, g, b) < DistanceSquared(palette_[cube], r, g, b);
+        quantize_[color] = static_cast<Uint8>(grayCloser ? gray : cube);
+    }
+
+    SetTint(tint_);
+}
+
+void IndexedFramebuffer::Initialize(int width, int height) {
+    width_ = width;
+    height_ = height;
+    indices_.assign(static_cast<size_t>(width) * height, 0);
+}
+
+void IndexedFramebuffer::Quantize(const SDL_Surface* source) {
+    if (!source || source->w != width_ || source->h != height_) return;
+
+    const Uint8* row = static_cast<const Uint8*>(source->pixels);
+    Uint8* out = indices_.data();
+    for (int y = 0; y < height_; ++y, row += source->pitch) {
+        const Uint32* pixel = reinterpret_cast<const Uint32*>(row);
+        for (int x = 0; x < width_; ++x) {
+            Uint32 argb = pixel[x];
+            *out++ = quantize_[((argb >> 9) & 0x7C00) | ((argb >> 6) & 0x03E0) | ((argb >> 3) & 0x001F)];
+        }
+    }
+}
+
+void IndexedFramebuffer::SetTint(SDL_Color tint) {
+    tint_ = tint;
+    for (int i = 0; i < PALETTE_SIZE; ++i) {
+        Uint32 r = palette_[i].r * tint.r / 255;
+        Uint32 g = palette_[i].g * tint.g / 255;
+        Uint32 b = palette_[i].b * tint.b / 255;
+        display_[i] = 0xFF000000u | (r << 16) | (g << 8) | b;
+    }
+}
+
+void IndexedFramebuffer::Expand(void* pixels, int pitch, int scale) const {
+    Uint8* rowOut = static_cast<Uint8*>(pixels);
+    const Uint8* index = indices_.data();
+    size_t rowBytes = static_cast<size_t>(width_) * scale * sizeof(Uint32);
+
+    for (int y = 0; y < height_; ++y) {
+        Uint32* out = reinterpret_cast<Uint32*>(rowOut);
+        for (int x = 0; x < width_; ++x) {
+            Uint32 color = display_[*index++];
+            for (int i = 0; i < scale; ++i) {
+                *out++ = color;
+            }
+        }
+
+        // The remaining rows of the block are copies of the first
+        for (int i = 1; i < scale; ++i) {
+            std::memcpy(rowOut + i * pitch, rowOut, rowBytes);
+        }
+        rowOut += scale * pitch;
+    }
+}
@@ -0,0 +1,246 @@
+#include "LightMap.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const SDL_Color NIGHT_AMBIENT = {60, 70, 125, 255};  // Moonlight
+const SDL_Color DUSK_AMBIENT = {255, 165, 115, 255}; // Sunrise and sunset
+const SDL_Color DAY_AMBIENT = {255, 255, 255, 255};
+
+// Sun heights (sine of its angle) where night ends and full day begins
+const float NIGHT_ELEVATION = -0.15f;
+const float DAY_ELEVATION = 0.3f;
+const float PI = 3.14159265f;
+
+Uint8 LerpChannel(Uint8 from, Uint8 to, float t) {
+    return static_cast<Uint8>(from + (to - from) * t + 0.5f);
+}
+
+SDL_Color LerpColor(SDL_Color from, SDL_Color to, float t) {
+    return SDL_Color{LerpChannel(from.r, to.r, t), LerpChannel(from.g, to.g, t), LerpChannel(from.b, to.b, t), 255};
+}
+
+int SnapDown(float value, int step) {
+    return static_cast<int>(std::floor(value / step)) * step;
+}
+
+} // namespace
+
+LightMap::LightMap()
+    : texture_(nullptr), widthCells_(0), heightCells_(0), originX_(0), originY_(0), valid_(false),
+      lightsVersion_(0), sunStep_(-1), ambient_(DAY_AMBIENT), glow_(0), neutral_(true),
+      dirty_{0, 0, 0, 0}, hasDirty_(false), uploadAll_(true), cellsStamped_(0) {
+}
+
+LightMap::~LightMap() {
+    Shutdown();
+}
+
+void LightMap::Initialize(int viewWidth, int viewHeight) {
+    // One step of slack past the view, so the view fits whatever the camera's
+    // position between two origin steps
+    widthCells_ = ((viewWidth + ORIGIN_STEP - 1) / ORIGIN_STEP + 1) * ORIGIN_STEP / CELL_SIZE;
+    heightCells_ = ((viewHeight + ORIGIN_STEP - 1) / ORIGIN_STEP + 1) * ORIGIN_STEP / CELL_SIZE;
+    light_.assign(static_cast<size_t>(widthCells_) * heightCells_ * 3, 0);
+    pixels_.assign(static_cast<size_t>(widthCells_) * heightCells_, 0xFFFFFFFFu);
+    valid_ = false;
+    uploadAll_ = true;
+}
+
+void LightMap::Shutdown() {
+    Invalidate();
+    lights_.clear();
+    valid_ = false;
+}
+
+void LightMap::Invalidate() {
+    if (texture_) {
+        SDL_DestroyTexture(texture_);
+        texture_ = nullptr;
+    }
+    uploadAll_ = true;
+}
+
+bool LightMap::Update(Renderer* renderer, const LightingView& lighting, const Vector2& cameraOffset) {
+    cellsStamped_ = 0;
+    if (widthCells_ == 0) return false;
+
+    bool wasNeutral = neutral_;
+
+    // Lights are re-stamped from scratch only when the map recenters, otherwise
+    // just the ones that changed are taken out and put back in
+    int originX = SnapDown(cameraOffset.x, ORIGIN_STEP);
+    int originY = SnapDown(cameraOffset.y, ORIGIN_STEP);
+    if (!valid_ || originX != originX_ || originY != originY_) {
+        originX_ = originX;
+        originY_ = originY;
+        Restamp(lighting);
+    } else if (lighting.version != lightsVersion_) {
+        ApplyLightChanges(lighting.lights);
+        lightsVersion_ = lighting.version;
+    }
+
+    if (SetSun(lighting.sunStep)) {
+        MarkDirty(SDL_Rect{0, 0, widthCells_, heightCells_});
+    }
+
+    // In full daylight nothing is drawn, so there is nothing to keep uploaded
+    if (neutral_) return !wasNeutral;
+
+    if (!texture_) {
+        texture_ = renderer->CreateStreamingTexture(widthCells_, heightCells_);
+        if (!texture_) return false;
+        SDL_SetTextureBlendMode(texture_, SDL_BLENDMODE_MOD);
+#if SDL_VERSION_ATLEAST(2, 0, 12)
+        // Smooth light falloff between cells whatever the scale quality hint says
+        SDL_SetTextureScaleMode(texture_, SDL_ScaleModeLinear);
+#endif
+        uploadAll_ = true;
+    }
+
+    bool changed = wasNeutral || uploadAll_ || hasDirty_;
+    Upload();
+    return changed;
+}
+
+void LightMap::Render(Renderer* renderer, const Vector2& cameraOffset) {
+    if (!texture_ || neutral_) return;
+
+    Rect destRect(static_cast<int>(originX_ - cameraOffset.x), static_cast<int>(originY_ - cameraOffset.y),
+                  widthCells_ * CELL_SIZE, heightCells_ * CELL_SIZE);
+    renderer->DrawTextureStretched(texture_, destRect);
+}
+
+void LightMap::Restamp(const LightingView& lighting) {
+    std::fill(light_.begin(), light_.end(), 0);
+    lights_ = lighting.lights;
+    lightsVersion_ = lighting.version;
+    for (const PointLight& light : lights_) {
+        Stamp(light, 1);
+    }
+    MarkDirty(SDL_Rect{0, 0, widthCells_, heightCells_});
+    valid_ = true;
+}
+
+void LightMap::ApplyLightChanges(const std::vector<PointLight>& lights) {
+    // Both lists ascend by id, walk them side by side
+    size_t oldIndex = 0;
+    size_t newIndex = 0;
+    while (oldIndex < lights_.size() || newIndex < lights.size()) {
+        if (newIndex == lights.size() || (oldIndex < lights_.size() && lights_[oldIndex].id < lights[newIndex].id)) {
+            Stamp(lights_[oldIndex++], -1);
+        } else if (oldIndex == lights_.size() || lights[newIndex].id < lights_[oldIndex].id) {
+            Stamp(lights[newIndex++], 1);
+        } else {
+            if (!SameLight(lights_[oldIndex], lights[newIndex])) {
+                Stamp(lights_[oldIndex], -1);
+                Stamp(lights[newIndex], 1);
+            }
+            oldIndex++;
+            newIndex++;
+        }
+    }
+    lights_ = lights;
+}
+
+void LightMap::Stamp(const PointLight& light, int sign) {
+    if (light.radius <= 0) return;
+
+    int firstX = std::max((light.x - light.radius - originX_) / CELL_SIZE, 0);
+    int firstY = std::max((light.y - light.radius - originY_) / CELL_SIZE, 0);
+    int lastX = std::min((light.x + light.radius - originX_) / CELL_SIZE, widthCells_ - 1);
+    int lastY = std::min((light.y + light.radius - originY_) / CELL_SIZE, heightCells_ - 1);
+    if (firstX > lastX || firstY > lastY) return;
+
+    // Quadratic falloff from the center, sampled at cell centers. Integer math,
+    // so taking a light out subtracts exactly what putting it in added.
+    int radiusSquared = light.radius * light.radius;
+    for (int y = firstY; y <= lastY; ++y) {
+        int dy = originY_ + y * CELL_SIZE + CELL_SIZE / 2 - light.y;
+        for (int x = firstX; x <= lastX; ++x) {
+            int dx = originX_ + x * CELL_SIZE + CELL_SIZE / 2 - light.x;
+            int distanceSquared = dx * dx + dy * dy;
+            if (distanceSquared >= radiusSquared) continue;
+
+            int falloff = static_cast<int>(static_cast<long long>(radiusSquared - distanceSquared) * 256 / radiusSquared);
+            int weight = sign * light.color.a * (falloff * falloff >> 8); // Up to 255 * 256
+            int* cell = &light_[(static_cast<size_t>(y) * widthCells_ + x) * 3];
+            cell[0] += light.color.r * weight / (255 * 256);
+            cell[1] += light.color.g * weight / (255 * 256);
+            cell[2] += light.color.b * weight / (255 * 256);
+        }
+    }
+    cellsStamped_ += (lastX - firstX + 1) * (lastY - firstY + 1);
+    MarkDirty(SDL_Rect{firstX, firstY, lastX - firstX + 1, lastY - firstY + 1});
+}
+
+bool LightMap::SetSun(int sunStep) {
+    if (sunStep == sunStep_) return false;
+    sunStep_ = sunStep;
+
+    // The sun rises at 6:00 and sets at 18:00
+    float hour = (sunStep + 0.5f) * 24.0f / SUN_STEPS;
+    float elevation = std::sin((hour - 6.0f) / 12.0f * PI);
+    float daylight = std::min(std::max((elevation - NIGHT_ELEVATION) / (DAY_ELEVATION - NIGHT_ELEVATION), 0.0f), 1.0f);
+
+    SDL_Color ambient = daylight < 0.5f ? LerpColor(NIGHT_AMBIENT, DUSK_AMBIENT, daylight * 2.0f)
+                                        : LerpColor(DUSK_AMBIENT, DAY_AMBIENT, daylight * 2.0f - 1.0f);
+    int glow = static_cast<int>((1.0f - daylight) * 256.0f + 0.5f);
+
+    // Most steps of the day and night look alike
+    bool changed = ambient.r != ambient_.r || ambient.g != ambient_.g || ambient.b != ambient_.b || glow != glow_;
+    ambient_ = ambient;
+    glow_ = glow;
+    neutral_ = glow_ == 0 && ambient_.r == 255 && ambient_.g == 255 && ambient_.b == 255;
+    return changed;
+}
+
+void LightMap::MarkDirty(const SDL_Rect& cells) {
+    if (!hasDirty_) {
+        dirty_ = cells;
+        hasDirty_ = true;
+        return;
+    }
+
+    int right = std::max(dirty_.x + dirty_.w, cells.x + cells.w);
+    int bottom = std::max(dirty_.y + dirty_.h, cells.y + cells.h);
+    dirty_.x = std::min(dirty_.x, cells.x);
+    dirty_.y = std::min(dirty_.y, cells.y);
+    dirty_.w = right - dirty_.x;
+    dirty_.h = bottom - dirty_.y;
+}
+
+void LightMap::Upload() {
+    SDL_Rect cells = uploadAll_ ? SDL_Rect{0, 0, widthCells_, heightCells_} : dirty_;
+    if (!uploadAll_ && !hasDirty_) return;
+
+    for (int y = cells.y; y < cells.y + cells.h; ++y) {
+        for (int x = cells.x; x < cells.x + cells.w; ++x) {
+            int cell = y * widthCells_ + x;
+            SDL_Color color = ResolveCell(cell);
+            pixels_[cell] = 0xFF000000u | (color.r << 16) | (color.g << 8) | color.b;
+        }
+    }
+
+    SDL_UpdateTexture(texture_, &cells, &pixels_[cells.y * widthCells_ + cells.x],
+                      widthCells_ * static_cast<int>(sizeof(Uint32)));
+    uploadAll_ = false;
+    hasDirty_ = false;
+}
+
+SDL_Color LightMap::ResolveCell(int cell) const {
+    // Lamps add to the sky light, more of them the darker it is
+    const int* light = &light_[static_cast<size_t>(cell) * 3];
+    return SDL_Color{
+        static_cast<Uint8>(std::min(ambient_.r + (light[0] * glow_ >> 8), 255)),
+        static_cast<Uint8>(std::min(ambient_.g + (light[1] * glow_ >> 8), 255)),
+        static_cast<Uint8>(std::min(ambient_.b + (light[2] * glow_ >> 8), 255)),
+        255
+    };
+}
+
+bool LightMap::SameLight(const PointLight& a, const PointLight& b) {
+    return a.x == b.x && a.y == b.y && a.radius == b.radius && a.color.r == b.color.r &&
+           a.color.g == b.color.g && a.color.b == b.color.b && a.color.a == b.color.a;
+}
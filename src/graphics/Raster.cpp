@@ -0,0 +1,353 @@
+#include "Raster.h"
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define RASTER_X86 1
+#include <immintrin.h>
+#endif
+
+// Vector kernels are compiled for their instruction set whatever the build
+// flags; they only ever run after the CPU check
+#if defined(__GNUC__) || defined(__clang__)
+#define RASTER_TARGET(isa) __attribute__((target(isa)))
+#else
+#define RASTER_TARGET(isa)
+#endif
+
+namespace Raster {
+
+namespace {
+
+// Row kernels, count > 0
+using FillSolidRow = void (*)(Uint32* dst, int count, Uint32 argb);
+using FillBlendRow = void (*)(Uint32* dst, int count, SDL_Color color);
+using BlitBlendRow = void (*)(Uint32* dst, const Uint32* src, int count);
+
+struct Kernels {
+    FillSolidRow fillSolid;
+    FillBlendRow fillBlend;
+    BlitBlendRow blitBlend;
+};
+
+Uint32 PackColor(SDL_Color color) {
+    return (static_cast<Uint32>(color.a) << 24) | (static_cast<Uint32>(color.r) << 16) |
+           (static_cast<Uint32>(color.g) << 8) | color.b;
+}
+
+// x / 255 rounded to nearest, exact for x up to 255 * 255. The vector
+// versions do the same in 16-bit lanes.
+Uint32 Div255(Uint32 x) {
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+// One channel of source-over: source weighted by alpha, destination by the rest
+Uint32 BlendChannel(Uint32 src, Uint32 dst, Uint32 alpha) {
+    return Div255(src * alpha + dst * (255 - alpha));
+}
+
+// The alpha channel blends as if the source alpha channel were opaque, which
+// gives the usual a + d * (1 - a)
+Uint32 BlendPixel(Uint32 src, Uint32 dst, Uint32 alpha) {
+    return (BlendChannel(255, dst >> 24, alpha) << 24) |
+           (BlendChannel((src >> 16) & 0xFF, (dst >> 16) & 0xFF, alpha) << 16) |
+           (BlendChannel((src >> 8) & 0xFF, (dst >> 8) & 0xFF, alpha) << 8) |
+           BlendChannel(src & 0xFF, dst & 0xFF, alpha);
+}
+
+// --- Scalar ---
+
+void FillSolidScalar(Uint32* dst, int count, Uint32 argb) {
+    for (int i = 0; i < count; ++i) {
+        dst[i] = argb;
+    }
+}
+
+void FillBlendScalar(Uint32* dst, int count, SDL_Color color) {
+    Uint32 src = PackColor(color);
+    for (int i = 0; i < count; ++i) {
+        dst[i] = BlendPixel(src, dst[i], color.a);
+    }
+}
+
+void BlitBlendScalar(Uint32* dst, const Uint32* src, int count) {
+    for (int i = 0; i < count; ++i) {
+        Uint32 alpha = src[i] >> 24;
+        if (alpha == 255) {
+            dst[i] = src[i];
+        } else if (alpha != 0) {
+            dst[i] = BlendPixel(src[i], dst[i], alpha);
+        }
+    }
+}
+
+const Kernels SCALAR_KERNELS = {FillSolidScalar, FillBlendScalar, BlitBlendScalar};
+
+#ifdef RASTER_X86
+
+// --- SSE2, 4 pixels at a time ---
+
+// Lanes hold B, G, R, A per pixel (ARGB8888 in little-endian memory)
+RASTER_TARGET("sse2") __m128i Div255Sse2(__m128i x) {
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+RASTER_TARGET("sse2") void FillSolidSse2(Uint32* dst, int count, Uint32 argb) {
+    __m128i color = _mm_set1_epi32(static_cast<int>(argb));
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), color);
+    }
+    FillSolidScalar(dst + i, count - i, argb);
+}
+
+RASTER_TARGET("sse2") void FillBlendSse2(Uint32* dst, int count, SDL_Color color) {
+    // Source term is constant across the rect
+    short a = color.a;
+    __m128i source = _mm_set_epi16(255 * a, color.r * a, color.g * a, color.b * a,
+                                   255 * a, color.r * a, color.g * a, color.b * a);
+    __m128i inverse = _mm_set1_epi16(static_cast<short>(255 - a));
+    __m128i zero = _mm_setzero_si128();
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i lo = _mm_unpacklo_epi8(pixels, zero);
+        __m128i hi = _mm_unpackhi_epi8(pixels, zero);
+        lo = Div255Sse2(_mm_add_epi16(_mm_mullo_epi16(lo, inverse), source));
+        hi = Div255Sse2(_mm_add_epi16(_mm_mullo_epi16(hi, inverse), source));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+    }
+    FillBlendScalar(dst + i, count - i, color);
+}
+
+// Source-over for one half (two pixels) of a vector, unpacked to 16 bits
+RASTER_TARGET("sse2") __m128i BlendHalfSse2(__m128i src, __m128i srcAlpha, __m128i dst) {
+    // Each pixel's alpha in all four of its lanes
+    __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(srcAlpha, 0xFF), 0xFF);
+    __m128i inverse = _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+    return Div255Sse2(_mm_add_epi16(_mm_mullo_epi16(src, alpha), _mm_mullo_epi16(dst, inverse)));
+}
+
+RASTER_TARGET("sse2") void BlitBlendSse2(Uint32* dst, const Uint32* src, int count) {
+    __m128i zero = _mm_setzero_si128();
+    __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i source = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i alpha = _mm_and_si128(source, alphaMask);
+
+        // Sprites are mostly fully transparent or fully opaque
+        int transparent = _mm_movemask_epi8(_mm_cmpeq_epi32(alpha, zero));
+        if (transparent == 0xFFFF) continue;
+        int opaque = _mm_movemask_epi8(_mm_cmpeq_epi32(alpha, alphaMask));
+        if (opaque == 0xFFFF) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), source);
+            continue;
+        }
+
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i opaqueSource = _mm_or_si128(source, alphaMask);
+        __m128i lo = BlendHalfSse2(_mm_unpacklo_epi8(opaqueSource, zero), _mm_unpacklo_epi8(source, zero),
+                                   _mm_unpacklo_epi8(pixels, zero));
+        __m128i hi = BlendHalfSse2(_mm_unpackhi_epi8(opaqueSource, zero), _mm_unpackhi_epi8(source, zero),
+                                   _mm_unpackhi_epi8(pixels, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+    }
+    BlitBlendScalar(dst + i, src + i, count - i);
+}
+
+const Kernels SSE2_KERNELS = {FillSolidSse2, FillBlendSse2, BlitBlendSse2};
+
+// --- AVX2, 8 pixels at a time; same as SSE2 within each 128-bit lane ---
+
+RASTER_TARGET("avx2") __m256i Div255Avx2(__m256i x) {
+    x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+}
+
+RASTER_TARGET("avx2") void FillSolidAvx2(Uint32* dst, int count, Uint32 argb) {
+    __m256i color = _mm256_set1_epi32(static_cast<int>(argb));
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), color);
+    }
+    FillSolidSse2(dst + i, count - i, argb);
+}
+
+RASTER_TARGET("avx2") void FillBlendAvx2(Uint32* dst, int count, SDL_Color color) {
+    short a = color.a;
+    __m256i source = _mm256_set_epi16(255 * a, color.r * a, color.g * a, color.b * a,
+                                      255 * a, color.r * a, color.g * a, color.b * a,
+                                      255 * a, color.r * a, color.g * a, color.b * a,
+                                      255 * a, color.r * a, color.g * a, color.b * a);
+    __m256i inverse = _mm256_set1_epi16(static_cast<short>(255 - a));
+    __m256i zero = _mm256_setzero_si256();
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        __m256i lo = _mm256_unpacklo_epi8(pixels, zero);
+        __m256i hi = _mm256_unpackhi_epi8(pixels, zero);
+        lo = Div255Avx2(_mm256_add_epi16(_mm256_mullo_epi16(lo, inverse), source));
+        hi = Div255Avx2(_mm256_add_epi16(_mm256_mullo_epi16(hi, inverse), source));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_packus_epi16(lo, hi));
+    }
+    FillBlendSse2(dst + i, count - i, color);
+}
+
+RASTER_TARGET("avx2") __m256i BlendHalfAvx2(__m256i src, __m256i srcAlpha, __m256i dst) {
+    __m256i alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(srcAlpha, 0xFF), 0xFF);
+    __m256i inverse = _mm256_sub_epi16(_mm256_set1_epi16(255), alpha);
+    return Div255Avx2(_mm256_add_epi16(_mm256_mullo_epi16(src, alpha), _mm256_mullo_epi16(dst, inverse)));
+}
+
+RASTER_TARGET("avx2") void BlitBlendAvx2(Uint32* dst, const Uint32* src, int count) {
+    __m256i zero = _mm256_setzero_si256();
+    __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i source = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        __m256i alpha = _mm256_and_si256(source, alphaMask);
+
+        int transparent = _mm256_movemask_epi8(_mm256_cmpeq_epi32(alpha, zero));
+        if (transparent == -1) continue;
+        int opaque = _mm256_movemask_epi8(_mm256_cmpeq_epi32(alpha, alphaMask));
+        if (opaque == -1) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), source);
+            continue;
+        }
+
+        __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        __m256i opaqueSource = _mm256_or_si256(source, alphaMask);
+        __m256i lo = BlendHalfAvx2(_mm256_unpacklo_epi8(opaqueSource, zero), _mm256_unpacklo_epi8(source, zero),
+                                   _mm256_unpacklo_epi8(pixels, zero));
+        __m256i hi = BlendHalfAvx2(_mm256_unpackhi_epi8(opaqueSource, zero), _mm256_unpackhi_epi8(source, zero),
+                                   _mm256_unpackhi_epi8(pixels, zero));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_packus_epi16(lo, hi));
+    }
+    BlitBlendSse2(dst + i, src + i, count - i);
+}
+
+const Kernels AVX2_KERNELS = {FillSolidAvx2, FillBlendAvx2, BlitBlendAvx2};
+
+#endif // RASTER_X86
+
+Isa DetectIsa() {
+#ifdef RASTER_X86
+    if (SDL_HasAVX2()) return Isa::AVX2;
+    if (SDL_HasSSE2()) return Isa::SSE2;
+#endif
+    return Isa::SCALAR;
+}
+
+Isa& ActiveIsa() {
+    static Isa isa = DetectIsa();
+    return isa;
+}
+
+const Kernels& ActiveKernels() {
+    switch (ActiveIsa()) {
+#ifdef RASTER_X86
+        case Isa::AVX2: return AVX2_KERNELS;
+        case Isa::SSE2: return SSE2_KERNELS;
+#endif
+        default: return SCALAR_KERNELS;
+    }
+}
+
+// Row pointer into the target
+Uint32* PixelAt(const Target& target, int x, int y) {
+    return target.pixels + static_cast<ptrdiff_t>(y) * target.pitch + x;
+}
+
+} // namespace
+
+Target SurfaceTarget(SDL_Surface* surface) {
+    Target target;
+    target.pixels = static_cast<Uint32*>(surface->pixels);
+    target.pitch = surface->pitch / static_cast<int>(sizeof(Uint32));
+    target.clip = SDL_Rect{0, 0, surface->w, surface->h};
+    return target;
+}
+
+void FillSolid(const Target& target, const SDL_Rect& rect, SDL_Color color) {
+    SDL_Rect area;
+    if (!SDL_IntersectRect(&rect, &target.clip, &area)) return;
+
+    FillSolidRow fill = ActiveKernels().fillSolid;
+    Uint32 argb = PackColor(color);
+    for (int y = area.y; y < area.y + area.h; ++y) {
+        fill(PixelAt(target, area.x, y), area.w, argb);
+    }
+}
+
+void FillBlend(const Target& target, const SDL_Rect& rect, SDL_Color color) {
+    if (color.a == 0) return;
+    if (color.a == 255) {
+        FillSolid(target, rect, color);
+        return;
+    }
+
+    SDL_Rect area;
+    if (!SDL_IntersectRect(&rect, &target.clip, &area)) return;
+
+    FillBlendRow fill = ActiveKernels().fillBlend;
+    for (int y = area.y; y < area.y + area.h; ++y) {
+        fill(PixelAt(target, area.x, y), area.w, color);
+    }
+}
+
+void BlitBlend(const Target& target, int x, int y, const SDL_Surface* source, const SDL_Rect& srcRect) {
+    // Source rect inside the source, then the destination inside the clip
+    SDL_Rect sourceBounds = {0, 0, source->w, source->h};
+    SDL_Rect from;
+    if (!SDL_IntersectRect(&srcRect, &sourceBounds, &from)) return;
+
+    SDL_Rect dest = {x + from.x - srcRect.x, y + from.y - srcRect.y, from.w, from.h};
+    SDL_Rect area;
+    if (!SDL_IntersectRect(&dest, &target.clip, &area)) return;
+
+    int sourceX = from.x + area.x - dest.x;
+    int sourceY = from.y + area.y - dest.y;
+    int sourcePitch = source->pitch / static_cast<int>(sizeof(Uint32));
+    const Uint32* sourceRow = static_cast<const Uint32*>(source->pixels) +
+                              static_cast<ptrdiff_t>(sourceY) * sourcePitch + sourceX;
+
+    BlitBlendRow blit = ActiveKernels().blitBlend;
+    for (int row = 0; row < area.h; ++row, sourceRow += sourcePitch) {
+        blit(PixelAt(target, area.x, area.y + row), sourceRow, area.w);
+    }
+}
+
+Isa GetIsa() {
+    return ActiveIsa();
+}
+
+bool IsSupported(Isa isa) {
+    switch (isa) {
+#ifdef RASTER_X86
+        case Isa::AVX2: return SDL_HasAVX2();
+        case Isa::SSE2: return SDL_HasSSE2();
+#endif
+        case Isa::SCALAR: return true;
+        default: return false;
+    }
+}
+
+void SetIsa(Isa isa) {
+    if (IsSupported(isa)) ActiveIsa() = isa;
+}
+
+const char* GetIsaName(Isa isa) {
+    switch (isa) {
+        case Isa::AVX2: return "AVX2";
+        case Isa::SSE2: return "SSE2";
+        default: return "scalar";
+    }
+}
+
+} // namespace Raster
@@ -1,30 +1,137 @@
 #include "Renderer.h"
 #include "TextRenderer.h"
+#include "SpriteCache.h"
+#include <algorithm>
 #include <iostream>
+#include <thread>
+
+namespace {
+
+bool RectsOverlap(const SDL_Rect& a, const SDL_Rect& b) {
+    return a.x < b.x + b.w && a.x + a.w > b.x &&
+           a.y < b.y + b.h && a.y + a.h > b.y;
+}
+
+void ExpandRect(SDL_Rect& bounds, const SDL_Rect& rect) {
+    int right = std::max(bounds.x + bounds.w, rect.x + rect.w);
+    int bottom = std::max(bounds.y + bounds.h, rect.y + rect.h);
+    bounds.x = std::min(bounds.x, rect.x);
+    bounds.y = std::min(bounds.y, rect.y);
+    bounds.w = right - bounds.x;
+    bounds.h = bottom - bounds.y;
+}
+
+// Drawn where a texture is still loading
+const SDL_Color PLACEHOLDER_COLOR = {128, 128, 128, 96};
+
+bool SameColor(SDL_Color a, SDL_Color b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+// Overlapping or sharing an edge
+bool RectsTouch(const SDL_Rect& a, const SDL_Rect& b) {
+    return a.x <= b.x + b.w && a.x + a.w >= b.x &&
+           a.y <= b.y + b.h && a.y + a.h >= b.y;
+}
+
+} // namespace
 
 Renderer::Renderer() 
-    : renderer_(nullptr), window_width_(0), window_height_(0) {
+    : renderer_(nullptr), window_(nullptr), framebuffer_(nullptr), vsync_(false), window_width_(0), window_height_(0),
+      cull_rect_{0, 0, 0, 0}, clip_rect_{0, 0, 0, 0}, clip_enabled_(false),
+      batch_count_(0), use_geometry_(false), blend_mode_(SDL_BLENDMODE_BLEND),
+      current_color_{0, 0, 0, 0}, current_blend_mode_(SDL_BLENDMODE_BLEND), draw_color_valid_(false),
+      render_target_(nullptr), recording_(nullptr),
+      window_renderer_(nullptr), screen_texture_(nullptr), pixel_scale_(1),
+      dirty_tracking_(false), present_to_window_(false), full_redraw_(true) {
 }
 
 Renderer::~Renderer() {
     Shutdown();
 }
 
-bool Renderer::Initialize(SDL_Window* window) {
-    renderer_ = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+bool Renderer::Initialize(SDL_Window* window, bool headless, bool dirtyRects, int pixelScale) {
+    window_ = window;
+    SDL_GetWindowSize(window, &window_width_, &window_height_);
+    pixel_scale_ = std::max(1, pixelScale);
+    bool indexed = pixel_scale_ > 1;
+    
+    if (headless || dirtyRects || indexed) {
+        // No display or GPU: draw into our own surface so frames are reproducible.
+        // It persists between frames, so it also serves as the dirty rect backbuffer.
+        framebuffer_ = SDL_CreateRGBSurfaceWithFormat(0, window_width_ / pixel_scale_, window_height_ / pixel_scale_,
+                                                      32, SDL_PIXELFORMAT_ARGB8888);
+        if (!framebuffer_) {
+            std::cerr << "SDL_CreateRGBSurfaceWithFormat Error: " << SDL_GetError() << std::endl;
+            return false;
+        }
+        SDL_SetSurfaceBlendMode(framebuffer_, SDL_BLENDMODE_NONE);
+        renderer_ = SDL_CreateSoftwareRenderer(framebuffer_);
+        dirty_tracking_ = dirtyRects && !indexed;
+        present_to_window_ = dirty_tracking_ && !headless;
+    } else {
+        renderer_ = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    }
     if (!renderer_) {
         std::cerr << "SDL_CreateRenderer Error: " << SDL_GetError() << std::endl;
         return false;
     }
     
+    if (indexed) {
+        // Everything is drawn in window coordinates and scaled down by SDL;
+        // render targets are unaffected, SDL resets the scale while one is bound
+        SDL_RenderSetScale(renderer_, 1.0f / pixel_scale_, 1.0f / pixel_scale_);
+        indexed_framebuffer_ = std::make_unique<IndexedFramebuffer>();
+        indexed_framebuffer_->Initialize(framebuffer_->w, framebuffer_->h);
+        
+        if (!headless) {
+            window_renderer_ = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+            if (!window_renderer_) {
+                std::cerr << "SDL_CreateRenderer Error: " << SDL_GetError() << std::endl;
+                return false;
+            }
+            screen_texture_ = SDL_CreateTexture(window_renderer_, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING,
+                                                framebuffer_->w, framebuffer_->h);
+            if (!screen_texture_) {
+                std::cerr << "SDL_CreateTexture Error: " << SDL_GetError() << std::endl;
+                return false;
+            }
+#if SDL_VERSION_ATLEAST(2, 0, 12)
+            // Hard pixel edges whatever the scale quality hint says
+            SDL_SetTextureScaleMode(screen_texture_, SDL_ScaleModeNearest);
+#endif
+        }
+    }
+    
+    // The driver may not honor the vsync request
+    SDL_RendererInfo info;
+    SDL_Renderer* presenter = window_renderer_ ? window_renderer_ : renderer_;
+    vsync_ = SDL_GetRendererInfo(presenter, &info) == 0 && (info.flags & SDL_RENDERER_PRESENTVSYNC);
+    
     // Enable alpha blending
     SDL_SetRenderDrawBlendMode(renderer_, SDL_BLENDMODE_BLEND);
+    current_blend_mode_ = SDL_BLENDMODE_BLEND;
     
-    SDL_GetWindowSize(window, &window_width_, &window_height_);
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    // Flush the whole rect buffer as one vertex-colored geometry call where possible
+    use_geometry_ = true;
+#endif
+    
+    ResetCullRect();
+    
+    sprite_cache_ = std::make_unique<SpriteCache>();
     
-    // Initialize text renderer
+    // Decode on worker threads, leave a core for the main thread
+    int loaderThreads = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+    loaderThreads = std::max(1, std::min(loaderThreads, static_cast<int>(MAX_LOADER_THREADS)));
+    asset_loader_ = std::make_unique<AssetLoader>();
+    asset_loader_->Initialize(loaderThreads);
+    texture_cache_ = std::make_unique<TextureCache>();
+    texture_cache_->Initialize(renderer_, asset_loader_.get(), DEFAULT_TEXTURE_BUDGET);
+    
+    // Initialize text renderer (fonts arrive through the asset loader)
     text_renderer_ = std::make_unique<TextRenderer>();
-    if (!text_renderer_->Initialize(renderer_)) {
+    if (!text_renderer_->Initialize(renderer_, asset_loader_.get())) {
         std::cerr << "Warning: TextRenderer initialization failed, falling back to basic rendering" << std::endl;
         text_renderer_.reset();
     }
@@ -33,47 +140,270 @@ bool Renderer::Initialize(SDL_Window* window) {
 }
 
 void Renderer::Shutdown() {
-    text_renderer_.reset();
+    batch_count_ = 0;
     
-    for (auto& pair : texture_cache_) {
-        SDL_DestroyTexture(pair.second);
-    }
-    texture_cache_.clear();
+    // Stop the workers first so no load completes into a half torn down renderer
+    asset_loader_.reset();
+    text_renderer_.reset();
+    sprite_cache_.reset();
+    sprite_atlas_.Unload();
+    texture_cache_.reset();
     
     if (renderer_) {
         SDL_DestroyRenderer(renderer_);
         renderer_ = nullptr;
     }
+    
+    indexed_framebuffer_.reset();
+    if (screen_texture_) {
+        SDL_DestroyTexture(screen_texture_);
+        screen_texture_ = nullptr;
+    }
+    if (window_renderer_) {
+        SDL_DestroyRenderer(window_renderer_);
+        window_renderer_ = nullptr;
+    }
+    
+    if (framebuffer_) {
+        SDL_FreeSurface(framebuffer_);
+        framebuffer_ = nullptr;
+    }
 }
 
 void Renderer::Clear() {
-    SDL_SetRenderDrawColor(renderer_, 173, 216, 230, 255); // Ghibli soft powder blue sky
-    SDL_RenderClear(renderer_);
+    Clear(SDL_Color{173, 216, 230, 255}); // Ghibli soft powder blue sky
+}
+
+void Renderer::Clear(SDL_Color color) {
+    FlushRects();
+    SDL_SetRenderDrawColor(renderer_, color.r, color.g, color.b, color.a);
+    
+    // RenderClear ignores the clip rect, a partial redraw fills just its region
+    if (clip_enabled_ && !render_target_) {
+        SDL_SetRenderDrawBlendMode(renderer_, SDL_BLENDMODE_NONE);
+        SDL_RenderFillRect(renderer_, &clip_rect_);
+        SDL_SetRenderDrawBlendMode(renderer_, current_blend_mode_);
+    } else {
+        SDL_RenderClear(renderer_);
+    }
+    InvalidateDrawColor();
 }
 
 void Renderer::Present() {
+    FlushRects();
     SDL_RenderPresent(renderer_);
+    
+    if (indexed_framebuffer_) {
+        indexed_framebuffer_->Quantize(framebuffer_);
+        if (window_renderer_) PresentIndexed();
+    }
+    
+    // Copy only what was redrawn onto the window
+    if (present_to_window_ && !dirty_regions_.empty()) {
+        SDL_Surface* windowSurface = SDL_GetWindowSurface(window_);
+        if (windowSurface) {
+            for (const SDL_Rect& region : dirty_regions_) {
+                SDL_Rect source = region;
+                SDL_Rect dest = region;
+                SDL_BlitSurface(framebuffer_, &source, windowSurface, &dest);
+            }
+            SDL_UpdateWindowSurfaceRects(window_, dirty_regions_.data(), static_cast<int>(dirty_regions_.size()));
+        } else {
+            std::cerr << "SDL_GetWindowSurface Error: " << SDL_GetError() << std::endl;
+        }
+    }
+    dirty_rects_.clear();
+    dirty_regions_.clear();
+    full_redraw_ = false;
+    
+    last_frame_stats_ = frame_stats_;
+    frame_stats_ = RenderStats();
 }
 
-SDL_Texture* Renderer::LoadTexture(const std::string& path) {
-    auto it = texture_cache_.find(path);
-    if (it != texture_cache_.end()) {
-        return it->second;
+void Renderer::SetPaletteTint(SDL_Color tint) {
+    if (indexed_framebuffer_) indexed_framebuffer_->SetTint(tint);
+}
+
+SDL_Rect Renderer::GetIndexedDestRect() const {
+    // Largest whole multiple of the native size that fits, centered
+    int width = indexed_framebuffer_->GetWidth();
+    int height = indexed_framebuffer_->GetHeight();
+    int scale = std::max(1, std::min(window_width_ / width, window_height_ / height));
+    return SDL_Rect{(window_width_ - width * scale) / 2, (window_height_ - height * scale) / 2,
+                    width * scale, height * scale};
+}
+
+void Renderer::PresentIndexed() {
+    void* pixels = nullptr;
+    int pitch = 0;
+    if (SDL_LockTexture(screen_texture_, nullptr, &pixels, &pitch) != 0) {
+        std::cerr << "SDL_LockTexture Error: " << SDL_GetError() << std::endl;
+        return;
     }
+    indexed_framebuffer_->Expand(pixels, pitch, 1);
+    SDL_UnlockTexture(screen_texture_);
     
-    SDL_Texture* texture = IMG_LoadTexture(renderer_, path.c_str());
-    if (!texture) {
-        std::cerr << "IMG_LoadTexture Error: " << IMG_GetError() << std::endl;
+    // The one full resolution pass: a nearest neighbour upscale
+    SDL_Rect dest = GetIndexedDestRect();
+    SDL_SetRenderDrawColor(window_renderer_, 0, 0, 0, 255);
+    SDL_RenderClear(window_renderer_);
+    SDL_RenderCopy(window_renderer_, screen_texture_, nullptr, &dest);
+    SDL_RenderPresent(window_renderer_);
+}
+
+void Renderer::MarkDirty(const Rect& screenRect) {
+    if (screenRect.w <= 0 || screenRect.h <= 0) return;
+    dirty_rects_.push_back(SDL_Rect{screenRect.x, screenRect.y, screenRect.w, screenRect.h});
+}
+
+const std::vector<SDL_Rect>& Renderer::BuildDirtyRegions() {
+    SDL_Rect screen = {0, 0, window_width_, window_height_};
+    dirty_regions_.clear();
+    
+    if (!full_redraw_) {
+        for (const SDL_Rect& rect : dirty_rects_) {
+            SDL_Rect region;
+            if (!SDL_IntersectRect(&rect, &screen, &region)) continue;
+            
+            // Absorb every region this one touches; the grown one may reach more
+            bool absorbed = true;
+            while (absorbed) {
+                absorbed = false;
+                for (size_t i = 0; i < dirty_regions_.size(); ++i) {
+                    if (RectsTouch(dirty_regions_[i], region)) {
+                        ExpandRect(region, dirty_regions_[i]);
+                        dirty_regions_[i] = dirty_regions_.back();
+                        dirty_regions_.pop_back();
+                        absorbed = true;
+                        break;
+                    }
+                }
+            }
+            dirty_regions_.push_back(region);
+        }
+        
+        // Many small passes over the draw list cost more than one full one
+        int area = 0;
+        for (const SDL_Rect& region : dirty_regions_) {
+            area += region.w * region.h;
+        }
+        if (static_cast<int>(dirty_regions_.size()) > MAX_DIRTY_REGIONS ||
+            area * 100 > window_width_ * window_height_ * FULL_REDRAW_PERCENT) {
+            full_redraw_ = true;
+        }
+    }
+    
+    if (full_redraw_) {
+        dirty_regions_.assign(1, screen);
+    }
+    
+    for (const SDL_Rect& region : dirty_regions_) {
+        frame_stats_.regionsRedrawn++;
+        frame_stats_.pixelsRedrawn += region.w * region.h;
+    }
+    return dirty_regions_;
+}
+
+void Renderer::SetClipRect(const SDL_Rect* rect) {
+    FlushRects();
+    SDL_RenderSetClipRect(renderer_, rect);
+    clip_enabled_ = rect != nullptr;
+    if (rect) clip_rect_ = *rect;
+    
+    if (!render_target_) ResetCullRect();
+}
+
+void Renderer::ResetCullRect() {
+    if (render_target_) {
+        cull_rect_.x = 0;
+        cull_rect_.y = 0;
+        SDL_QueryTexture(render_target_, nullptr, nullptr, &cull_rect_.w, &cull_rect_.h);
+    } else if (clip_enabled_) {
+        cull_rect_ = clip_rect_;
+    } else {
+        cull_rect_ = SDL_Rect{0, 0, window_width_, window_height_};
+    }
+}
+
+SDL_Surface* Renderer::ReadFramebuffer() {
+    FlushRects();
+    
+    // What the window shows: the 8-bit frame through the palette, upscaled
+    if (indexed_framebuffer_) {
+        SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, window_width_, window_height_, 32, SDL_PIXELFORMAT_ARGB8888);
+        if (!surface) {
+            std::cerr << "SDL_CreateRGBSurfaceWithFormat Error: " << SDL_GetError() << std::endl;
+            return nullptr;
+        }
+        
+        SDL_RenderFlush(renderer_);
+        indexed_framebuffer_->Quantize(framebuffer_);
+        
+        SDL_FillRect(surface, nullptr, 0xFF000000);
+        SDL_Rect dest = GetIndexedDestRect();
+        Uint8* pixels = static_cast<Uint8*>(surface->pixels) + dest.y * surface->pitch + dest.x * sizeof(Uint32);
+        indexed_framebuffer_->Expand(pixels, surface->pitch, dest.w / indexed_framebuffer_->GetWidth());
+        return surface;
+    }
+    
+    return ReadPixels(window_width_, window_height_);
+}
+
+SDL_Surface* Renderer::ReadRenderTarget() {
+    if (!render_target_) return nullptr;
+    FlushRects();
+    
+    int width = 0;
+    int height = 0;
+    SDL_QueryTexture(render_target_, nullptr, nullptr, &width, &height);
+    return ReadPixels(width, height);
+}
+
+SDL_Surface* Renderer::ReadPixels(int width, int height) {
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!surface) {
+        std::cerr << "SDL_CreateRGBSurfaceWithFormat Error: " << SDL_GetError() << std::endl;
         return nullptr;
     }
     
-    texture_cache_[path] = texture;
-    return texture;
+    if (SDL_RenderReadPixels(renderer_, nullptr, SDL_PIXELFORMAT_ARGB8888, surface->pixels, surface->pitch) != 0) {
+        std::cerr << "SDL_RenderReadPixels Error: " << SDL_GetError() << std::endl;
+        SDL_FreeSurface(surface);
+        return nullptr;
+    }
+    
+    return surface;
+}
+
+TextureHandle Renderer::LoadTexture(const std::string& path) {
+    return texture_cache_ ? texture_cache_->Acquire(path) : INVALID_TEXTURE_HANDLE;
+}
+
+void Renderer::ReleaseTexture(TextureHandle handle) {
+    if (texture_cache_) texture_cache_->Release(handle);
+}
+
+void Renderer::DrawTexture(TextureHandle texture, const Vector2& position, const Rect* srcRect) {
+    if (SDL_Texture* resolved = GetTexture(texture)) {
+        DrawTexture(resolved, position, srcRect);
+    } else if (srcRect && texture_cache_ && texture_cache_->IsLoading(texture)) {
+        DrawRect(Rect(static_cast<int>(position.x), static_cast<int>(position.y), srcRect->w, srcRect->h), PLACEHOLDER_COLOR);
+    }
 }
 
 void Renderer::DrawTexture(SDL_Texture* texture, const Vector2& position, const Rect* srcRect) {
     if (!texture) return;
     
+    if (IsRecording()) {
+        RecordedDraw draw = {};
+        draw.type = RecordedDraw::Type::TEXTURE;
+        draw.rect = {static_cast<int>(position.x), static_cast<int>(position.y), 0, 0};
+        draw.hasSrcRect = srcRect != nullptr;
+        if (srcRect) draw.srcRect = {srcRect->x, srcRect->y, srcRect->w, srcRect->h};
+        draw.texture = texture;
+        recording_->push_back(draw);
+    }
+    
     SDL_Rect destRect;
     destRect.x = static_cast<int>(position.x);
     destRect.y = static_cast<int>(position.y);
@@ -81,24 +411,290 @@ void Renderer::DrawTexture(SDL_Texture* texture, const Vector2& position, const
     if (srcRect) {
         destRect.w = srcRect->w;
         destRect.h = srcRect->h;
+    } else {
+        SDL_QueryTexture(texture, nullptr, nullptr, &destRect.w, &destRect.h);
+    }
+    
+    if (!IsOnScreen(destRect.x, destRect.y, destRect.w, destRect.h)) {
+        frame_stats_.drawsCulled++;
+        return;
+    }
+    
+    FlushRects();
+    frame_stats_.drawCalls++;
+    
+    if (srcRect) {
         SDL_Rect src = {srcRect->x, srcRect->y, srcRect->w, srcRect->h};
         SDL_RenderCopy(renderer_, texture, &src, &destRect);
     } else {
-        SDL_QueryTexture(texture, nullptr, nullptr, &destRect.w, &destRect.h);
         SDL_RenderCopy(renderer_, texture, nullptr, &destRect);
     }
 }
 
+void Renderer::DrawTextureStretched(SDL_Texture* texture, const Rect& destRect, const Rect* srcRect) {
+    if (!texture || destRect.w <= 0 || destRect.h <= 0) return;
+    
+    if (IsRecording()) {
+        RecordedDraw draw = {};
+        draw.type = RecordedDraw::Type::TEXTURE;
+        draw.rect = {destRect.x, destRect.y, destRect.w, destRect.h};
+        draw.hasSrcRect = srcRect != nullptr;
+        if (srcRect) draw.srcRect = {srcRect->x, srcRect->y, srcRect->w, srcRect->h};
+        draw.texture = texture;
+        recording_->push_back(draw);
+    }
+    
+    if (!IsOnScreen(destRect.x, destRect.y, destRect.w, destRect.h)) {
+        frame_stats_.drawsCulled++;
+        return;
+    }
+    
+    FlushRects();
+    frame_stats_.drawCalls++;
+    
+    SDL_Rect dest = {destRect.x, destRect.y, destRect.w, destRect.h};
+    if (srcRect) {
+        SDL_Rect src = {srcRect->x, srcRect->y, srcRect->w, srcRect->h};
+        SDL_RenderCopy(renderer_, texture, &src, &dest);
+    } else {
+        SDL_RenderCopy(renderer_, texture, nullptr, &dest);
+    }
+}
+
 void Renderer::DrawRect(const Rect& rect, SDL_Color color) {
-    SDL_SetRenderDrawColor(renderer_, color.r, color.g, color.b, color.a);
+    if (rect.w <= 0 || rect.h <= 0) return;
+    
+    if (IsRecording()) {
+        RecordedDraw draw = {};
+        draw.type = RecordedDraw::Type::RECT;
+        draw.rect = {rect.x, rect.y, rect.w, rect.h};
+        draw.color = color;
+        draw.blendMode = blend_mode_;
+        recording_->push_back(draw);
+    }
+    
+    if (!IsOnScreen(rect.x, rect.y, rect.w, rect.h)) {
+        frame_stats_.drawsCulled++;
+        return;
+    }
+    
     SDL_Rect sdlRect = {rect.x, rect.y, rect.w, rect.h};
-    SDL_RenderFillRect(renderer_, &sdlRect);
+    QueueRect(sdlRect, color);
 }
 
-void Renderer::DrawTile(SDL_Texture* texture, int tileIndex, const Vector2& position, int tileSize) {
-    if (!texture) return;
+void Renderer::QueueRect(const SDL_Rect& rect, SDL_Color color) {
+    frame_stats_.rectsSubmitted++;
+    
+    // Walk back through recent batches looking for one with the same state. The rect may
+    // only join an earlier batch if nothing queued after that batch overlaps it, so
+    // painter's order is preserved.
+    int lookback = 0;
+    for (size_t i = batch_count_; i-- > 0 && lookback < MAX_BATCH_LOOKBACK; ++lookback) {
+        RectBatch& batch = rect_batches_[i];
+        if (batch.blendMode == blend_mode_ && SameColor(batch.color, color)) {
+            batch.rects.push_back(rect);
+            ExpandRect(batch.bounds, rect);
+            return;
+        }
+        
+        if (RectsOverlap(batch.bounds, rect)) {
+            bool blocked = false;
+            for (const auto& queued : batch.rects) {
+                if (RectsOverlap(queued, rect)) {
+                    blocked = true;
+                    break;
+                }
+            }
+            if (blocked) break;
+        }
+    }
+    
+    if (batch_count_ == rect_batches_.size()) {
+        rect_batches_.emplace_back();
+    }
+    
+    RectBatch& batch = rect_batches_[batch_count_++];
+    batch.color = color;
+    batch.blendMode = blend_mode_;
+    batch.bounds = rect;
+    batch.rects.clear();
+    batch.rects.push_back(rect);
+}
+
+void Renderer::FlushRects() {
+    if (batch_count_ == 0) return;
+    
+    frame_stats_.rectBatches += static_cast<int>(batch_count_);
+    
+    if (UsesCpuRaster() && !render_target_) {
+        FlushRectsToFramebuffer();
+    } else {
+        size_t drawn = use_geometry_ ? FlushRectsAsGeometry() : 0;
+        for (size_t i = drawn; i < batch_count_; ++i) {
+            const RectBatch& batch = rect_batches_[i];
+            ApplyDrawState(batch.color, batch.blendMode);
+            SDL_RenderFillRects(renderer_, batch.rects.data(), static_cast<int>(batch.rects.size()));
+            frame_stats_.drawCalls++;
+        }
+    }
+    
+    batch_count_ = 0;
+}
+
+size_t Renderer::FlushRectsAsGeometry() {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    // Colors travel with the vertices, so a run of batches only needs splitting when
+    // the blend mode changes
+    size_t runStart = 0;
+    while (runStart < batch_count_) {
+        SDL_BlendMode runBlendMode = rect_batches_[runStart].blendMode;
+        size_t runEnd = runStart;
+        
+        geometry_vertices_.clear();
+        geometry_indices_.clear();
+        
+        for (; runEnd < batch_count_ && rect_batches_[runEnd].blendMode == runBlendMode; ++runEnd) {
+            const RectBatch& batch = rect_batches_[runEnd];
+            for (const auto& rect : batch.rects) {
+                int base = static_cast<int>(geometry_vertices_.size());
+                float left = static_cast<float>(rect.x);
+                float top = static_cast<float>(rect.y);
+                float right = static_cast<float>(rect.x + rect.w);
+                float bottom = static_cast<float>(rect.y + rect.h);
+                
+                geometry_vertices_.push_back({{left, top}, batch.color, {0.0f, 0.0f}});
+                geometry_vertices_.push_back({{right, top}, batch.color, {0.0f, 0.0f}});
+                geometry_vertices_.push_back({{right, bottom}, batch.color, {0.0f, 0.0f}});
+                geometry_vertices_.push_back({{left, bottom}, batch.color, {0.0f, 0.0f}});
+                
+                geometry_indices_.insert(geometry_indices_.end(),
+                    {base, base + 1, base + 2, base, base + 2, base + 3});
+            }
+        }
+        
+        if (current_blend_mode_ != runBlendMode) {
+            SDL_SetRenderDrawBlendMode(renderer_, runBlendMode);
+            current_blend_mode_ = runBlendMode;
+            frame_stats_.stateChanges++;
+        }
+        
+        if (SDL_RenderGeometry(renderer_, nullptr,
+                               geometry_vertices_.data(), static_cast<int>(geometry_vertices_.size()),
+                               geometry_indices_.data(), static_cast<int>(geometry_indices_.size())) != 0) {
+            // This run and the ones after it go through FillRects instead
+            if (runStart == 0) {
+                // Backend has no geometry support, stick to FillRects from now on
+                std::cerr << "SDL_RenderGeometry Error: " << SDL_GetError() << ", falling back to SDL_RenderFillRects" << std::endl;
+                use_geometry_ = false;
+            } else {
+                std::cerr << "SDL_RenderGeometry Error: " << SDL_GetError() << ", drawing the rest with SDL_RenderFillRects" << std::endl;
+            }
+            return runStart;
+        }
+        frame_stats_.drawCalls++;
+        
+        runStart = runEnd;
+    }
+    
+    return batch_count_;
+#else
+    return 0;
+#endif
+}
+
+void Renderer::FlushRectsToFramebuffer() {
+    // Whatever SDL still has queued goes underneath
+    SDL_RenderFlush(renderer_);
+    Raster::Target target = GetRasterTarget();
+    
+    for (size_t i = 0; i < batch_count_; ++i) {
+        const RectBatch& batch = rect_batches_[i];
+        
+        // The kernels only do replace and source-over
+        if (batch.blendMode != SDL_BLENDMODE_NONE && batch.blendMode != SDL_BLENDMODE_BLEND) {
+            ApplyDrawState(batch.color, batch.blendMode);
+            SDL_RenderFillRects(renderer_, batch.rects.data(), static_cast<int>(batch.rects.size()));
+            SDL_RenderFlush(renderer_);
+            frame_stats_.drawCalls++;
+            continue;
+        }
+        
+        for (const SDL_Rect& rect : batch.rects) {
+            SDL_Rect scaled = ScaleToFramebuffer(rect);
+            if (batch.blendMode == SDL_BLENDMODE_BLEND) {
+                Raster::FillBlend(target, scaled, batch.color);
+            } else {
+                Raster::FillSolid(target, scaled, batch.color);
+            }
+        }
+        frame_stats_.rasterCalls++;
+    }
+}
+
+Raster::Target Renderer::GetRasterTarget() const {
+    Raster::Target target = Raster::SurfaceTarget(framebuffer_);
+    if (clip_enabled_) {
+        SDL_Rect clip = ScaleToFramebuffer(clip_rect_);
+        if (!SDL_IntersectRect(&clip, &target.clip, &target.clip)) {
+            target.clip = SDL_Rect{0, 0, 0, 0};
+        }
+    }
+    return target;
+}
+
+SDL_Rect Renderer::ScaleToFramebuffer(const SDL_Rect& rect) const {
+    if (pixel_scale_ == 1) return rect;
+    
+    // Truncated like SDL's software renderer does under SDL_RenderSetScale
+    float scale = 1.0f / pixel_scale_;
+    return SDL_Rect{static_cast<int>(rect.x * scale), static_cast<int>(rect.y * scale),
+                    static_cast<int>(rect.w * scale), static_cast<int>(rect.h * scale)};
+}
+
+bool Renderer::BlitSurface(const SDL_Surface* source, const Rect& srcRect, const Vector2& position) {
+    if (!source || !UsesCpuRaster() || render_target_ || pixel_scale_ != 1 || IsRecording()) {
+        return false;
+    }
+    
+    int x = static_cast<int>(position.x);
+    int y = static_cast<int>(position.y);
+    if (!IsOnScreen(x, y, srcRect.w, srcRect.h)) {
+        frame_stats_.drawsCulled++;
+        return true;
+    }
     
-    int tilesPerRow = 10; // Assuming 10 tiles per row in spritesheet
+    // Keep painter's order with everything queued before it
+    FlushRects();
+    SDL_RenderFlush(renderer_);
+    
+    Raster::BlitBlend(GetRasterTarget(), x, y, source, SDL_Rect{srcRect.x, srcRect.y, srcRect.w, srcRect.h});
+    frame_stats_.rasterCalls++;
+    return true;
+}
+
+void Renderer::ApplyDrawState(SDL_Color color, SDL_BlendMode blendMode) {
+    if (!draw_color_valid_ || !SameColor(current_color_, color)) {
+        SDL_SetRenderDrawColor(renderer_, color.r, color.g, color.b, color.a);
+        current_color_ = color;
+        frame_stats_.stateChanges++;
+    }
+    
+    if (current_blend_mode_ != blendMode) {
+        SDL_SetRenderDrawBlendMode(renderer_, blendMode);
+        current_blend_mode_ = blendMode;
+        frame_stats_.stateChanges++;
+    }
+    
+    draw_color_valid_ = true;
+}
+
+void Renderer::DrawTile(TextureHandle texture, int tileIndex, const Vector2& position, int tileSize) {
+    // The layout needs the texture width; until then DrawTexture shows a placeholder tile
+    int textureWidth = 0;
+    if (SDL_Texture* resolved = GetTexture(texture)) {
+        SDL_QueryTexture(resolved, nullptr, nullptr, &textureWidth, nullptr);
+    }
+    int tilesPerRow = std::max(1, textureWidth / tileSize);
     int srcX = (tileIndex % tilesPerRow) * tileSize;
     int srcY = (tileIndex / tilesPerRow) * tileSize;
     
@@ -106,6 +702,34 @@ void Renderer::DrawTile(SDL_Texture* texture, int tileIndex, const Vector2& posi
     DrawTexture(texture, position, &srcRect);
 }
 
+bool Renderer::LoadSpriteAtlas(const std::string& indexPath) {
+    if (!sprite_atlas_.Load(texture_cache_.get(), indexPath)) {
+        return false;
+    }
+    
+    std::cout << "Loading " << sprite_atlas_.GetSpriteCount() << " sprites from "
+              << sprite_atlas_.GetPageCount() << " atlas page(s)" << std::endl;
+    return true;
+}
+
+void Renderer::DrawSprite(SpriteId sprite, const Vector2& position) {
+    const SpriteAtlas::Sprite* entry = sprite_atlas_.GetSprite(sprite);
+    if (!entry) return;
+    
+    Rect srcRect(entry->rect.x, entry->rect.y, entry->rect.w, entry->rect.h);
+    DrawTexture(sprite_atlas_.GetPage(entry->page), position, &srcRect);
+}
+
+void Renderer::DrawCachedSprite(SpriteSheet sheet, int frame, int facing, const Vector2& position) {
+    if (!sprite_cache_) return;
+    sprite_cache_->Draw(this, sheet, frame, facing, static_cast<int>(position.x), static_cast<int>(position.y));
+}
+
+void Renderer::DrawSpriteWorld(SpriteId sprite, const Vector2& worldPosition, const Vector2& cameraOffset) {
+    Vector2 screenPos(worldPosition.x - cameraOffset.x, worldPosition.y - cameraOffset.y);
+    DrawSprite(sprite, screenPos);
+}
+
 void Renderer::DrawTextureWorld(SDL_Texture* texture, const Vector2& worldPosition, const Vector2& cameraOffset, const Rect* srcRect) {
     Vector2 screenPos(worldPosition.x - cameraOffset.x, worldPosition.y - cameraOffset.y);
     DrawTexture(texture, screenPos, srcRect);
@@ -121,19 +745,145 @@ void Renderer::DrawRectWorld(const Rect& worldRect, const Vector2& cameraOffset,
     DrawRect(screenRect, color);
 }
 
-void Renderer::DrawTileWorld(SDL_Texture* texture, int tileIndex, const Vector2& worldPosition, const Vector2& cameraOffset, int tileSize) {
+void Renderer::DrawTileWorld(TextureHandle texture, int tileIndex, const Vector2& worldPosition, const Vector2& cameraOffset, int tileSize) {
     Vector2 screenPos(worldPosition.x - cameraOffset.x, worldPosition.y - cameraOffset.y);
     DrawTile(texture, tileIndex, screenPos, tileSize);
 }
 
+bool Renderer::IsVisibleWorld(const Rect& worldBounds, const Vector2& cameraOffset) const {
+    return IsOnScreen(worldBounds.x - static_cast<int>(cameraOffset.x),
+                      worldBounds.y - static_cast<int>(cameraOffset.y),
+                      worldBounds.w, worldBounds.h);
+}
+
+bool Renderer::CullTile(const Rect& worldBounds, const Vector2& cameraOffset) {
+    if (IsVisibleWorld(worldBounds, cameraOffset)) return false;
+    
+    frame_stats_.tilesCulled++;
+    return true;
+}
+
+bool Renderer::CullObject(const Rect& worldBounds, const Vector2& cameraOffset) {
+    if (IsVisibleWorld(worldBounds, cameraOffset)) return false;
+    
+    frame_stats_.objectsCulled++;
+    return true;
+}
+
+bool Renderer::SupportsRenderTargets() const {
+    return renderer_ && SDL_RenderTargetSupported(renderer_);
+}
+
+SDL_Texture* Renderer::CreateRenderTarget(int width, int height, bool transparent) {
+    SDL_Texture* target = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!target) {
+        std::cerr << "SDL_CreateTexture Error: " << SDL_GetError() << std::endl;
+        return nullptr;
+    }
+    
+    // Baked world content is opaque, so skip blending when it is copied back
+    SDL_SetTextureBlendMode(target, transparent ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+    return target;
+}
+
+SDL_Texture* Renderer::CreateStreamingTexture(int width, int height) {
+    SDL_Texture* texture = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, width, height);
+    if (!texture) {
+        std::cerr << "SDL_CreateTexture Error: " << SDL_GetError() << std::endl;
+    }
+    return texture;
+}
+
+bool Renderer::SetRenderTarget(SDL_Texture* target) {
+    FlushRects();
+    
+    if (SDL_SetRenderTarget(renderer_, target) != 0) {
+        std::cerr << "SDL_SetRenderTarget Error: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    
+    render_target_ = target;
+    
+    // Cull against the target rather than the window while it is bound. SDL
+    // keeps the screen's clip rect aside meanwhile.
+    ResetCullRect();
+    
+    return true;
+}
+
 void Renderer::RenderText(const std::string& text, int x, int y, SDL_Color color, int fontSize) {
+    if (IsRecording()) {
+        RecordedDraw draw = {};
+        draw.type = RecordedDraw::Type::TEXT;
+        draw.rect = {x, y, 0, 0};
+        draw.color = color;
+        draw.fontSize = fontSize;
+        draw.text = text;
+        recording_->push_back(draw);
+    }
+    
     if (text_renderer_) {
+        FlushRects();
         text_renderer_->RenderText(text, x, y, color, fontSize);
+        frame_stats_.drawCalls++;
+        InvalidateDrawColor();
     }
 }
 
 void Renderer::RenderWrappedText(const std::string& text, int x, int y, int maxWidth, SDL_Color color, int fontSize) {
+    if (IsRecording()) {
+        RecordedDraw draw = {};
+        draw.type = RecordedDraw::Type::WRAPPED_TEXT;
+        draw.rect = {x, y, maxWidth, 0};
+        draw.color = color;
+        draw.fontSize = fontSize;
+        draw.text = text;
+        recording_->push_back(draw);
+    }
+    
     if (text_renderer_) {
+        FlushRects();
         text_renderer_->RenderWrappedText(text, x, y, maxWidth, color, fontSize);
+        frame_stats_.drawCalls++;
+        InvalidateDrawColor();
+    }
+}
+
+void Renderer::BeginRecording(DrawRecording* recording) {
+    recording_ = recording;
+    if (recording_) {
+        recording_->clear();
     }
-}
\ No newline at end of file
+}
+
+void Renderer::Replay(const DrawRecording& recording) {
+    SDL_BlendMode savedBlendMode = blend_mode_;
+    
+    for (const RecordedDraw& draw : recording) {
+        switch (draw.type) {
+            case RecordedDraw::Type::RECT:
+                blend_mode_ = draw.blendMode;
+                DrawRect(Rect(draw.rect.x, draw.rect.y, draw.rect.w, draw.rect.h), draw.color);
+                break;
+            case RecordedDraw::Type::TEXTURE: {
+                Rect srcRect(draw.srcRect.x, draw.srcRect.y, draw.srcRect.w, draw.srcRect.h);
+                if (draw.rect.w > 0) {
+                    Rect destRect(draw.rect.x, draw.rect.y, draw.rect.w, draw.rect.h);
+                    DrawTextureStretched(draw.texture, destRect, draw.hasSrcRect ? &srcRect : nullptr);
+                    break;
+                }
+                Vector2 position(static_cast<float>(draw.rect.x), static_cast<float>(draw.rect.y));
+                DrawTexture(draw.texture, position, draw.hasSrcRect ? &srcRect : nullptr);
+                break;
+            }
+            case RecordedDraw::Type::TEXT:
+                RenderText(draw.text, draw.rect.x, draw.rect.y, draw.color, draw.fontSize);
+                break;
+            case RecordedDraw::Type::WRAPPED_TEXT:
+                RenderWrappedText(draw.text, draw.rect.x, draw.rect.y, draw.rect.w, draw.color, draw.fontSize);
+                break;
+        }
+    }
+    
+    blend_mode_ = savedBlendMode;
+}
@@ -0,0 +1,87 @@
+#include "SpriteAtlas.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+SpriteAtlas::SpriteAtlas()
+    : cache_(nullptr) {
+}
+
+SpriteAtlas::~SpriteAtlas() {
+    Unload();
+}
+
+bool SpriteAtlas::Load(TextureCache* cache, const std::string& indexPath) {
+    Unload();
+    cache_ = cache;
+
+    std::ifstream index(indexPath);
+    if (!index) {
+        std::cerr << "Warning: Sprite atlas index not found: " << indexPath << std::endl;
+        return false;
+    }
+
+    std::string directory;
+    size_t slash = indexPath.find_last_of("/\\");
+    if (slash != std::string::npos) {
+        directory = indexPath.substr(0, slash + 1);
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(index, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == '#') continue;
+
+        std::istringstream fields(line);
+        std::string kind;
+        fields >> kind;
+
+        if (kind == "page") {
+            std::string fileName;
+            fields >> fileName;
+
+            pages_.push_back(cache->Acquire(directory + fileName));
+        } else if (kind == "sprite") {
+            std::string name;
+            Sprite sprite;
+            if (!(fields >> name >> sprite.page >> sprite.rect.x >> sprite.rect.y >> sprite.rect.w >> sprite.rect.h) ||
+                sprite.page < 0 || sprite.page >= static_cast<int>(pages_.size())) {
+                std::cerr << "Warning: Bad sprite entry at " << indexPath << ":" << lineNumber << std::endl;
+                continue;
+            }
+
+            ids_[name] = static_cast<SpriteId>(sprites_.size());
+            sprites_.push_back(sprite);
+        }
+    }
+
+    return true;
+}
+
+void SpriteAtlas::Unload() {
+    if (cache_) {
+        for (TextureHandle page : pages_) {
+            cache_->Release(page);
+        }
+        cache_ = nullptr;
+    }
+    pages_.clear();
+    sprites_.clear();
+    ids_.clear();
+}
+
+SpriteId SpriteAtlas::GetSpriteId(const std::string& name) const {
+    auto it = ids_.find(name);
+    return it != ids_.end() ? it->second : INVALID_SPRITE;
+}
+
+const SpriteAtlas::Sprite* SpriteAtlas::GetSprite(SpriteId id) const {
+    if (id < 0 || id >= static_cast<SpriteId>(sprites_.size())) return nullptr;
+    return &sprites_[id];
+}
+
+TextureHandle SpriteAtlas::GetPage(int page) const {
+    if (page < 0 || page >= static_cast<int>(pages_.size())) return INVALID_TEXTURE_HANDLE;
+    return pages_[page];
+}
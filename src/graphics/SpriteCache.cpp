@@ -0,0 +1,105 @@
+#include "SpriteCache.h"
+#include <iostream>
+
+SpriteCache::SpriteCache() {
+}
+
+SpriteCache::~SpriteCache() {
+    Invalidate();
+}
+
+void SpriteCache::Define(SpriteSheet sheet, const SpriteSheetDesc& desc) {
+    Entry& entry = sheets_[static_cast<int>(sheet)];
+    if (entry.texture) {
+        SDL_DestroyTexture(entry.texture);
+    }
+    if (entry.pixels) {
+        SDL_FreeSurface(entry.pixels);
+    }
+    
+    entry = Entry();
+    entry.desc = desc;
+    entry.defined = desc.paint != nullptr && desc.frames > 0 && desc.facings > 0;
+}
+
+void SpriteCache::Draw(Renderer* renderer, SpriteSheet sheet, int frame, int facing, int screenX, int screenY) {
+    Entry& entry = sheets_[static_cast<int>(sheet)];
+    if (!entry.defined) return;
+    
+    const SpriteSheetDesc& desc = entry.desc;
+    if (frame < 0 || frame >= desc.frames) frame = 0;
+    if (facing < 0 || facing >= desc.facings) facing = 0;
+    
+    if (!entry.texture && !entry.bakeFailed) {
+        entry.bakeFailed = !Bake(renderer, entry);
+    }
+    
+    if (!entry.texture) {
+        desc.paint(renderer, screenX, screenY, frame, facing);
+        return;
+    }
+    
+    Rect cell(frame * desc.cellWidth, facing * desc.cellHeight, desc.cellWidth, desc.cellHeight);
+    Vector2 position(static_cast<float>(screenX - desc.originX), static_cast<float>(screenY - desc.originY));
+    
+    // Software renderers blend straight from the CPU copy
+    if (entry.pixels && renderer->BlitSurface(entry.pixels, cell, position)) return;
+    renderer->DrawTexture(entry.texture, position, &cell);
+}
+
+Rect SpriteCache::GetCellBounds(SpriteSheet sheet, int x, int y) const {
+    const SpriteSheetDesc& desc = sheets_[static_cast<int>(sheet)].desc;
+    return Rect(x - desc.originX, y - desc.originY, desc.cellWidth, desc.cellHeight);
+}
+
+bool SpriteCache::Bake(Renderer* renderer, Entry& entry) {
+    // Sheets are baked lazily, possibly mid-frame; only bake onto the screen pass
+    if (!renderer->SupportsRenderTargets() || renderer->GetRenderTarget()) {
+        return false;
+    }
+    
+    const SpriteSheetDesc& desc = entry.desc;
+    SDL_Texture* texture = renderer->CreateRenderTarget(desc.cellWidth * desc.frames,
+                                                        desc.cellHeight * desc.facings, true);
+    if (!texture) {
+        return false;
+    }
+    
+    renderer->SetRenderTarget(texture);
+    renderer->Clear(SDL_Color{0, 0, 0, 0});
+    for (int facing = 0; facing < desc.facings; ++facing) {
+        for (int frame = 0; frame < desc.frames; ++frame) {
+            desc.paint(renderer, frame * desc.cellWidth + desc.originX,
+                       facing * desc.cellHeight + desc.originY, frame, facing);
+        }
+    }
+    if (renderer->UsesCpuRaster()) {
+        entry.pixels = renderer->ReadRenderTarget();
+    }
+    renderer->SetRenderTarget(nullptr);
+    
+    entry.texture = texture;
+    return true;
+}
+
+void SpriteCache::Invalidate() {
+    for (Entry& entry : sheets_) {
+        if (entry.texture) {
+            SDL_DestroyTexture(entry.texture);
+            entry.texture = nullptr;
+        }
+        if (entry.pixels) {
+            SDL_FreeSurface(entry.pixels);
+            entry.pixels = nullptr;
+        }
+        entry.bakeFailed = false;
+    }
+}
+
+int SpriteCache::GetBakedSheetCount() const {
+    int count = 0;
+    for (const Entry& entry : sheets_) {
+        if (entry.texture) count++;
+    }
+    return count;
+}
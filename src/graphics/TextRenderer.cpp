@@ -1,6 +1,82 @@
 #include "TextRenderer.h"
+#include <algorithm>
+#include <cctype>
 #include <iostream>
-#include <sstream>
+
+namespace {
+
+// Decodes one UTF-8 sequence starting at index and advances past it.
+// Malformed input yields U+FFFD so a bad byte never stalls the loop.
+Uint32 DecodeUtf8(const std::string& text, size_t& index) {
+    const unsigned char lead = static_cast<unsigned char>(text[index++]);
+    if (lead < 0x80) return lead;
+    
+    int extraBytes;
+    Uint32 codepoint;
+    if ((lead & 0xE0) == 0xC0) {
+        extraBytes = 1;
+        codepoint = lead & 0x1F;
+    } else if ((lead & 0xF0) == 0xE0) {
+        extraBytes = 2;
+        codepoint = lead & 0x0F;
+    } else if ((lead & 0xF8) == 0xF0) {
+        extraBytes = 3;
+        codepoint = lead & 0x07;
+    } else {
+        return 0xFFFD;
+    }
+    
+    for (int i = 0; i < extraBytes; ++i) {
+        if (index >= text.size()) return 0xFFFD;
+        const unsigned char next = static_cast<unsigned char>(text[index]);
+        if ((next & 0xC0) != 0x80) return 0xFFFD;
+        codepoint = (codepoint << 6) | (next & 0x3F);
+        ++index;
+    }
+    
+    return codepoint;
+}
+
+// The 32-bit glyph calls arrived in SDL_ttf 2.0.18. Older versions only take
+// UCS-2, so glyphs outside the Basic Multilingual Plane fall back to the slow path.
+#ifndef SDL_TTF_VERSION_ATLEAST
+#define SDL_TTF_VERSION_ATLEAST(X, Y, Z) \
+    (SDL_VERSIONNUM(SDL_TTF_MAJOR_VERSION, SDL_TTF_MINOR_VERSION, SDL_TTF_PATCHLEVEL) >= SDL_VERSIONNUM(X, Y, Z))
+#endif
+
+bool GlyphMetrics(TTF_Font* font, Uint32 codepoint, int* minX, int* maxX, int* minY, int* maxY, int* advance) {
+#if SDL_TTF_VERSION_ATLEAST(2, 0, 18)
+    return TTF_GlyphIsProvided32(font, codepoint) &&
+           TTF_GlyphMetrics32(font, codepoint, minX, maxX, minY, maxY, advance) == 0;
+#else
+    if (codepoint > 0xFFFF) return false;
+    Uint16 glyph = static_cast<Uint16>(codepoint);
+    return TTF_GlyphIsProvided(font, glyph) && TTF_GlyphMetrics(font, glyph, minX, maxX, minY, maxY, advance) == 0;
+#endif
+}
+
+SDL_Surface* RenderGlyph(TTF_Font* font, Uint32 codepoint, SDL_Color color) {
+#if SDL_TTF_VERSION_ATLEAST(2, 0, 18)
+    return TTF_RenderGlyph32_Blended(font, codepoint, color);
+#else
+    return TTF_RenderGlyph_Blended(font, static_cast<Uint16>(codepoint), color); // Only reached for UCS-2 glyphs
+#endif
+}
+
+int KerningSize(TTF_Font* font, Uint32 previous, Uint32 codepoint) {
+#if SDL_TTF_VERSION_ATLEAST(2, 0, 18)
+    return TTF_GetFontKerningSizeGlyphs32(font, previous, codepoint);
+#elif SDL_TTF_VERSION_ATLEAST(2, 0, 14)
+    return TTF_GetFontKerningSizeGlyphs(font, static_cast<Uint16>(previous), static_cast<Uint16>(codepoint));
+#else
+    (void)font;
+    (void)previous;
+    (void)codepoint;
+    return 0;
+#endif
+}
+
+} // namespace
 
 TextRenderer::TextRenderer() 
     : renderer_(nullptr), defaultFont16_(nullptr), defaultFont20_(nullptr), defaultFont24_(nullptr) {
@@ -10,7 +86,7 @@ TextRenderer::~TextRenderer() {
     Shutdown();
 }
 
-bool TextRenderer::Initialize(SDL_Renderer* renderer) {
+bool TextRenderer::Initialize(SDL_Renderer* renderer, AssetLoader* loader) {
     renderer_ = renderer;
     
     if (TTF_Init() != 0) {
@@ -20,33 +96,42 @@ bool TextRenderer::Initialize(SDL_Renderer* renderer) {
     
     // Try to load a system font (fallback to a simple built-in approach if no system font found)
     // On macOS, try common system fonts
-    const char* fontPaths[] = {
+    std::vector<std::string> fontPaths = {
         "/System/Library/Fonts/Helvetica.ttc",
         "/System/Library/Fonts/Arial.ttf", 
         "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",  // Linux
         "C:/Windows/Fonts/arial.ttf",  // Windows
-        nullptr
     };
     
-    for (const char** path = fontPaths; *path; ++path) {
-        defaultFont16_ = TTF_OpenFont(*path, 16);
-        if (defaultFont16_) {
-            defaultFont20_ = TTF_OpenFont(*path, 20);
-            defaultFont24_ = TTF_OpenFont(*path, 24);
-            break;
-        }
+    // The file is read on a loader thread; FreeType isn't safe to use from two
+    // threads at once, so the faces are opened from memory on this one
+    loader->RequestFile(fontPaths, [this](std::vector<char>&& data) {
+        OpenDefaultFonts(std::move(data));
+    });
+    
+    return true;
+}
+
+void TextRenderer::OpenDefaultFonts(std::vector<char>&& data) {
+    if (data.empty()) {
+        std::cerr << "Warning: Could not load a system font, text will not be drawn" << std::endl;
+        return;
     }
     
-    if (!defaultFont16_) {
+    fontData_ = std::move(data);
+    int size = static_cast<int>(fontData_.size());
+    defaultFont16_ = TTF_OpenFontRW(SDL_RWFromConstMem(fontData_.data(), size), 1, 16);
+    if (defaultFont16_) {
+        defaultFont20_ = TTF_OpenFontRW(SDL_RWFromConstMem(fontData_.data(), size), 1, 20);
+        defaultFont24_ = TTF_OpenFontRW(SDL_RWFromConstMem(fontData_.data(), size), 1, 24);
+    } else {
         std::cerr << "Warning: Could not load system font. TTF_OpenFont Error: " << TTF_GetError() << std::endl;
-        std::cerr << "Falling back to built-in rendering..." << std::endl;
-        return false;
     }
-    
-    return true;
 }
 
 void TextRenderer::Shutdown() {
+    ClearGlyphAtlases();
+    
     if (defaultFont16_) {
         TTF_CloseFont(defaultFont16_);
         defaultFont16_ = nullptr;
@@ -59,20 +144,26 @@ void TextRenderer::Shutdown() {
         TTF_CloseFont(defaultFont24_);
         defaultFont24_ = nullptr;
     }
+    fontData_.clear();
     
     TTF_Quit();
 }
 
 void TextRenderer::RenderText(const std::string& text, int x, int y, SDL_Color color, int fontSize) {
-    TTF_Font* font = GetDefaultFont(fontSize);
-    if (font) {
-        RenderText(text, x, y, color, font);
+    if (!renderer_ || text.empty()) return;
+    
+    const TextLayout* layout = GetLayout(text, fontSize, 0);
+    if (layout) {
+        RenderLayout(*layout, x, y, color, 0);
     }
 }
 
 void TextRenderer::RenderText(const std::string& text, int x, int y, SDL_Color color, TTF_Font* font) {
     if (!renderer_ || !font || text.empty()) return;
     
+    if (RenderTextWithAtlas(text, x, y, color, font)) return;
+    
+    // Slow path: atlas full or glyph missing, rasterize the whole string
     int width, height;
     SDL_Texture* textTexture = CreateTextTexture(text, color, font, &width, &height);
     if (!textTexture) return;
@@ -95,8 +186,8 @@ void TextRenderer::RenderTextBox(const std::string& text, int x, int y, int widt
     TTF_Font* font = GetDefaultFont(fontSize);
     if (!font) return;
     
-    int textWidth, textHeight;
-    TTF_SizeText(font, text.c_str(), &textWidth, &textHeight);
+    int textWidth = MeasureText(text, font);
+    int textHeight = TTF_FontHeight(font);
     
     int textX = x + (width - textWidth) / 2;
     int textY = y + (height - textHeight) / 2;
@@ -106,72 +197,373 @@ void TextRenderer::RenderTextBox(const std::string& text, int x, int y, int widt
 
 void TextRenderer::RenderWrappedText(const std::string& text, int x, int y, int maxWidth, 
                                     SDL_Color color, int fontSize, int lineSpacing) {
-    std::vector<std::string> lines = WrapText(text, maxWidth, fontSize);
+    if (!renderer_ || text.empty()) return;
     
-    int currentY = y;
-    for (const auto& line : lines) {
-        RenderText(line, x, currentY, color, fontSize);
-        currentY += fontSize + lineSpacing;
+    const TextLayout* layout = GetLayout(text, fontSize, maxWidth);
+    if (layout) {
+        RenderLayout(*layout, x, y, color, fontSize + lineSpacing);
     }
 }
 
 void TextRenderer::GetTextSize(const std::string& text, int fontSize, int* width, int* height) {
     TTF_Font* font = GetDefaultFont(fontSize);
-    if (font && TTF_SizeText(font, text.c_str(), width, height) != 0) {
+    if (!font) {
         *width = 0;
         *height = 0;
+        return;
     }
+    
+    *width = MeasureText(text, font);
+    *height = TTF_FontHeight(font);
 }
 
 std::vector<std::string> TextRenderer::WrapText(const std::string& text, int maxWidth, int fontSize) {
-    std::vector<std::string> lines;
-    TTF_Font* font = GetDefaultFont(fontSize);
-    if (!font) return lines;
+    const TextLayout* layout = GetLayout(text, fontSize, maxWidth);
+    return layout ? layout->lines : std::vector<std::string>();
+}
+
+TTF_Font* TextRenderer::LoadFont(const std::string& fontPath, int fontSize) {
+    return TTF_OpenFont(fontPath.c_str(), fontSize);
+}
+
+TTF_Font* TextRenderer::GetDefaultFont(int fontSize) {
+    if (fontSize <= 16) return defaultFont16_;
+    if (fontSize <= 20) return defaultFont20_;
+    return defaultFont24_;
+}
+
+void TextRenderer::ClearGlyphAtlases() {
+    for (auto& pair : atlases_) {
+        if (pair.second.texture) {
+            SDL_DestroyTexture(pair.second.texture);
+        }
+    }
+    atlases_.clear();
+    
+    // Cached layouts hold glyph pointers into the atlases
+    layouts_.clear();
+    layoutStats_.cachedLayouts = 0;
+}
+
+TextRenderer::GlyphAtlas* TextRenderer::GetAtlas(TTF_Font* font) {
+    auto it = atlases_.find(font);
+    if (it != atlases_.end()) {
+        return it->second.texture ? &it->second : nullptr;
+    }
+    
+    GlyphAtlas& atlas = atlases_[font];
+    atlas.texture = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, ATLAS_SIZE, ATLAS_SIZE);
+    if (!atlas.texture) {
+        // Remembered as a null atlas so we don't retry every frame
+        std::cerr << "Glyph atlas SDL_CreateTexture Error: " << SDL_GetError() << std::endl;
+        return nullptr;
+    }
+    SDL_SetTextureBlendMode(atlas.texture, SDL_BLENDMODE_BLEND);
+    
+    // Start from a fully transparent texture
+    std::vector<Uint32> clearPixels(ATLAS_SIZE * ATLAS_SIZE, 0);
+    SDL_UpdateTexture(atlas.texture, nullptr, clearPixels.data(), ATLAS_SIZE * sizeof(Uint32));
+    
+    // Printable ASCII covers nearly all UI strings, warm it up front
+    for (Uint32 codepoint = 32; codepoint < 127; ++codepoint) {
+        GetGlyph(&atlas, font, codepoint);
+    }
+    
+    return &atlas;
+}
+
+const TextRenderer::Glyph* TextRenderer::GetGlyph(GlyphAtlas* atlas, TTF_Font* font, Uint32 codepoint) {
+    auto it = atlas->glyphs.find(codepoint);
+    if (it != atlas->glyphs.end()) {
+        return &it->second;
+    }
+    
+    if (atlas->full) return nullptr;
+    
+    int minX, maxX, minY, maxY, advance;
+    if (!GlyphMetrics(font, codepoint, &minX, &maxX, &minY, &maxY, &advance)) {
+        return nullptr;
+    }
+    
+    Glyph glyph;
+    glyph.atlasRect = {0, 0, 0, 0};
+    glyph.offsetX = std::min(0, minX);
+    glyph.advance = advance;
+    
+    // Whitespace has metrics but nothing to rasterize
+    if (maxX <= minX) {
+        return &atlas->glyphs.emplace(codepoint, glyph).first->second;
+    }
+    
+    // Rasterize in white, color comes from the vertex color at draw time
+    SDL_Surface* rendered = RenderGlyph(font, codepoint, SDL_Color{255, 255, 255, 255});
+    if (!rendered) {
+        std::cerr << "TTF_RenderGlyph_Blended Error: " << TTF_GetError() << std::endl;
+        return nullptr;
+    }
     
-    std::istringstream words(text);
-    std::string word;
-    std::string currentLine;
+    SDL_Surface* surface = SDL_ConvertSurfaceFormat(rendered, SDL_PIXELFORMAT_ARGB8888, 0);
+    SDL_FreeSurface(rendered);
+    if (!surface) return nullptr;
     
-    while (words >> word) {
-        std::string testLine = currentLine.empty() ? word : currentLine + " " + word;
+    // Shelf packing: fill rows left to right, open a new shelf when the row is full
+    if (atlas->shelfX + surface->w + GLYPH_PADDING > ATLAS_SIZE) {
+        atlas->shelfX = 0;
+        atlas->shelfY += atlas->shelfHeight + GLYPH_PADDING;
+        atlas->shelfHeight = 0;
+    }
+    if (atlas->shelfY + surface->h > ATLAS_SIZE || surface->w > ATLAS_SIZE) {
+        std::cerr << "Warning: Glyph atlas is full, new glyphs will use the slow text path" << std::endl;
+        atlas->full = true;
+        SDL_FreeSurface(surface);
+        return nullptr;
+    }
+    
+    glyph.atlasRect = {atlas->shelfX, atlas->shelfY, surface->w, surface->h};
+    SDL_UpdateTexture(atlas->texture, &glyph.atlasRect, surface->pixels, surface->pitch);
+    
+    atlas->shelfX += surface->w + GLYPH_PADDING;
+    atlas->shelfHeight = std::max(atlas->shelfHeight, surface->h);
+    SDL_FreeSurface(surface);
+    
+    return &atlas->glyphs.emplace(codepoint, glyph).first->second;
+}
+
+bool TextRenderer::RenderTextWithAtlas(const std::string& text, int x, int y, SDL_Color color, TTF_Font* font) {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    GlyphAtlas* atlas = GetAtlas(font);
+    if (!atlas) return false;
+    
+    glyphVertices_.clear();
+    glyphIndices_.clear();
+    
+    int penX = x;
+    Uint32 previous = 0;
+    
+    for (size_t i = 0; i < text.size();) {
+        Uint32 codepoint = DecodeUtf8(text, i);
+        const Glyph* glyph = GetGlyph(atlas, font, codepoint);
+        if (!glyph) return false;
         
-        int lineWidth;
-        TTF_SizeText(font, testLine.c_str(), &lineWidth, nullptr);
+        if (previous) {
+            penX += KerningSize(font, previous, codepoint);
+        }
+        previous = codepoint;
+        
+        AppendGlyphQuad(*glyph, penX, y, color);
+        penX += glyph->advance;
+    }
+    
+    return FlushGlyphQuads(atlas);
+#else
+    return false;
+#endif
+}
+
+void TextRenderer::AppendGlyphQuad(const Glyph& glyph, int penX, int y, SDL_Color color) {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    const SDL_Rect& src = glyph.atlasRect;
+    if (src.w <= 0) return;
+    
+    const float texelSize = 1.0f / ATLAS_SIZE;
+    int base = static_cast<int>(glyphVertices_.size());
+    float left = static_cast<float>(penX + glyph.offsetX);
+    float top = static_cast<float>(y);
+    float right = left + src.w;
+    float bottom = top + src.h;
+    float u0 = src.x * texelSize;
+    float v0 = src.y * texelSize;
+    float u1 = (src.x + src.w) * texelSize;
+    float v1 = (src.y + src.h) * texelSize;
+    
+    glyphVertices_.push_back({{left, top}, color, {u0, v0}});
+    glyphVertices_.push_back({{right, top}, color, {u1, v0}});
+    glyphVertices_.push_back({{right, bottom}, color, {u1, v1}});
+    glyphVertices_.push_back({{left, bottom}, color, {u0, v1}});
+    glyphIndices_.insert(glyphIndices_.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+#endif
+}
+
+bool TextRenderer::FlushGlyphQuads(GlyphAtlas* atlas) {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if (glyphVertices_.empty()) return true;
+    
+    // One textured geometry call for everything queued since the last clear
+    return SDL_RenderGeometry(renderer_, atlas->texture,
+                              glyphVertices_.data(), static_cast<int>(glyphVertices_.size()),
+                              glyphIndices_.data(), static_cast<int>(glyphIndices_.size())) == 0;
+#else
+    return false;
+#endif
+}
+
+const TextRenderer::TextLayout* TextRenderer::GetLayout(const std::string& text, int fontSize, int maxWidth) {
+    TTF_Font* font = GetDefaultFont(fontSize);
+    if (!font) return nullptr;
+    
+    auto it = layouts_.find(text);
+    if (it != layouts_.end()) {
+        for (const TextLayout& layout : it->second) {
+            if (layout.fontSize == fontSize && layout.maxWidth == maxWidth) {
+                layoutStats_.hits++;
+                return &layout;
+            }
+        }
+    }
+    
+    layoutStats_.misses++;
+    
+    // Dialogue only has a handful of live strings, a full reset is enough to bound memory
+    if (layoutStats_.cachedLayouts >= MAX_CACHED_LAYOUTS) {
+        layouts_.clear();
+        layoutStats_.cachedLayouts = 0;
+        it = layouts_.end();
+    }
+    
+    std::vector<TextLayout>& variants = (it != layouts_.end()) ? it->second : layouts_[text];
+    variants.emplace_back();
+    TextLayout& layout = variants.back();
+    layout.fontSize = fontSize;
+    layout.maxWidth = maxWidth;
+    BuildLayout(&layout, text, font);
+    layoutStats_.cachedLayouts++;
+    
+    return &layout;
+}
+
+void TextRenderer::BuildLayout(TextLayout* layout, const std::string& text, TTF_Font* font) {
+    // Line breaks
+    if (layout->maxWidth <= 0) {
+        layout->lines.push_back(text);
+    } else {
+        // Greedy word wrap, words are re-joined with single spaces.
+        // Kerning against the space is ignored while breaking (it is zero for our fonts).
+        const int spaceWidth = MeasureText(" ", font);
+        std::string currentLine;
+        int currentWidth = 0;
+        size_t pos = 0;
         
-        if (lineWidth <= maxWidth) {
-            currentLine = testLine;
-        } else {
-            if (!currentLine.empty()) {
-                lines.push_back(currentLine);
+        while (pos < text.size()) {
+            while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) ++pos;
+            size_t wordEnd = pos;
+            while (wordEnd < text.size() && !std::isspace(static_cast<unsigned char>(text[wordEnd]))) ++wordEnd;
+            if (wordEnd == pos) break;
+            
+            std::string word = text.substr(pos, wordEnd - pos);
+            pos = wordEnd;
+            
+            int wordWidth = MeasureText(word, font);
+            int testWidth = currentLine.empty() ? wordWidth : currentWidth + spaceWidth + wordWidth;
+            
+            if (testWidth <= layout->maxWidth) {
+                if (!currentLine.empty()) currentLine += ' ';
+                currentLine += word;
+                currentWidth = testWidth;
+            } else if (!currentLine.empty()) {
+                layout->lines.push_back(currentLine);
                 currentLine = word;
+                currentWidth = wordWidth;
             } else {
                 // Word is too long for line, just add it anyway
-                lines.push_back(word);
+                layout->lines.push_back(word);
             }
         }
+        
+        if (!currentLine.empty()) {
+            layout->lines.push_back(currentLine);
+        }
     }
     
-    if (!currentLine.empty()) {
-        lines.push_back(currentLine);
+    // Glyph positions, kept only when every glyph is in the atlas
+    GlyphAtlas* atlas = GetAtlas(font);
+    if (!atlas) return;
+    
+    for (size_t line = 0; line < layout->lines.size(); ++line) {
+        const std::string& lineText = layout->lines[line];
+        int penX = 0;
+        Uint32 previous = 0;
+        
+        for (size_t i = 0; i < lineText.size();) {
+            Uint32 codepoint = DecodeUtf8(lineText, i);
+            const Glyph* glyph = GetGlyph(atlas, font, codepoint);
+            if (!glyph) {
+                layout->glyphs.clear();
+                return;
+            }
+            
+            if (previous) {
+                penX += KerningSize(font, previous, codepoint);
+            }
+            previous = codepoint;
+            
+            layout->glyphs.push_back({glyph, penX, static_cast<int>(line)});
+            penX += glyph->advance;
+        }
     }
     
-    return lines;
+    layout->atlas = atlas;
 }
 
-TTF_Font* TextRenderer::LoadFont(const std::string& fontPath, int fontSize) {
-    return TTF_OpenFont(fontPath.c_str(), fontSize);
+void TextRenderer::RenderLayout(const TextLayout& layout, int x, int y, SDL_Color color, int lineHeight) {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if (layout.atlas) {
+        glyphVertices_.clear();
+        glyphIndices_.clear();
+        
+        for (const LayoutGlyph& placed : layout.glyphs) {
+            AppendGlyphQuad(*placed.glyph, x + placed.x, y + placed.line * lineHeight, color);
+        }
+        
+        if (FlushGlyphQuads(layout.atlas)) return;
+    }
+#endif
+    
+    // Slow path: no atlas for this text, rasterize line by line
+    TTF_Font* font = GetDefaultFont(layout.fontSize);
+    if (!font) return;
+    
+    int currentY = y;
+    for (const auto& line : layout.lines) {
+        RenderText(line, x, currentY, color, font);
+        currentY += lineHeight;
+    }
 }
 
-TTF_Font* TextRenderer::GetDefaultFont(int fontSize) {
-    if (fontSize <= 16) return defaultFont16_;
-    if (fontSize <= 20) return defaultFont20_;
-    return defaultFont24_;
+int TextRenderer::MeasureText(const std::string& text, TTF_Font* font) {
+    GlyphAtlas* atlas = GetAtlas(font);
+    int width = 0;
+    Uint32 previous = 0;
+    
+    if (atlas) {
+        for (size_t i = 0; i < text.size();) {
+            Uint32 codepoint = DecodeUtf8(text, i);
+            const Glyph* glyph = GetGlyph(atlas, font, codepoint);
+            if (!glyph) {
+                width = -1;
+                break;
+            }
+            
+            if (previous) {
+                width += KerningSize(font, previous, codepoint);
+            }
+            previous = codepoint;
+            width += glyph->advance;
+        }
+        
+        if (width >= 0) return width;
+    }
+    
+    // Glyph not in the atlas, let SDL_ttf measure the string
+    if (TTF_SizeUTF8(font, text.c_str(), &width, nullptr) != 0) {
+        return 0;
+    }
+    return width;
 }
 
 SDL_Texture* TextRenderer::CreateTextTexture(const std::string& text, SDL_Color color, TTF_Font* font, int* width, int* height) {
-    SDL_Surface* textSurface = TTF_RenderText_Blended(font, text.c_str(), color);
+    SDL_Surface* textSurface = TTF_RenderUTF8_Blended(font, text.c_str(), color);
     if (!textSurface) {
-        std::cerr << "TTF_RenderText_Blended Error: " << TTF_GetError() << std::endl;
+        std::cerr << "TTF_RenderUTF8_Blended Error: " << TTF_GetError() << std::endl;
         return nullptr;
     }
     
@@ -0,0 +1,180 @@
+#include "TextureCache.h"
+#include "AssetLoader.h"
+#include <iostream>
+
+TextureCache::TextureCache()
+    : renderer_(nullptr), loader_(nullptr), budgetBytes_(0), residentBytes_(0),
+      hits_(0), misses_(0), evictions_(0) {
+}
+
+TextureCache::~TextureCache() {
+    Shutdown();
+}
+
+void TextureCache::Initialize(SDL_Renderer* renderer, AssetLoader* loader, size_t budgetBytes) {
+    renderer_ = renderer;
+    loader_ = loader;
+    budgetBytes_ = budgetBytes;
+}
+
+void TextureCache::Shutdown() {
+    for (Entry& entry : entries_) {
+        if (entry.texture) SDL_DestroyTexture(entry.texture);
+    }
+    entries_.clear();
+    handles_.clear();
+    lru_.clear();
+    residentBytes_ = 0;
+    loader_ = nullptr;
+}
+
+TextureHandle TextureCache::Acquire(const std::string& path) {
+    TextureHandle handle;
+    auto it = handles_.find(path);
+    if (it != handles_.end()) {
+        handle = it->second;
+    } else {
+        handle = static_cast<TextureHandle>(entries_.size());
+        entries_.emplace_back();
+        entries_.back().path = path;
+        handles_[path] = handle;
+    }
+
+    Entry& entry = entries_[handle];
+    entry.refs++;
+    if (entry.state == State::UNLOADED) {
+        misses_++;
+        Load(handle);
+    } else {
+        hits_++;
+        RemoveFromLru(handle);
+    }
+    return handle;
+}
+
+void TextureCache::Release(TextureHandle handle) {
+    if (!IsValid(handle) || entries_[handle].refs <= 0) return;
+
+    Entry& entry = entries_[handle];
+    entry.refs--;
+    if (entry.refs == 0 && entry.state == State::READY) {
+        AddToLru(handle);
+        TrimToBudget();
+    }
+}
+
+SDL_Texture* TextureCache::Get(TextureHandle handle) {
+    if (!IsValid(handle)) return nullptr;
+
+    Entry& entry = entries_[handle];
+    if (entry.inLru) {
+        lru_.splice(lru_.begin(), lru_, entry.lruPosition);
+    }
+    return entry.texture;
+}
+
+bool TextureCache::IsLoading(TextureHandle handle) const {
+    return IsValid(handle) && entries_[handle].state == State::LOADING;
+}
+
+void TextureCache::SetBudget(size_t budgetBytes) {
+    budgetBytes_ = budgetBytes;
+    TrimToBudget();
+}
+
+TextureCacheStats TextureCache::GetStats() const {
+    TextureCacheStats stats;
+    stats.residentBytes = residentBytes_;
+    stats.budgetBytes = budgetBytes_;
+    stats.hits = hits_;
+    stats.misses = misses_;
+    stats.evictions = evictions_;
+    for (const Entry& entry : entries_) {
+        if (entry.state == State::READY) stats.residentTextures++;
+        if (entry.state == State::LOADING) stats.loadingTextures++;
+    }
+    return stats;
+}
+
+void TextureCache::Load(TextureHandle handle) {
+    Entry& entry = entries_[handle];
+    if (!loader_) {
+        entry.state = State::FAILED;
+        return;
+    }
+
+    entry.state = State::LOADING;
+    loader_->RequestImage(entry.path, [this, handle](SDL_Surface* surface) {
+        OnLoaded(handle, surface);
+    });
+}
+
+void TextureCache::OnLoaded(TextureHandle handle, SDL_Surface* surface) {
+    // Cache shut down since the request went out
+    if (!IsValid(handle) || entries_[handle].state != State::LOADING) {
+        if (surface) SDL_FreeSurface(surface);
+        return;
+    }
+
+    Entry& entry = entries_[handle];
+    if (surface) {
+        entry.texture = SDL_CreateTextureFromSurface(renderer_, surface);
+        SDL_FreeSurface(surface);
+        if (entry.texture) {
+            SDL_SetTextureBlendMode(entry.texture, SDL_BLENDMODE_BLEND);
+        } else {
+            std::cerr << "SDL_CreateTextureFromSurface Error: " << SDL_GetError() << std::endl;
+        }
+    }
+
+    if (!entry.texture) {
+        entry.state = State::FAILED;
+        std::cerr << "Failed to load texture " << entry.path << std::endl;
+        return;
+    }
+
+    Uint32 format = 0;
+    int width = 0;
+    int height = 0;
+    SDL_QueryTexture(entry.texture, &format, nullptr, &width, &height);
+    entry.bytes = static_cast<size_t>(width) * height * SDL_BYTESPERPIXEL(format);
+    entry.state = State::READY;
+    residentBytes_ += entry.bytes;
+
+    // Everyone let go while it was loading
+    if (entry.refs == 0) {
+        AddToLru(handle);
+    }
+    TrimToBudget();
+}
+
+void TextureCache::Evict(TextureHandle handle) {
+    Entry& entry = entries_[handle];
+    RemoveFromLru(handle);
+    SDL_DestroyTexture(entry.texture);
+    entry.texture = nullptr;
+    residentBytes_ -= entry.bytes;
+    entry.bytes = 0;
+    entry.state = State::UNLOADED;
+    evictions_++;
+}
+
+void TextureCache::TrimToBudget() {
+    while (residentBytes_ > budgetBytes_ && !lru_.empty()) {
+        Evict(lru_.back());
+    }
+}
+
+void TextureCache::AddToLru(TextureHandle handle) {
+    Entry& entry = entries_[handle];
+    if (entry.inLru) return;
+    entry.lruPosition = lru_.insert(lru_.begin(), handle);
+    entry.inLru = true;
+}
+
+void TextureCache::RemoveFromLru(TextureHandle handle) {
+    Entry& entry = entries_[handle];
+    if (!entry.inLru) return;
+    lru_.erase(entry.lruPosition);
+    entry.inLru = false;
+}
@@ -0,0 +1,630 @@
+#include "WorldRenderer.h"
+#include "RenderSnapshot.h"
+#include <algorithm>
+#include <iostream>
+
+WorldRenderer::WorldRenderer()
+    : useChunks_(false), chunksDrawnLastFrame_(0) {
+}
+
+WorldRenderer::~WorldRenderer() {
+    Shutdown();
+}
+
+bool WorldRenderer::Initialize(Renderer* renderer) {
+    useChunks_ = renderer && renderer->SupportsRenderTargets();
+    if (!useChunks_) {
+        std::cerr << "Warning: Render targets unsupported, world will be drawn every frame" << std::endl;
+        return false;
+    }
+    
+    return true;
+}
+
+void WorldRenderer::Shutdown() {
+    DestroyChunks();
+}
+
+void WorldRenderer::Invalidate() {
+    DestroyChunks();
+}
+
+void WorldRenderer::RenderWorld(Renderer* renderer, const WorldSnapshot* world, Vector2 cameraOffset) {
+    chunksDrawnLastFrame_ = 0;
+    if (!world) return;
+    
+    if (!useChunks_) {
+        // Draw every tile overlapping the window, plus the row/column above and to
+        // the left whose shadows can spill into view
+        int firstX = static_cast<int>(cameraOffset.x) / TILE_SIZE - 1;
+        int firstY = static_cast<int>(cameraOffset.y) / TILE_SIZE - 1;
+        int lastX = (static_cast<int>(cameraOffset.x) + renderer->GetWindowWidth()) / TILE_SIZE;
+        int lastY = (static_cast<int>(cameraOffset.y) + renderer->GetWindowHeight()) / TILE_SIZE;
+        DrawTileRange(renderer, world, firstX, firstY, lastX, lastY, cameraOffset);
+        return;
+    }
+    
+    EvictStaleChunks(world);
+    
+    // Walk the chunks the world wants ready: bake what is missing (on-screen chunks
+    // right away, off-screen ones a few per frame) and blit the visible ones
+    const int CHUNK_SIZE = WorldChunkData::CHUNK_SIZE;
+    Rect prefetch = world->GetPrefetchBounds();
+    int firstChunkX = std::max(prefetch.x / CHUNK_SIZE, 0);
+    int firstChunkY = std::max(prefetch.y / CHUNK_SIZE, 0);
+    int lastChunkX = std::min((prefetch.x + prefetch.w - 1) / CHUNK_SIZE, world->GetWidthChunks() - 1);
+    int lastChunkY = std::min((prefetch.y + prefetch.h - 1) / CHUNK_SIZE, world->GetHeightChunks() - 1);
+    int prefetchBakes = 0;
+    
+    for (int chunkY = firstChunkY; chunkY <= lastChunkY; chunkY++) {
+        for (int chunkX = firstChunkX; chunkX <= lastChunkX; chunkX++) {
+            const WorldSnapshot::Chunk* data = world->GetChunk(chunkX, chunkY);
+            if (!data) continue;
+            
+            int key = chunkY * world->GetWidthChunks() + chunkX;
+            Rect bounds = ChunkBounds(world, chunkX, chunkY);
+            bool visible = !renderer->CullTile(bounds, cameraOffset);
+            
+            auto it = chunks_.find(key);
+            if (it == chunks_.end()) {
+                if (!visible && (prefetchBakes >= MAX_PREFETCH_BAKES || !CanBake(world, chunkX, chunkY))) {
+                    continue;
+                }
+                
+                if (!BakeChunk(renderer, world, chunkX, chunkY, data->loadSerial)) {
+                    std::cerr << "Warning: Failed to bake world chunks, falling back to immediate drawing" << std::endl;
+                    DestroyChunks();
+                    useChunks_ = false;
+                    RenderWorld(renderer, world, cameraOffset);
+                    return;
+                }
+                if (!visible) prefetchBakes++;
+                it = chunks_.find(key);
+            }
+            
+            if (visible) {
+                Vector2 chunkPos(static_cast<float>(bounds.x), static_cast<float>(bounds.y));
+                renderer->DrawTextureWorld(it->second.texture, chunkPos, cameraOffset);
+                chunksDrawnLastFrame_++;
+            }
+        }
+    }
+}
+
+bool WorldRenderer::BakeChunk(Renderer* renderer, const WorldSnapshot* world, int chunkX, int chunkY, Uint32 loadSerial) {
+    const int CHUNK_SIZE = WorldChunkData::CHUNK_SIZE;
+    const int TILES = WorldChunkData::TILES;
+    
+    Rect bounds = ChunkBounds(world, chunkX, chunkY);
+    SDL_Texture* texture = renderer->CreateRenderTarget(bounds.w, bounds.h);
+    if (!texture) {
+        return false;
+    }
+    
+    // Draw the chunk's tiles plus the neighbors above/left that spill into it,
+    // with the chunk origin as camera; the render target clips the rest
+    int firstX = chunkX * TILES;
+    int firstY = chunkY * TILES;
+    renderer->SetRenderTarget(texture);
+    renderer->Clear();
+    DrawTileRange(renderer, world, firstX - 1, firstY - 1, firstX + TILES - 1, firstY + TILES - 1,
+                  Vector2(static_cast<float>(chunkX * CHUNK_SIZE), static_cast<float>(chunkY * CHUNK_SIZE)));
+    renderer->SetRenderTarget(nullptr);
+    
+    chunks_[chunkY * world->GetWidthChunks() + chunkX] = {bounds, loadSerial, texture};
+    return true;
+}
+
+void WorldRenderer::EvictStaleChunks(const WorldSnapshot* world) {
+    const int CHUNK_SIZE = WorldChunkData::CHUNK_SIZE;
+    
+    // Chunk textures live exactly as long as the world keeps their chunk resident
+    for (auto it = chunks_.begin(); it != chunks_.end();) {
+        const BakedChunk& baked = it->second;
+        const WorldSnapshot::Chunk* data = world->GetChunk(baked.bounds.x / CHUNK_SIZE, baked.bounds.y / CHUNK_SIZE);
+        if (data && data->loadSerial == baked.loadSerial) {
+            ++it;
+        } else {
+            SDL_DestroyTexture(baked.texture);
+            it = chunks_.erase(it);
+        }
+    }
+}
+
+void WorldRenderer::DestroyChunks() {
+    for (auto& pair : chunks_) {
+        if (pair.second.texture) {
+            SDL_DestroyTexture(pair.second.texture);
+        }
+    }
+    chunks_.clear();
+}
+
+Rect WorldRenderer::ChunkBounds(const WorldSnapshot* world, int chunkX, int chunkY) const {
+    // Chunks on the map edge are trimmed to the map
+    const int CHUNK_SIZE = WorldChunkData::CHUNK_SIZE;
+    int x = chunkX * CHUNK_SIZE;
+    int y = chunkY * CHUNK_SIZE;
+    return Rect(x, y, std::min(CHUNK_SIZE, world->GetWidthPixels() - x), std::min(CHUNK_SIZE, world->GetHeightPixels() - y));
+}
+
+bool WorldRenderer::CanBake(const WorldSnapshot* world, int chunkX, int chunkY) const {
+    // Neighbors above and to the left draw into this chunk, wait until they are loaded
+    for (int neighborY = chunkY - 1; neighborY <= chunkY; neighborY++) {
+        for (int neighborX = chunkX - 1; neighborX <= chunkX; neighborX++) {
+            if (neighborX < 0 || neighborY < 0) continue;
+            if (!world->GetChunk(neighborX, neighborY)) return false;
+        }
+    }
+    return true;
+}
+
+bool WorldRenderer::CullTile(Renderer* renderer, int x, int y, Vector2 cameraOffset) {
+    // Shadows, waves and grass tufts spill a few pixels right/down into the next tile
+    Rect tileBounds(x * TILE_SIZE, y * TILE_SIZE, TILE_SIZE + TILE_DRAW_MARGIN, TILE_SIZE + TILE_DRAW_MARGIN);
+    return renderer->CullTile(tileBounds, cameraOffset);
+}
+
+void WorldRenderer::DrawTileRange(Renderer* renderer, const WorldSnapshot* world, int firstX, int firstY, int lastX, int lastY, Vector2 cameraOffset) {
+    firstX = std::max(firstX, 0);
+    firstY = std::max(firstY, 0);
+    lastX = std::min(lastX, world->GetWidthTiles() - 1);
+    lastY = std::min(lastY, world->GetHeightTiles() - 1);
+    
+    // Ground layer first
+    for (int y = firstY; y <= lastY; y++) {
+        for (int x = firstX; x <= lastX; x++) {
+            const Tile* tile = world->GetTile(x, y);
+            if (!tile || CullTile(renderer, x, y, cameraOffset)) continue;
+            RenderGroundTile(renderer, x, y, *tile, cameraOffset);
+        }
+    }
+    
+    // Then one pass per overlay type so every feature's shadows land on the
+    // neighbors drawn before it (water, house, farm, garden, paths)
+    for (int pass = static_cast<int>(TileOverlay::NONE) + 1; pass < static_cast<int>(TileOverlay::COUNT); pass++) {
+        TileOverlay overlay = static_cast<TileOverlay>(pass);
+        
+        for (int y = firstY; y <= lastY; y++) {
+            for (int x = firstX; x <= lastX; x++) {
+                const Tile* tile = world->GetTile(x, y);
+                if (!tile || tile->overlay != overlay || CullTile(renderer, x, y, cameraOffset)) continue;
+                
+                switch (overlay) {
+                    case TileOverlay::WATER_TOP:
+                    case TileOverlay::WATER_BOTTOM:
+                    case TileOverlay::WATER_LEFT:
+                    case TileOverlay::WATER_RIGHT:
+                        RenderWaterTile(renderer, x, y, *tile, cameraOffset);
+                        break;
+                    case TileOverlay::HOUSE_ROOF:
+                    case TileOverlay::HOUSE_WALL:
+                        RenderHouseTile(renderer, x, y, *tile, cameraOffset);
+                        break;
+                    case TileOverlay::FARM:
+                        RenderFarmTile(renderer, x, y, *tile, cameraOffset);
+                        break;
+                    case TileOverlay::GARDEN:
+                        RenderGardenTile(renderer, x, y, *tile, cameraOffset);
+                        break;
+                    case TileOverlay::PATH_HORIZONTAL:
+                        RenderDirtPath(renderer, x, y, true, cameraOffset);
+                        break;
+                    case TileOverlay::PATH_VERTICAL:
+                        RenderDirtPath(renderer, x, y, false, cameraOffset);
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+    }
+}
+
+void WorldRenderer::RenderGroundTile(Renderer* renderer, int x, int y, const Tile& tile, Vector2 cameraOffset) {
+    Rect groundRect(x * TILE_SIZE, y * TILE_SIZE, TILE_SIZE, TILE_SIZE);
+    if (tile.ground == TileGround::SKY) {
+        renderer->DrawRectWorld(groundRect, cameraOffset, colors_.sky);
+    } else if (tile.ground == TileGround::GRASS) {
+        renderer->DrawRectWorld(groundRect, cameraOffset, colors_.grass);
+    }
+}
+
+void WorldRenderer::RenderWaterTile(Renderer* renderer, int x, int y, const Tile& tile, Vector2 cameraOffset) {
+    Rect waterRect(x * TILE_SIZE, y * TILE_SIZE, TILE_SIZE, TILE_SIZE);
+    renderer->DrawRectWorld(waterRect, cameraOffset, colors_.water);
+    
+    // Add wave lines, running along the shore
+    SDL_Color waveColor = {100, 160, 200, 255}; // Lighter blue waves
+    for (int i = 0; i < 3; i++) {
+        Rect waveRect;
+        switch (tile.overlay) {
+            case TileOverlay::WATER_TOP:
+                waveRect = Rect(x * TILE_SIZE + 10 + i * 35, y * TILE_SIZE + 20 + i * 25, 60, 6);
+                break;
+            case TileOverlay::WATER_BOTTOM:
+                waveRect = Rect(x * TILE_SIZE + 15 + i * 30, y * TILE_SIZE + 30 + i * 20, 50, 6);
+                break;
+            case TileOverlay::WATER_LEFT:
+                waveRect = Rect(x * TILE_SIZE + 20 + i * 25, y * TILE_SIZE + 10 + i * 35, 6, 60);
+                break;
+            default:
+                waveRect = Rect(x * TILE_SIZE + 30 + i * 20, y * TILE_SIZE + 15 + i * 30, 6, 50);
+                break;
+        }
+        renderer->DrawRectWorld(waveRect, cameraOffset, waveColor);
+    }
+}
+
+void WorldRenderer::RenderHouseTile(Renderer* renderer, int x, int y, const Tile& tile, Vector2 cameraOffset) {
+    if (tile.overlay == TileOverlay::HOUSE_ROOF) {
+        // Drop shadow for roof
+        Rect roofShadow(x * TILE_SIZE + 8, y * TILE_SIZE + 8, TILE_SIZE, TILE_SIZE);
+        renderer->DrawRectWorld(roofShadow, cameraOffset, SDL_Color{0, 0, 0, 80});
+
+        // Roof base with gradient effect
+        Rect roofRect(x * TILE_SIZE, y * TILE_SIZE, TILE_SIZE, TILE_SIZE);
+        renderer->DrawRectWorld(roofRect, cameraOffset, colors_.houseRoof);
+
+        // Roof highlight (top edge)
+        Rect roofHighlight(x * TILE_SIZE, y * TILE_SIZE, TILE_SIZE, 12);
+        renderer->DrawRectWorld(roofHighlight, cameraOffset, SDL_Color{220, 60, 60, 255});
+
+        // Roof shadow (bottom edge)
+        Rect roofShadowEdge(x * TILE_SIZE, y * TILE_SIZE + 116, TILE_SIZE, 12);
+        renderer->DrawRectWorld(roofShadowEdge, cameraOffset, colors_.roofAccent);
+
+        // Ghibli-style organic roof tiles with irregular spacing
+        for (int i = 0; i < 4; i++) {
+            // Irregular tile rows for hand-drawn feel
+            int tileY = y * TILE_SIZE + i * 28 + ((i % 2) * 4); // Slightly uneven rows
+
+            // Dark tile lines with slight curves
+            Rect tileLineH(x * TILE_SIZE, tileY, TILE_SIZE, 4);
+            renderer->DrawRectWorld(tileLineH, cameraOffset, colors_.roofAccent);
+
+            // Add individual tile highlights with variation
+            for (int j = 0; j < 4; j++) {
+                int tileX = x * TILE_SIZE + j * 30 + ((j % 2) * 3);
+                Rect tileHighlight(tileX, tileY + 4, 26, 3);
+                SDL_Color highlightColor = {
+                    static_cast<Uint8>(180 + (j * 5)), 
+                    static_cast<Uint8>(45 + (j * 3)), 
+                    static_cast<Uint8>(45 + (j * 2)), 
+                    255
+                };
+                renderer->DrawRectWorld(tileHighlight, cameraOffset, highlightColor);
+            }
+        }
+
+        // Vertical roof divisions with 3D effect
+        if (tile.flags & TILE_ROOF_RIDGE) {
+            Rect tileLineV(x * TILE_SIZE + 60, y * TILE_SIZE, 8, TILE_SIZE);
+            renderer->DrawRectWorld(tileLineV, cameraOffset, colors_.roofAccent);
+            Rect tileHighlightV(x * TILE_SIZE + 62, y * TILE_SIZE, 4, TILE_SIZE);
+            renderer->DrawRectWorld(tileHighlightV, cameraOffset, SDL_Color{200, 50, 50, 255});
+        }
+    } else {
+        // Wall shadow
+        Rect wallShadow(x * TILE_SIZE + 6, y * TILE_SIZE + 6, TILE_SIZE, TILE_SIZE);
+        renderer->DrawRectWorld(wallShadow, cameraOffset, SDL_Color{0, 0, 0, 60});
+
+        // Wall base with gradient
+        Rect wallRect(x * TILE_SIZE, y * TILE_SIZE, TILE_SIZE, TILE_SIZE);
+        renderer->DrawRectWorld(wallRect, cameraOffset, colors_.houseWalls);
+
+        // Wall highlight (top)
+        Rect wallHighlight(x * TILE_SIZE, y * TILE_SIZE, TILE_SIZE, 8);
+        renderer->DrawRectWorld(wallHighlight, cameraOffset, SDL_Color{240, 200, 155, 255});
+
+        // Wall shadow (bottom)
+        Rect wallShadowEdge(x * TILE_SIZE, y * TILE_SIZE + 120, TILE_SIZE, 8);
+        renderer->DrawRectWorld(wallShadowEdge, cameraOffset, SDL_Color{190, 160, 115, 255});
+
+        if (tile.flags & TILE_DOOR) {
+            // Enhanced door with depth
+            Rect doorShadow(x * TILE_SIZE + 42, y * TILE_SIZE + 22, 40, 80);
+            renderer->DrawRectWorld(doorShadow, cameraOffset, SDL_Color{0, 0, 0, 40});
+
+            Rect doorRect(x * TILE_SIZE + 40, y * TILE_SIZE + 20, 40, 80);
+            renderer->DrawRectWorld(doorRect, cameraOffset, SDL_Color{139, 69, 19, 255});
+
+            // Ghibli-style door with organic wood grain
+            Rect doorPanel1(x * TILE_SIZE + 44, y * TILE_SIZE + 25, 32, 30);
+            renderer->DrawRectWorld(doorPanel1, cameraOffset, SDL_Color{160, 82, 22, 255});
+            Rect doorPanel2(x * TILE_SIZE + 44, y * TILE_SIZE + 60, 32, 30);
+            renderer->DrawRectWorld(doorPanel2, cameraOffset, SDL_Color{160, 82, 22, 255});
+
+            // Add wood grain lines
+            for (int k = 0; k < 8; k++) {
+                int grainY = y * TILE_SIZE + 28 + k * 8 + ((k % 2) * 2);
+                Rect woodGrain(x * TILE_SIZE + 45, grainY, 30, 1 + (k % 2));
+                SDL_Color grainColor = {
+                    static_cast<Uint8>(120 + (k * 3)), 
+                    static_cast<Uint8>(52 + (k * 2)), 
+                    static_cast<Uint8>(12 + k), 
+                    255
+                };
+                renderer->DrawRectWorld(woodGrain, cameraOffset, grainColor);
+            }
+
+            // Door knob with highlight
+            Rect knobShadow(x * TILE_SIZE + 73, y * TILE_SIZE + 56, 6, 6);
+            renderer->DrawRectWorld(knobShadow, cameraOffset, SDL_Color{0, 0, 0, 60});
+            Rect knobRect(x * TILE_SIZE + 72, y * TILE_SIZE + 55, 6, 6);
+            renderer->DrawRectWorld(knobRect, cameraOffset, SDL_Color{255, 215, 0, 255});
+            Rect knobHighlight(x * TILE_SIZE + 72, y * TILE_SIZE + 55, 3, 3);
+            renderer->DrawRectWorld(knobHighlight, cameraOffset, SDL_Color{255, 255, 200, 255});
+        } else {
+            // Enhanced window with depth and reflection
+            Rect windowShadow(x * TILE_SIZE + 32, y * TILE_SIZE + 32, 60, 50);
+            renderer->DrawRectWorld(windowShadow, cameraOffset, SDL_Color{0, 0, 0, 40});
+
+            Rect windowRect(x * TILE_SIZE + 30, y * TILE_SIZE + 30, 60, 50);
+            renderer->DrawRectWorld(windowRect, cameraOffset, colors_.windowBlue);
+
+            // Window reflection
+            Rect windowReflection(x * TILE_SIZE + 35, y * TILE_SIZE + 35, 25, 20);
+            renderer->DrawRectWorld(windowReflection, cameraOffset, SDL_Color{200, 220, 255, 180});
+
+            // Enhanced window frame with beveled edges
+            Rect frameH1(x * TILE_SIZE + 26, y * TILE_SIZE + 26, 68, 6);
+            Rect frameH2(x * TILE_SIZE + 26, y * TILE_SIZE + 78, 68, 6);
+            Rect frameV1(x * TILE_SIZE + 26, y * TILE_SIZE + 26, 6, 58);
+            Rect frameV2(x * TILE_SIZE + 86, y * TILE_SIZE + 26, 6, 58);
+            renderer->DrawRectWorld(frameH1, cameraOffset, colors_.houseBrown);
+            renderer->DrawRectWorld(frameH2, cameraOffset, colors_.houseBrown);
+            renderer->DrawRectWorld(frameV1, cameraOffset, colors_.houseBrown);
+            renderer->DrawRectWorld(frameV2, cameraOffset, colors_.houseBrown);
+
+            // Frame highlights
+            Rect frameHighlightH1(x * TILE_SIZE + 26, y * TILE_SIZE + 26, 68, 2);
+            Rect frameHighlightV1(x * TILE_SIZE + 26, y * TILE_SIZE + 26, 2, 58);
+            renderer->DrawRectWorld(frameHighlightH1, cameraOffset, SDL_Color{180, 100, 40, 255});
+            renderer->DrawRectWorld(frameHighlightV1, cameraOffset, SDL_Color{180, 100, 40, 255});
+
+            // Window cross with depth
+            Rect crossH(x * TILE_SIZE + 30, y * TILE_SIZE + 50, 60, 6);
+            Rect crossV(x * TILE_SIZE + 56, y * TILE_SIZE + 30, 6, 50);
+            renderer->DrawRectWorld(crossH, cameraOffset, colors_.houseBrown);
+            renderer->DrawRectWorld(crossV, cameraOffset, colors_.houseBrown);
+
+            // Cross highlights
+            Rect crossHighlightH(x * TILE_SIZE + 30, y * TILE_SIZE + 50, 60, 2);
+            Rect crossHighlightV(x * TILE_SIZE + 56, y * TILE_SIZE + 30, 2, 50);
+            renderer->DrawRectWorld(crossHighlightH, cameraOffset, SDL_Color{180, 100, 40, 255});
+            renderer->DrawRectWorld(crossHighlightV, cameraOffset, SDL_Color{180, 100, 40, 255});
+        }
+    }
+}
+
+void WorldRenderer::RenderFarmTile(Renderer* renderer, int x, int y, const Tile& tile, Vector2 cameraOffset) {
+    // Base farm soil
+    SDL_Color farmBase = {139, 90, 43, 255}; // Rich brown soil
+    Rect farmRect(x * TILE_SIZE, y * TILE_SIZE, TILE_SIZE, TILE_SIZE);
+    renderer->DrawRectWorld(farmRect, cameraOffset, farmBase);
+
+    // Check if this tile has a flower patch and create prepared bed
+    bool hasFlowerPatch = (tile.flags & TILE_FLOWER_BED) != 0;
+
+    if (hasFlowerPatch) {
+        // Create a prepared flower bed with darker, richer soil
+        SDL_Color preparedSoil = {95, 127, 58, 255}; // Garden-like soil for flowers
+        Rect flowerBed(x * TILE_SIZE + 25, y * TILE_SIZE + 25, 65, 65);
+        renderer->DrawRectWorld(flowerBed, cameraOffset, preparedSoil);
+
+        // Add subtle prepared soil texture
+        for (int i = 0; i < 4; i++) {
+            int soilX = x * TILE_SIZE + 30 + (i % 2) * 25;
+            int soilY = y * TILE_SIZE + 30 + (i / 2) * 25;
+            Rect soilPatch(soilX, soilY, 15, 15);
+            SDL_Color soilVariation = ((i % 2) == 0) ? 
+                SDL_Color{105, 137, 68, 255} : SDL_Color{85, 117, 48, 255};
+            renderer->DrawRectWorld(soilPatch, cameraOffset, soilVariation);
+        }
+    } else {
+        // Regular farm soil texture for non-flower areas
+        for (int i = 0; i < 6; i++) {
+            int soilX = x * TILE_SIZE + 15 + (i % 3) * 32;
+            int soilY = y * TILE_SIZE + 15 + (i / 3) * 32;
+            Rect soilPatch(soilX, soilY, 20, 20);
+            SDL_Color soilVariation = ((i % 2) == 0) ? 
+                SDL_Color{125, 80, 38, 255} : SDL_Color{155, 100, 48, 255};
+            renderer->DrawRectWorld(soilPatch, cameraOffset, soilVariation);
+        }
+    }
+}
+
+void WorldRenderer::RenderGardenTile(Renderer* renderer, int x, int y, const Tile& tile, Vector2 cameraOffset) {
+    // Garden grass base
+    Rect gardenRect(x * TILE_SIZE, y * TILE_SIZE, TILE_SIZE, TILE_SIZE);
+    renderer->DrawRectWorld(gardenRect, cameraOffset, colors_.garden);
+
+    // Check if this tile has a flower patch and create prepared bed
+    bool hasFlowerPatch = (tile.flags & TILE_FLOWER_BED) != 0;
+
+    if (hasFlowerPatch) {
+        // Create a prepared flower bed with richer garden soil
+        SDL_Color preparedGarden = {75, 97, 37, 255}; // Darker garden soil for flowers
+        Rect flowerBed(x * TILE_SIZE + 30, y * TILE_SIZE + 30, 55, 55);
+        renderer->DrawRectWorld(flowerBed, cameraOffset, preparedGarden);
+
+        // Add subtle prepared garden texture
+        for (int i = 0; i < 4; i++) {
+            int soilX = x * TILE_SIZE + 35 + (i % 2) * 20;
+            int soilY = y * TILE_SIZE + 35 + (i / 2) * 20;
+            Rect soilPatch(soilX, soilY, 12, 12);
+            SDL_Color soilVariation = ((i % 2) == 0) ? 
+                SDL_Color{85, 107, 47, 255} : SDL_Color{65, 87, 27, 255};
+            renderer->DrawRectWorld(soilPatch, cameraOffset, soilVariation);
+        }
+    } else {
+        // Regular grass texture for non-flower areas
+        for (int i = 0; i < 15; i++) {
+            int grassX = x * TILE_SIZE + 10 + (i % 5) * 22;
+            int grassY = y * TILE_SIZE + 10 + (i / 5) * 22;
+            Rect grassPatch(grassX, grassY, 14, 14);
+            SDL_Color grassVariation = ((i % 3) == 0) ? 
+                SDL_Color{95, 117, 42, 255} : SDL_Color{75, 97, 37, 255};
+            renderer->DrawRectWorld(grassPatch, cameraOffset, grassVariation);
+        }
+    }
+
+    // Enhanced 3D bushes
+    if (tile.flags & TILE_BUSH) {
+        // Bush shadow
+        Rect bushShadow(x * TILE_SIZE + 43, y * TILE_SIZE + 43, 40, 30);
+        renderer->DrawRectWorld(bushShadow, cameraOffset, SDL_Color{0, 0, 0, 50});
+
+        // Bush base
+        Rect bushRect(x * TILE_SIZE + 40, y * TILE_SIZE + 40, 40, 30);
+        renderer->DrawRectWorld(bushRect, cameraOffset, SDL_Color{34, 85, 34, 255});
+
+        // Bush layers for depth
+        Rect bushLayer1(x * TILE_SIZE + 42, y * TILE_SIZE + 38, 36, 25);
+        renderer->DrawRectWorld(bushLayer1, cameraOffset, SDL_Color{44, 95, 44, 255});
+
+        Rect bushLayer2(x * TILE_SIZE + 45, y * TILE_SIZE + 35, 30, 20);
+        renderer->DrawRectWorld(bushLayer2, cameraOffset, SDL_Color{54, 105, 54, 255});
+
+        // Bush highlights
+        Rect bushHighlight1(x * TILE_SIZE + 40, y * TILE_SIZE + 37, 20, 6);
+        renderer->DrawRectWorld(bushHighlight1, cameraOffset, SDL_Color{70, 130, 70, 255});
+
+        Rect bushHighlight2(x * TILE_SIZE + 55, y * TILE_SIZE + 40, 15, 4);
+        renderer->DrawRectWorld(bushHighlight2, cameraOffset, SDL_Color{80, 140, 80, 255});
+    }
+
+    // Enhanced grass blade details with shadows
+    for (int i = 0; i < 12; i++) {
+        int grassX = x * TILE_SIZE + 8 + (i % 4) * 28;
+        int grassY = y * TILE_SIZE + 8 + (i / 4) * 28;
+
+        // Grass shadow
+        Rect grassShadow(grassX + 1, grassY + 1, 3, 12);
+        renderer->DrawRectWorld(grassShadow, cameraOffset, SDL_Color{0, 0, 0, 20});
+
+        // Grass blade
+        Rect grassDetail(grassX, grassY, 3, 12);
+        SDL_Color grassColor = ((i % 3) == 0) ? 
+            SDL_Color{120, 160, 50, 255} : SDL_Color{100, 140, 40, 255};
+        renderer->DrawRectWorld(grassDetail, cameraOffset, grassColor);
+
+        // Grass highlight
+        Rect grassHighlight(grassX, grassY, 1, 6);
+        renderer->DrawRectWorld(grassHighlight, cameraOffset, SDL_Color{140, 180, 60, 255});
+    }
+}
+
+void WorldRenderer::RenderDirtPath(Renderer* renderer, int x, int y, bool isHorizontal, Vector2 cameraOffset) {
+    if (isHorizontal) {
+        // Worn dirt path base with natural variation
+        Rect pathRect(x * TILE_SIZE, y * TILE_SIZE, TILE_SIZE, TILE_SIZE);
+        renderer->DrawRectWorld(pathRect, cameraOffset, colors_.dirtPath);
+
+        // Add natural dirt texture with organic patches
+        for (int i = 0; i < 24; i++) {
+            int dirtX = x * TILE_SIZE + 8 + (i % 6) * 18 + ((i % 3) * 4); // Irregular spacing
+            int dirtY = y * TILE_SIZE + 8 + (i / 6) * 25 + ((i % 2) * 6);
+            int patchSize = 12 + (i % 8); // Varied patch sizes
+
+            SDL_Color dirtVariation;
+            if (i % 4 == 0) {
+                dirtVariation = {140, 110, 78, 255}; // Darker dirt
+            } else if (i % 4 == 1) {
+                dirtVariation = {175, 145, 118, 255}; // Lighter dirt
+            } else if (i % 4 == 2) {
+                dirtVariation = {155, 120, 85, 255}; // Medium dirt
+            } else {
+                dirtVariation = {130, 105, 70, 255}; // Rich earth
+            }
+
+            Rect dirtPatch(dirtX, dirtY, patchSize, patchSize - 2);
+            renderer->DrawRectWorld(dirtPatch, cameraOffset, dirtVariation);
+        }
+
+        // Add small pebbles and natural debris
+        for (int i = 0; i < 8; i++) {
+            int pebbleX = x * TILE_SIZE + 15 + (i % 3) * 35 + ((i % 2) * 10);
+            int pebbleY = y * TILE_SIZE + 20 + (i / 3) * 30 + ((i % 3) * 8);
+
+            // Small pebble
+            Rect pebble(pebbleX, pebbleY, 4 + (i % 3), 3 + (i % 2));
+            SDL_Color pebbleColor = ((i % 2) == 0) ? 
+                SDL_Color{120, 115, 110, 255} : SDL_Color{105, 100, 95, 255};
+            renderer->DrawRectWorld(pebble, cameraOffset, pebbleColor);
+        }
+
+        // Natural grass edges bleeding into path
+        for (int i = 0; i < 6; i++) {
+            int grassX = x * TILE_SIZE + (i % 2) * 110 + ((i % 3) * 8);
+            int grassY = y * TILE_SIZE + (i / 2) * 40 + ((i % 2) * 12);
+
+            Rect grassTuft(grassX, grassY, 8, 6);
+            renderer->DrawRectWorld(grassTuft, cameraOffset, SDL_Color{108, 144, 47, 200}); // Semi-transparent grass
+        }
+    } else {
+        // Worn dirt path base
+        Rect pathRect(x * TILE_SIZE, y * TILE_SIZE, TILE_SIZE, TILE_SIZE);
+        renderer->DrawRectWorld(pathRect, cameraOffset, colors_.dirtPath);
+
+        // Add natural dirt texture with organic patches
+        for (int i = 0; i < 20; i++) {
+            int dirtX = x * TILE_SIZE + 6 + (i % 5) * 22 + ((i % 3) * 5);
+            int dirtY = y * TILE_SIZE + 6 + (i / 5) * 28 + ((i % 2) * 7);
+            int patchSize = 10 + (i % 6);
+
+            SDL_Color dirtVariation;
+            if (i % 5 == 0) {
+                dirtVariation = {135, 105, 75, 255}; // Rich earth
+            } else if (i % 5 == 1) {
+                dirtVariation = {170, 140, 115, 255}; // Light dirt
+            } else if (i % 5 == 2) {
+                dirtVariation = {145, 115, 80, 255}; // Medium dirt
+            } else if (i % 5 == 3) {
+                dirtVariation = {125, 95, 65, 255}; // Dark soil
+            } else {
+                dirtVariation = {160, 125, 90, 255}; // Sandy dirt
+            }
+
+            Rect dirtPatch(dirtX, dirtY, patchSize, patchSize - 1);
+            renderer->DrawRectWorld(dirtPatch, cameraOffset, dirtVariation);
+        }
+
+        // Add footprint-like indentations for Ghibli charm
+        for (int i = 0; i < 6; i++) {
+            int footX = x * TILE_SIZE + 25 + (i % 2) * 45 + ((i % 3) * 6);
+            int footY = y * TILE_SIZE + 15 + (i / 2) * 35;
+
+            // Footprint depression
+            Rect footprint(footX, footY, 18, 10);
+            renderer->DrawRectWorld(footprint, cameraOffset, SDL_Color{125, 95, 65, 255});
+
+            // Footprint toes
+            for (int j = 0; j < 3; j++) {
+                Rect toe(footX + 2 + j * 4, footY - 2, 3, 3);
+                renderer->DrawRectWorld(toe, cameraOffset, SDL_Color{120, 90, 60, 255});
+            }
+        }
+
+        // Scattered pebbles and organic elements
+        for (int i = 0; i < 10; i++) {
+            int pebbleX = x * TILE_SIZE + 10 + (i % 4) * 28 + ((i % 2) * 12);
+            int pebbleY = y * TILE_SIZE + 12 + (i / 4) * 35 + ((i % 3) * 10);
+
+            Rect pebble(pebbleX, pebbleY, 3 + (i % 4), 2 + (i % 3));
+            SDL_Color pebbleColor = ((i % 3) == 0) ? 
+                SDL_Color{115, 110, 105, 255} : SDL_Color{95, 90, 85, 255};
+            renderer->DrawRectWorld(pebble, cameraOffset, pebbleColor);
+        }
+
+        // Natural grass tufts growing along path edges
+        for (int i = 0; i < 8; i++) {
+            int grassX = x * TILE_SIZE + (i % 2) * 115 + ((i % 4) * 6);
+            int grassY = y * TILE_SIZE + 5 + (i / 2) * 28 + ((i % 3) * 8);
+
+            Rect grassTuft(grassX, grassY, 6 + (i % 3), 8);
+            renderer->DrawRectWorld(grassTuft, cameraOffset, SDL_Color{108, 144, 47, 180});
+        }
+    }
+}
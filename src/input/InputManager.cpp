@@ -2,7 +2,7 @@
 #include <cstdio>
 #include <iostream>
 
-InputManager::InputManager() {
+InputManager::InputManager() : current_state_(0), previous_state_(0) {
     InitializeKeyBindings();
 }
 
@@ -26,55 +26,49 @@ void InputManager::Update() {
     previous_state_ = current_state_;
 }
 
+void InputManager::SetAction(InputAction action, bool held) {
+    if (held) {
+        current_state_ |= ActionBit(action);
+    } else {
+        current_state_ &= ~ActionBit(action);
+    }
+}
+
 void InputManager::HandleEvent(const SDL_Event& event) {
     if (event.type == SDL_KEYDOWN) {
         // Check for CMD+Q (or CTRL+Q on non-Mac)
         if (event.key.keysym.sym == SDLK_q && (event.key.keysym.mod & KMOD_GUI)) {
-            current_state_[InputAction::QUIT] = true;
+            SetAction(InputAction::QUIT, true);
         }
         // Regular key bindings
         else {
             auto it = key_bindings_.find(event.key.keysym.sym);
             if (it != key_bindings_.end()) {
-                current_state_[it->second] = true;
+                SetAction(it->second, true);
             }
         }
     }
     else if (event.type == SDL_KEYUP) {
         if (event.key.keysym.sym == SDLK_q && (event.key.keysym.mod & KMOD_GUI)) {
-            current_state_[InputAction::QUIT] = false;
+            SetAction(InputAction::QUIT, false);
         }
         else {
             auto it = key_bindings_.find(event.key.keysym.sym);
             if (it != key_bindings_.end()) {
-                current_state_[it->second] = false;
+                SetAction(it->second, false);
             }
         }
     }
 }
 
 bool InputManager::IsActionPressed(InputAction action) const {
-    auto currentIt = current_state_.find(action);
-    auto previousIt = previous_state_.find(action);
-    
-    bool currentPressed = (currentIt != current_state_.end()) ? currentIt->second : false;
-    bool previousPressed = (previousIt != previous_state_.end()) ? previousIt->second : false;
-    
-    
-    return currentPressed && !previousPressed;
+    return (current_state_ & ActionBit(action)) && !(previous_state_ & ActionBit(action));
 }
 
 bool InputManager::IsActionHeld(InputAction action) const {
-    auto it = current_state_.find(action);
-    return (it != current_state_.end()) ? it->second : false;
+    return (current_state_ & ActionBit(action)) != 0;
 }
 
 bool InputManager::IsActionReleased(InputAction action) const {
-    auto currentIt = current_state_.find(action);
-    auto previousIt = previous_state_.find(action);
-    
-    bool currentPressed = (currentIt != current_state_.end()) ? currentIt->second : false;
-    bool previousPressed = (previousIt != previous_state_.end()) ? previousIt->second : false;
-    
-    return !currentPressed && previousPressed;
+    return !(current_state_ & ActionBit(action)) && (previous_state_ & ActionBit(action));
 }
\ No newline at end of file
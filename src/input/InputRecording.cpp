@@ -0,0 +1,119 @@
+#include "InputRecording.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+const char MAGIC[4] = {'Y', 'R', 'E', 'P'};
+
+} // namespace
+
+InputRecording::InputRecording() : header_(), run_(0), stepInRun_(0) {
+}
+
+void InputRecording::Begin(Uint32 seed, int simulationRate, int startHour) {
+    header_ = Header();
+    std::memcpy(header_.magic, MAGIC, sizeof(MAGIC));
+    header_.version = VERSION;
+    header_.seed = seed;
+    header_.simulationRate = static_cast<Uint32>(simulationRate);
+    header_.startHour = static_cast<Uint32>(startHour);
+    runs_.clear();
+    run_ = 0;
+    stepInRun_ = 0;
+}
+
+void InputRecording::Record(Uint32 actions) {
+    if (!runs_.empty() && runs_.back().actions == actions) {
+        runs_.back().steps++;
+    } else {
+        runs_.push_back(Run{actions, 1});
+    }
+    header_.stepCount++;
+}
+
+bool InputRecording::Save(const std::string& path, Uint32 stateHash) {
+    header_.runCount = static_cast<Uint32>(runs_.size());
+    header_.stateHash = stateHash;
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        std::cerr << "Can't write input recording: " << path << std::endl;
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(&header_), sizeof(header_));
+    out.write(reinterpret_cast<const char*>(runs_.data()), runs_.size() * sizeof(Run));
+    if (!out) {
+        std::cerr << "Failed writing input recording: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool InputRecording::Load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        std::cerr << "Can't open input recording: " << path << std::endl;
+        return false;
+    }
+    Uint64 fileSize = static_cast<Uint64>(in.tellg());
+    in.seekg(0);
+
+    Header header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        std::cerr << "Not an input recording: " << path << std::endl;
+        return false;
+    }
+    if (header.version != VERSION) {
+        std::cerr << "Input recording " << path << " is version " << header.version
+                  << ", expected " << VERSION << std::endl;
+        return false;
+    }
+    if (header.simulationRate == 0 || header.startHour >= 24 || header.stepCount == 0) {
+        std::cerr << "Input recording has invalid settings: " << path << std::endl;
+        return false;
+    }
+
+    // Sized against the file before anything is allocated for it
+    if (static_cast<Uint64>(header.runCount) * sizeof(Run) != fileSize - sizeof(Header)) {
+        std::cerr << "Input recording " << path << " is truncated or has trailing data" << std::endl;
+        return false;
+    }
+
+    std::vector<Run> runs(header.runCount);
+    if (!in.read(reinterpret_cast<char*>(runs.data()), runs.size() * sizeof(Run))) {
+        std::cerr << "Input recording is truncated: " << path << std::endl;
+        return false;
+    }
+
+    Uint64 steps = 0;
+    for (const Run& run : runs) {
+        steps += run.steps;
+    }
+    if (steps != header.stepCount) {
+        std::cerr << "Input recording " << path << " holds " << steps << " steps, its header says "
+                  << header.stepCount << std::endl;
+        return false;
+    }
+
+    header_ = header;
+    runs_ = std::move(runs);
+    run_ = 0;
+    stepInRun_ = 0;
+    return true;
+}
+
+bool InputRecording::Next(Uint32& actions) {
+    // Skip empty runs
+    while (run_ < runs_.size() && stepInRun_ >= runs_[run_].steps) {
+        run_++;
+        stepInRun_ = 0;
+    }
+    if (run_ >= runs_.size()) return false;
+
+    actions = runs_[run_].actions;
+    stepInRun_++;
+    return true;
+}
@@ -1,10 +1,16 @@
 #include "Game.h"
+#include "GameInit.h"
 #include <iostream>
 
 int main(int argc, char* argv[]) {
+    GameOptions options;
+    if (!GameInit::ParseCommandLine(argc, argv, options)) {
+        return -1;
+    }
+    
     Game game;
     
-    if (!game.Initialize()) {
+    if (!game.Initialize(options)) {
         std::cerr << "Failed to initialize game!" << std::endl;
         return -1;
     }
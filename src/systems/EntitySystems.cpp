@@ -0,0 +1,130 @@
+#include "EntitySystems.h"
+#include <cmath>
+#include <functional>
+
+namespace {
+
+const float PLAYER_BOUNCE_DISTANCE = 35.0f; // Walking entities keep at least this far from the player
+const size_t ENTITIES_PER_JOB = 2048;
+
+// Over every entity, on the job system when there is one
+void ForEachRange(JobSystem* jobs, size_t count, const std::function<void(size_t begin, size_t end)>& range) {
+    if (jobs) {
+        jobs->ParallelFor(count, ENTITIES_PER_JOB, range);
+    } else {
+        range(0, count);
+    }
+}
+
+} // namespace
+
+namespace EntitySystems {
+
+void UpdateMovement(EntityStore& store, float deltaTime, const Vector2& playerPosition,
+                    const CollisionWorld* collisionWorld, JobSystem* jobs) {
+    EntityComponents& c = store.GetComponents();
+    size_t count = c.Size();
+
+    c.previousX = c.positionX;
+    c.previousY = c.positionY;
+
+    // Decide every move while positions still hold; each entity only writes its own target and velocity
+    const float bounceDistanceSquared = PLAYER_BOUNCE_DISTANCE * PLAYER_BOUNCE_DISTANCE;
+    ForEachRange(jobs, count, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            c.targetX[i] = c.positionX[i];
+            float step = c.velocityX[i] * deltaTime;
+            if (step == 0.0f) continue;
+
+            // Turn around rather than step into the player
+            if (c.flags[i] & ENTITY_BOUNCES_OFF_PLAYER) {
+                float dx = c.positionX[i] + step - playerPosition.x;
+                float dy = c.positionY[i] - playerPosition.y;
+                if (dx * dx + dy * dy < bounceDistanceSquared) {
+                    c.velocityX[i] = -c.velocityX[i];
+                    step = -step;
+                }
+            }
+
+            // Turn around at anything solid. Only the strip the collision box moves into is
+            // tested, so a body that starts out overlapping something can still walk away.
+            if (collisionWorld) {
+                const RenderStyle& style = store.GetStyle(c.renderStyle[i]);
+                int oldX = static_cast<int>(c.positionX[i]);
+                int newX = static_cast<int>(c.positionX[i] + step);
+                int y = static_cast<int>(c.positionY[i]);
+                Rect strip = newX > oldX ? Rect(oldX + style.collisionWidth, y, newX - oldX, style.collisionHeight)
+                                         : Rect(newX, y, oldX - newX, style.collisionHeight);
+                if (strip.w > 0 && collisionWorld->IsBlocked(strip, c.id[i])) {
+                    c.velocityX[i] = -c.velocityX[i];
+                    continue;
+                }
+            }
+
+            float x = c.positionX[i] + step;
+            if (x <= c.patrolMinX[i]) {
+                x = c.patrolMinX[i];
+                c.velocityX[i] = std::fabs(c.velocityX[i]);
+            } else if (x >= c.patrolMaxX[i]) {
+                x = c.patrolMaxX[i];
+                c.velocityX[i] = -std::fabs(c.velocityX[i]);
+            }
+            c.targetX[i] = x;
+        }
+    });
+
+    // Apply the moves; the spatial hash is only touched from here
+    for (size_t i = 0; i < count; ++i) {
+        if (c.targetX[i] == c.positionX[i]) continue;
+        c.positionX[i] = c.targetX[i];
+        store.Relocate(i);
+    }
+}
+
+void UpdateAnimation(EntityStore& store, float deltaTime, JobSystem* jobs) {
+    EntityComponents& c = store.GetComponents();
+    size_t count = c.Size();
+
+    float loopSeconds[static_cast<int>(SpriteSheet::COUNT)];
+    for (int sheet = 0; sheet < static_cast<int>(SpriteSheet::COUNT); ++sheet) {
+        loopSeconds[sheet] = store.GetStyle(static_cast<SpriteSheet>(sheet)).loopSeconds;
+    }
+
+    ForEachRange(jobs, count, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            float time = c.animationTime[i] + deltaTime;
+            c.animationTime[i] = time > loopSeconds[static_cast<int>(c.renderStyle[i])] ? 0.0f : time;
+        }
+    });
+}
+
+void CollectSprites(const EntityStore& store, const Rect& area, std::vector<SpriteInstance>& sprites) {
+    const EntityComponents& c = store.GetComponents();
+
+    // Only what is near the view, the rest of the crowd costs nothing to draw
+    static thread_local std::vector<Uint32> visible;
+    visible.clear();
+    store.FindIndicesInArea(area, visible);
+    sprites.reserve(sprites.size() + visible.size());
+
+    for (Uint32 i : visible) {
+        const RenderStyle& style = store.GetStyle(c.renderStyle[i]);
+
+        // Quantize the animation timer to one of the pre-rendered frames
+        int frame = 0;
+        if (style.loopSeconds > 0.0f) {
+            frame = static_cast<int>(c.animationTime[i] / style.loopSeconds * style.frames);
+            if (frame >= style.frames) frame = style.frames - 1;
+        }
+        int facing = c.velocityX[i] < 0.0f ? 1 : 0; // Right, left
+
+        Vector2 position(c.positionX[i], c.positionY[i]);
+        Rect bounds(static_cast<int>(position.x) + style.bounds.x, static_cast<int>(position.y) + style.bounds.y,
+                    style.bounds.w, style.bounds.h);
+        SpriteInstance sprite(c.renderStyle[i], frame, facing, position, bounds);
+        sprite.previousPosition = Vector2(c.previousX[i], c.previousY[i]);
+        sprites.push_back(sprite);
+    }
+}
+
+} // namespace EntitySystems
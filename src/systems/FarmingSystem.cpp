@@ -1,16 +1,25 @@
 #include "FarmingSystem.h"
+#include <algorithm>
 
 FarmingSystem::FarmingSystem(int width, int height)
     : grid_width_(width), grid_height_(height), tile_size_(32) {
     farm_grid_.resize(grid_height_, std::vector<FarmTile>(grid_width_));
 }
 
-void FarmingSystem::Update(float deltaTime) {
-    UpdateCropGrowth(deltaTime);
+void FarmingSystem::Update(float deltaTime, JobSystem* jobs) {
+    int rows_per_job = std::max(1, TILES_PER_JOB / std::max(1, grid_width_));
+    if (!jobs || grid_height_ <= rows_per_job) {
+        UpdateCropGrowth(deltaTime, 0, grid_height_);
+        return;
+    }
+    jobs->ParallelFor(grid_height_, rows_per_job, [this, deltaTime](size_t begin, size_t end) {
+        UpdateCropGrowth(deltaTime, static_cast<int>(begin), static_cast<int>(end));
+    });
 }
 
-void FarmingSystem::UpdateCropGrowth(float deltaTime) {
-    for (int y = 0; y < grid_height_; ++y) {
+void FarmingSystem::UpdateCropGrowth(float deltaTime, int first_row, int last_row) {
+    // Rows first_row up to (not including) last_row; every tile only touches itself
+    for (int y = first_row; y < last_row; ++y) {
         for (int x = 0; x < grid_width_; ++x) {
             FarmTile& tile = farm_grid_[y][x];
             
@@ -0,0 +1,37 @@
+#include "LightingSystem.h"
+#include <algorithm>
+#include <cmath>
+
+LightingSystem::LightingSystem(int startHour)
+    : next_light_id_(1), version_(1), hour_(static_cast<float>(startHour % 24)) {
+}
+
+void LightingSystem::Update(float deltaTime) {
+    hour_ = std::fmod(hour_ + deltaTime * 24.0f / DAY_LENGTH_SECONDS, 24.0f);
+}
+
+int LightingSystem::GetSunStep() const {
+    return std::min(static_cast<int>(hour_ * LightMap::SUN_STEPS / 24.0f), LightMap::SUN_STEPS - 1);
+}
+
+Uint32 LightingSystem::AddLight(int x, int y, int radius, SDL_Color color) {
+    // Ids only grow, so appending keeps the list in id order
+    PointLight light;
+    light.id = next_light_id_++;
+    light.x = x;
+    light.y = y;
+    light.radius = radius;
+    light.color = color;
+    lights_.push_back(light);
+    version_++;
+    return light.id;
+}
+
+void LightingSystem::RemoveLight(Uint32 id) {
+    auto it = std::lower_bound(lights_.begin(), lights_.end(), id,
+                               [](const PointLight& light, Uint32 value) { return light.id < value; });
+    if (it == lights_.end() || it->id != id) return;
+
+    lights_.erase(it);
+    version_++;
+}
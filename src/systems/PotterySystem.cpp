@@ -1,10 +1,9 @@
 #include "PotterySystem.h"
-#include <random>
 #include <chrono>
 
-PotterySystem::PotterySystem()
+PotterySystem::PotterySystem(unsigned int seed)
     : basic_clay_count_(10), red_clay_count_(5), white_clay_count_(3),
-      is_crafting_(false), current_recipe_(nullptr), crafting_progress_(0.0f) {
+      is_crafting_(false), current_recipe_(nullptr), crafting_progress_(0.0f), random_(seed) {
     InitializeRecipes();
 }
 
@@ -140,11 +139,8 @@ int PotterySystem::GetClayAmount(ClayType clayType) const {
     }
 }
 
-int PotterySystem::CalculateQuality() const {
-    // Simple random quality system (1-5 stars)
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(1, 5);
-    
-    return dis(gen);
+int PotterySystem::CalculateQuality() {
+    // Simple random quality system (1-5 stars). The engine's output is the same
+    // everywhere, unlike std::uniform_int_distribution's, so replays match across platforms
+    return 1 + static_cast<int>(random_() % 5);
 }
\ No newline at end of file
@@ -1,72 +1,32 @@
 #include "DialogueSystem.h"
-#include "NPC.h"
-#include "InteractableObject.h"
 #include <algorithm>
 #include <iostream>
 
 DialogueSystem::DialogueSystem() 
     : isActive_(false), nearInteractable_(false), currentText_(""), 
       currentType_(InteractableType::NONE), nearbyType_(InteractableType::NONE),
-      currentInteractable_(nullptr), displayTimer_(0.0f), fadeAlpha_(0.0f) {
+      currentEntity_(INVALID_ENTITY), displayTimer_(0.0f), fadeAlpha_(0.0f), renderVersion_(0),
+      entityStore_(nullptr) {
 }
 
 DialogueSystem::~DialogueSystem() {
 }
 
 void DialogueSystem::Initialize() {
-    SetupInteractionZones();
+    interactionZones_.clear();
 }
 
-void DialogueSystem::SetupInteractionZones() {
-    const int TILE_SIZE = 128;
-    
-    // House interaction zone (tiles 2,2 to 3,3 = 256,256 to 512,512)
-    Rect houseZone(2 * TILE_SIZE, 2 * TILE_SIZE, 2 * TILE_SIZE, 2 * TILE_SIZE);
-    std::vector<std::string> houseDialogues = {
-        "A cozy cottage with a red tile roof.",
-        "Windows reflect warm sunlight beautifully.",
-        "This looks like a peaceful place to live."
-    };
-    interactionZones_.push_back(InteractionZone(houseZone, InteractableType::HOUSE, houseDialogues));
-    
-    // Farm interaction zone (tiles 6,2 to 8,4 = 768,256 to 1152,640)
-    Rect farmZone(6 * TILE_SIZE, 2 * TILE_SIZE, 3 * TILE_SIZE, 3 * TILE_SIZE);
-    std::vector<std::string> farmDialogues = {
-        "Rich soil perfect for growing crops.",
-        "The seedlings are sprouting nicely!",
-        "This farm bed looks well-maintained."
-    };
-    interactionZones_.push_back(InteractionZone(farmZone, InteractableType::FARM, farmDialogues));
-    
-    // Garden area (tiles 3,5 to 6,6 = 384,640 to 896,896)
-    Rect gardenZone(3 * TILE_SIZE, 5 * TILE_SIZE, 4 * TILE_SIZE, 2 * TILE_SIZE);
-    std::vector<std::string> gardenDialogues = {
-        "Beautiful flowers bloom here in vibrant colors.",
-        "The sweet fragrance fills the air.",
-        "These flowers attract butterflies and bees."
-    };
-    interactionZones_.push_back(InteractionZone(gardenZone, InteractableType::GARDEN_FLOWER, gardenDialogues));
-    
-    // Farm flower patch 1 (top-left corner: tile 6,2)
-    Rect farmFlower1Zone(6 * TILE_SIZE, 2 * TILE_SIZE, TILE_SIZE, TILE_SIZE);
-    std::vector<std::string> farmFlower1Dialogues = {
-        "These lovely flowers brighten up the farm area.",
-        "Pink, yellow, and coral blooms dance in the breeze.",
-        "The flowers seem well-tended and healthy."
-    };
-    interactionZones_.push_back(InteractionZone(farmFlower1Zone, InteractableType::FARM_FLOWERS, farmFlower1Dialogues));
-    
-    // Farm flower patch 2 (bottom-right corner: tile 8,4)
-    Rect farmFlower2Zone(8 * TILE_SIZE, 4 * TILE_SIZE, TILE_SIZE, TILE_SIZE);
-    std::vector<std::string> farmFlower2Dialogues = {
-        "A colorful patch of flowers adds beauty to this corner.",
-        "The farmer must have a soft spot for flowers.",
-        "These blooms provide a nice contrast to the crops."
-    };
-    interactionZones_.push_back(InteractionZone(farmFlower2Zone, InteractableType::FARM_FLOWERS, farmFlower2Dialogues));
+void DialogueSystem::AddInteractionZone(const InteractionZone& zone) {
+    interactionZones_.push_back(zone);
 }
 
 void DialogueSystem::Update(float deltaTime) {
+    // Don't keep talking to something that has despawned
+    if (currentEntity_ != INVALID_ENTITY && !(entityStore_ && entityStore_->IsAlive(currentEntity_))) {
+        currentEntity_ = INVALID_ENTITY;
+        HideDialogue();
+    }
+    
     if (isActive_) {
         displayTimer_ += deltaTime;
         
@@ -91,10 +51,11 @@ InteractableType DialogueSystem::CheckNearbyInteraction(const Vector2& playerPos
         32  // PLAYER_HEIGHT
     );
     
-    // First check dynamic interactables (they get priority)
-    for (const auto& interactable : dynamicInteractables_) {
-        if (interactable && interactable->IsPlayerInRange(playerPosition)) {
-            return interactable->GetType();
+    // First check entities (they get priority)
+    if (entityStore_) {
+        EntityId entity = entityStore_->FindInteractable(playerPosition);
+        if (entity != INVALID_ENTITY) {
+            return entityStore_->GetInteractionType(entity);
         }
     }
     
@@ -127,6 +88,14 @@ InteractableType DialogueSystem::CheckNearbyInteraction(const Vector2& playerPos
 }
 
 bool DialogueSystem::CheckInteraction(const Vector2& playerPosition, const Vector2& cameraOffset) {
+    if (entityStore_) {
+        EntityId entity = entityStore_->FindInteractable(playerPosition);
+        if (entity != INVALID_ENTITY) {
+            ShowDialogue(entity);
+            return true;
+        }
+    }
+    
     InteractableType nearbyType = CheckNearbyInteraction(playerPosition);
     
     if (nearbyType != InteractableType::NONE) {
@@ -138,77 +107,46 @@ bool DialogueSystem::CheckInteraction(const Vector2& playerPosition, const Vecto
 }
 
 void DialogueSystem::ShowDialogue(InteractableType type) {
+    // Static zones; entities are shown with ShowDialogue(EntityId)
     currentType_ = type;
-    currentInteractable_ = nullptr;
+    currentEntity_ = INVALID_ENTITY;
     
-    if (type == InteractableType::NPC) {
-        // Handle dynamic NPCs - this should not be used anymore
-        // Use ShowDialogue(Interactable*) instead
-        for (const auto& interactable : dynamicInteractables_) {
-            if (interactable && interactable->GetType() == type) {
-                if (auto npc = dynamic_cast<NPC*>(interactable)) {
-                    currentText_ = npc->GetCurrentDialogue();
-                    currentInteractable_ = interactable;
-                    break;
-                }
-            }
-        }
-    } else {
-        // Handle static zones
-        auto dialogues = GetDialogueForType(type);
-        if (!dialogues.empty()) {
-            for (auto& zone : interactionZones_) {
-                if (zone.type == type) {
-                    currentText_ = dialogues[zone.currentDialogue];
-                    break;
-                }
+    auto dialogues = GetDialogueForType(type);
+    if (!dialogues.empty()) {
+        for (auto& zone : interactionZones_) {
+            if (zone.type == type) {
+                currentText_ = dialogues[zone.currentDialogue];
+                break;
             }
         }
     }
     
     isActive_ = true;
     displayTimer_ = 0.0f;
+    renderVersion_++;
     fadeAlpha_ = 255.0f; // Start fully visible
 }
 
-void DialogueSystem::ShowDialogue(Interactable* specificInteractable) {
-    if (!specificInteractable) return;
-    
-    currentType_ = specificInteractable->GetType();
-    currentInteractable_ = specificInteractable;
-    
-    if (auto npc = dynamic_cast<NPC*>(specificInteractable)) {
-        currentText_ = npc->GetCurrentDialogue();
-    }
-    
-    isActive_ = true;
-    displayTimer_ = 0.0f;
-    fadeAlpha_ = 255.0f; // Start fully visible
-}
-
-void DialogueSystem::ShowDialogue(InteractableObject* specificObject) {
-    if (!specificObject) return;
+void DialogueSystem::ShowDialogue(EntityId entity) {
+    if (!entityStore_ || !entityStore_->IsAlive(entity)) return;
     
-    currentType_ = specificObject->GetType();
-    currentInteractable_ = specificObject; // InteractableObject inherits from Interactable
-    
-    auto dialogue = specificObject->GetDialogue();
-    if (!dialogue.empty()) {
-        currentText_ = dialogue[0]; // Show first dialogue
-    }
+    currentType_ = entityStore_->GetInteractionType(entity);
+    currentEntity_ = entity;
+    currentText_ = entityStore_->GetDialogueLine(entity);
     
     isActive_ = true;
     displayTimer_ = 0.0f;
+    renderVersion_++;
     fadeAlpha_ = 255.0f; // Start fully visible
 }
 
 void DialogueSystem::NextDialogue() {
-    if (currentType_ == InteractableType::NPC && currentInteractable_) {
+    if (currentType_ == InteractableType::NPC && currentEntity_ != INVALID_ENTITY) {
         // Handle the specific NPC we're currently talking to
-        if (auto npc = dynamic_cast<NPC*>(currentInteractable_)) {
-            npc->NextDialogue();
-            currentText_ = npc->GetCurrentDialogue();
+        if (entityStore_->AdvanceDialogue(currentEntity_)) {
+            currentText_ = entityStore_->GetDialogueLine(currentEntity_);
             displayTimer_ = 0.0f;
+            renderVersion_++;
         }
     } else {
         // Handle static zones
@@ -217,6 +155,7 @@ void DialogueSystem::NextDialogue() {
                 zone.currentDialogue = (zone.currentDialogue + 1) % zone.dialogues.size();
                 currentText_ = zone.dialogues[zone.currentDialogue];
                 displayTimer_ = 0.0f;
+                renderVersion_++;
                 break;
             }
         }
@@ -224,72 +163,71 @@ void DialogueSystem::NextDialogue() {
 }
 
 void DialogueSystem::HideDialogue() {
-    isActive_ = false;
+    if (isActive_) {
+        isActive_ = false;
+        renderVersion_++;
+    }
 }
 
 void DialogueSystem::SetNearInteractable(bool near, InteractableType type) {
+    if (nearInteractable_ != near) {
+        renderVersion_++;
+    }
     nearInteractable_ = near;
     nearbyType_ = type;
 }
 
-void DialogueSystem::RegisterDynamicInteractable(Interactable* interactable) {
-    if (interactable) {
-        dynamicInteractables_.push_back(interactable);
-    }
-}
-
-InteractableType DialogueSystem::CheckNearbyDynamicInteraction(const Vector2& playerPosition) {
-    for (const auto& interactable : dynamicInteractables_) {
-        if (interactable && interactable->IsPlayerInRange(playerPosition)) {
-            return interactable->GetType();
-        }
-    }
-    return InteractableType::NONE;
-}
-
-Interactable* DialogueSystem::GetNearbyInteractable(const Vector2& playerPosition) const {
-    // Check dynamic interactables first (NPCs get priority)
-    for (const auto& interactable : dynamicInteractables_) {
-        if (interactable && interactable->IsPlayerInRange(playerPosition)) {
-            return interactable;
-        }
-    }
-    return nullptr;
-}
-
 std::vector<std::string> DialogueSystem::GetDialogueForType(InteractableType type) {
-    // First check static zones
     for (const auto& zone : interactionZones_) {
         if (zone.type == type) {
             return zone.dialogues;
         }
     }
     
-    // Then check dynamic interactables
-    for (const auto& interactable : dynamicInteractables_) {
-        if (interactable && interactable->GetType() == type) {
-            return interactable->GetDialogue();
-        }
-    }
-    
     return {};
 }
 
-void DialogueSystem::Render(Renderer* renderer, int windowWidth, int windowHeight) {
-    if (isActive_) {
-        RenderDialogueBox(renderer, windowWidth, windowHeight);
-    } else if (nearInteractable_) {
+DialogueView DialogueSystem::GetView() const {
+    DialogueView view;
+    view.active = isActive_;
+    view.showPrompt = !isActive_ && nearInteractable_;
+    view.text = currentText_;
+    view.version = renderVersion_;
+    return view;
+}
+
+void DialogueSystem::Render(Renderer* renderer, const DialogueView& view, int windowWidth, int windowHeight) {
+    if (view.active) {
+        RenderDialogueBox(renderer, view.text, windowWidth, windowHeight);
+    } else if (view.showPrompt) {
         // Show interaction prompt when near an object but not actively in dialogue
         RenderInteractionPrompt(renderer, windowWidth, windowHeight);
     }
 }
 
-void DialogueSystem::RenderInteractionPrompt(Renderer* renderer, int windowWidth, int windowHeight) {
+Rect DialogueSystem::GetScreenBounds(const DialogueView& view, int windowWidth, int windowHeight) {
+    if (view.active) return GetDialogueBoxBounds(windowWidth, windowHeight);
+    if (view.showPrompt) return GetPromptBounds(windowWidth);
+    return Rect();
+}
+
+Rect DialogueSystem::GetPromptBounds(int windowWidth) {
     // Wider prompt at the top of the screen
     int promptWidth = 280;
-    int promptHeight = 45;
-    int promptX = (windowWidth - promptWidth) / 2;
-    int promptY = 50;
+    return Rect((windowWidth - promptWidth) / 2, 50, promptWidth, 45);
+}
+
+Rect DialogueSystem::GetDialogueBoxBounds(int windowWidth, int windowHeight) {
+    int boxHeight = 100;
+    return Rect(30, windowHeight - boxHeight - 30, windowWidth - 60, boxHeight);
+}
+
+void DialogueSystem::RenderInteractionPrompt(Renderer* renderer, int windowWidth, int windowHeight) {
+    Rect bounds = GetPromptBounds(windowWidth);
+    int promptWidth = bounds.w;
+    int promptHeight = bounds.h;
+    int promptX = bounds.x;
+    int promptY = bounds.y;
     
     // Semi-transparent background
     Rect promptBox(promptX, promptY, promptWidth, promptHeight);
@@ -313,11 +251,12 @@ void DialogueSystem::RenderInteractionPrompt(Renderer* renderer, int windowWidth
     renderer->RenderText("Press SPACE to interact", promptX + 30, promptY + 18, promptTextColor, 16);
 }
 
-void DialogueSystem::RenderDialogueBox(Renderer* renderer, int windowWidth, int windowHeight) {
-    int boxHeight = 100;
-    int boxY = windowHeight - boxHeight - 30;
-    int boxX = 30;
-    int boxWidth = windowWidth - 60;
+void DialogueSystem::RenderDialogueBox(Renderer* renderer, const std::string& text, int windowWidth, int windowHeight) {
+    Rect bounds = GetDialogueBoxBounds(windowWidth, windowHeight);
+    int boxHeight = bounds.h;
+    int boxY = bounds.y;
+    int boxX = bounds.x;
+    int boxWidth = bounds.w;
     
     // Elegant gradient background
     SDL_Color bgColor = {25, 25, 35, 240}; // Dark blue-grey with transparency
@@ -356,9 +295,9 @@ void DialogueSystem::RenderDialogueBox(Renderer* renderer, int windowWidth, int
     renderer->DrawRect(cornerTR, highlightColor);
     
     // Render main dialogue text with wrapping
-    if (!currentText_.empty()) {
+    if (!text.empty()) {
         SDL_Color textColor = {255, 255, 255, 255};
-        renderer->RenderWrappedText(currentText_, boxX + 20, boxY + 20, boxWidth - 40, textColor, 18);
+        renderer->RenderWrappedText(text, boxX + 20, boxY + 20, boxWidth - 40, textColor, 18);
     }
     
     // Control hints at bottom right
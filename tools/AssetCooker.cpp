@@ -0,0 +1,221 @@
+// Build-time asset cooker: packs every PNG under a source directory into
+// atlas pages and writes an index of named sub-rects for SpriteAtlas.
+//
+// Usage: yolo_asset_cooker <source dir> <output dir>
+//
+// Output:
+//   <output dir>/sprites_<n>.png   atlas pages
+//   <output dir>/sprites.atlas     text index, one line per page/sprite:
+//       page <file>
+//       sprite <name> <page> <x> <y> <w> <h>
+// Sprite names are the PNG paths relative to the source dir, without extension.
+
+#include <SDL.h>
+#include <SDL_image.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const int PAGE_SIZE = 2048;
+const int PADDING = 1; // Transparent gap so filtering never bleeds between sprites
+
+struct SourceImage {
+    std::string name;
+    SDL_Surface* surface;
+    int page;
+    int x, y;
+};
+
+struct Page {
+    int width, height;
+    int shelfX, shelfY, shelfHeight;
+};
+
+std::string SpriteName(const fs::path& file, const fs::path& root) {
+    fs::path relative = fs::relative(file, root);
+    relative.replace_extension();
+    return relative.generic_string();
+}
+
+bool LoadImages(const fs::path& sourceDir, std::vector<SourceImage>& images) {
+    if (!fs::exists(sourceDir)) {
+        // Nothing to cook yet, still emit an empty index so the game finds one
+        std::cout << "No sprite sources at " << sourceDir.string() << std::endl;
+        return true;
+    }
+
+    for (const auto& entry : fs::recursive_directory_iterator(sourceDir)) {
+        if (!entry.is_regular_file() || entry.path().extension() != ".png") continue;
+
+        SDL_Surface* loaded = IMG_Load(entry.path().string().c_str());
+        if (!loaded) {
+            std::cerr << "IMG_Load Error: " << IMG_GetError() << std::endl;
+            return false;
+        }
+
+        SDL_Surface* surface = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+        SDL_FreeSurface(loaded);
+        if (!surface) {
+            std::cerr << "SDL_ConvertSurfaceFormat Error: " << SDL_GetError() << std::endl;
+            return false;
+        }
+
+        images.push_back({SpriteName(entry.path(), sourceDir), surface, -1, 0, 0});
+    }
+
+    return true;
+}
+
+// Shelf packing with sprites sorted tallest first, which keeps shelves tight
+void PackImages(std::vector<SourceImage>& images, std::vector<Page>& pages) {
+    std::sort(images.begin(), images.end(), [](const SourceImage& a, const SourceImage& b) {
+        if (a.surface->h != b.surface->h) return a.surface->h > b.surface->h;
+        return a.name < b.name;
+    });
+
+    for (auto& image : images) {
+        int w = image.surface->w;
+        int h = image.surface->h;
+
+        // Oversized images get a page of their own
+        if (w > PAGE_SIZE || h > PAGE_SIZE) {
+            std::cerr << "Warning: " << image.name << " is larger than an atlas page" << std::endl;
+            pages.push_back({w, h, w, 0, h});
+            image.page = static_cast<int>(pages.size()) - 1;
+            continue;
+        }
+
+        bool placed = false;
+        for (size_t i = 0; i < pages.size() && !placed; ++i) {
+            Page& page = pages[i];
+            if (page.width != PAGE_SIZE) continue;
+
+            if (page.shelfX + w > PAGE_SIZE) {
+                page.shelfX = 0;
+                page.shelfY += page.shelfHeight + PADDING;
+                page.shelfHeight = 0;
+            }
+            if (page.shelfY + h > PAGE_SIZE) continue;
+
+            image.page = static_cast<int>(i);
+            image.x = page.shelfX;
+            image.y = page.shelfY;
+            page.shelfX += w + PADDING;
+            page.shelfHeight = std::max(page.shelfHeight, h);
+            placed = true;
+        }
+
+        if (!placed) {
+            pages.push_back({PAGE_SIZE, PAGE_SIZE, w + PADDING, 0, h});
+            image.page = static_cast<int>(pages.size()) - 1;
+        }
+    }
+}
+
+bool WritePages(const std::vector<SourceImage>& images, const std::vector<Page>& pages,
+                const fs::path& outputDir, std::ofstream& index) {
+    for (size_t i = 0; i < pages.size(); ++i) {
+        // Trim the page to what was actually used
+        int usedWidth = 1;
+        int usedHeight = 1;
+        for (const auto& image : images) {
+            if (image.page != static_cast<int>(i)) continue;
+            usedWidth = std::max(usedWidth, image.x + image.surface->w);
+            usedHeight = std::max(usedHeight, image.y + image.surface->h);
+        }
+
+        SDL_Surface* page = SDL_CreateRGBSurfaceWithFormat(0, usedWidth, usedHeight, 32, SDL_PIXELFORMAT_RGBA32);
+        if (!page) {
+            std::cerr << "SDL_CreateRGBSurfaceWithFormat Error: " << SDL_GetError() << std::endl;
+            return false;
+        }
+        SDL_FillRect(page, nullptr, 0);
+
+        for (const auto& image : images) {
+            if (image.page != static_cast<int>(i)) continue;
+            SDL_SetSurfaceBlendMode(image.surface, SDL_BLENDMODE_NONE);
+            SDL_Rect dest = {image.x, image.y, image.surface->w, image.surface->h};
+            SDL_BlitSurface(image.surface, nullptr, page, &dest);
+        }
+
+        std::string fileName = "sprites_" + std::to_string(i) + ".png";
+        if (IMG_SavePNG(page, (outputDir / fileName).string().c_str()) != 0) {
+            std::cerr << "IMG_SavePNG Error: " << IMG_GetError() << std::endl;
+            SDL_FreeSurface(page);
+            return false;
+        }
+        SDL_FreeSurface(page);
+
+        index << "page " << fileName << "\n";
+    }
+
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <source dir> <output dir>" << std::endl;
+        return 1;
+    }
+
+    fs::path sourceDir = argv[1];
+    fs::path outputDir = argv[2];
+
+    if (SDL_Init(0) != 0) {
+        std::cerr << "SDL_Init Error: " << SDL_GetError() << std::endl;
+        return 1;
+    }
+    if (!(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) {
+        std::cerr << "IMG_Init Error: " << IMG_GetError() << std::endl;
+        SDL_Quit();
+        return 1;
+    }
+
+    std::vector<SourceImage> images;
+    std::vector<Page> pages;
+    bool ok = LoadImages(sourceDir, images);
+
+    if (ok) {
+        PackImages(images, pages);
+
+        std::error_code error;
+        fs::create_directories(outputDir, error);
+        std::ofstream index(outputDir / "sprites.atlas");
+        if (!index) {
+            std::cerr << "Failed to open " << (outputDir / "sprites.atlas").string() << std::endl;
+            ok = false;
+        } else {
+            index << "# Generated by yolo_asset_cooker, do not edit\n";
+            ok = WritePages(images, pages, outputDir, index);
+
+            // Sprites are listed by name so IDs are stable across cooks
+            std::sort(images.begin(), images.end(), [](const SourceImage& a, const SourceImage& b) {
+                return a.name < b.name;
+            });
+            for (const auto& image : images) {
+                index << "sprite " << image.name << " " << image.page << " " << image.x << " " << image.y
+                      << " " << image.surface->w << " " << image.surface->h << "\n";
+            }
+        }
+
+        if (ok) {
+            std::cout << "Cooked " << images.size() << " sprites into " << pages.size() << " atlas page(s)" << std::endl;
+        }
+    }
+
+    for (auto& image : images) {
+        SDL_FreeSurface(image.surface);
+    }
+    IMG_Quit();
+    SDL_Quit();
+    return ok ? 0 : 1;
+}
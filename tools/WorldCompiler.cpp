@@ -0,0 +1,405 @@
+// Build-time world compiler: turns a text world description into the
+// binary format in WorldFormat.h, which the game memory-maps at startup.
+//
+// Usage: yolo_world_compiler <source.world> <output.ywld>
+//
+// Source syntax, one directive per line ('#' starts a comment line):
+//   size <width tiles> <height tiles>
+//   tile <char> <ground> <overlay> [solid] [flower_bed] [bush] [door] [roof_ridge]
+//   map                       followed by <height> rows of <width> tile chars, then "end"
+//   collider <x> <y> <w> <h>  sub-tile collision in world pixels
+//   zone <type> <x> <y> <w> <h>
+//   spawn <kind> <name> <x> <y> [patrol width]
+//   line <text>               dialogue line for the zone or spawn above it
+
+#include "ChunkSource.h"
+#include "Interactable.h"
+#include "WorldFormat.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace WorldFormat;
+
+namespace {
+
+template <typename T>
+struct NamedValue {
+    const char* name;
+    T value;
+};
+
+const NamedValue<TileGround> GROUND_NAMES[] = {
+    {"NONE", TileGround::NONE}, {"SKY", TileGround::SKY}, {"GRASS", TileGround::GRASS},
+};
+
+const NamedValue<TileOverlay> OVERLAY_NAMES[] = {
+    {"NONE", TileOverlay::NONE},
+    {"WATER_TOP", TileOverlay::WATER_TOP},
+    {"WATER_BOTTOM", TileOverlay::WATER_BOTTOM},
+    {"WATER_LEFT", TileOverlay::WATER_LEFT},
+    {"WATER_RIGHT", TileOverlay::WATER_RIGHT},
+    {"HOUSE_ROOF", TileOverlay::HOUSE_ROOF},
+    {"HOUSE_WALL", TileOverlay::HOUSE_WALL},
+    {"FARM", TileOverlay::FARM},
+    {"GARDEN", TileOverlay::GARDEN},
+    {"PATH_HORIZONTAL", TileOverlay::PATH_HORIZONTAL},
+    {"PATH_VERTICAL", TileOverlay::PATH_VERTICAL},
+};
+
+const NamedValue<Uint8> FLAG_NAMES[] = {
+    {"solid", TILE_SOLID},
+    {"flower_bed", TILE_FLOWER_BED},
+    {"bush", TILE_BUSH},
+    {"door", TILE_DOOR},
+    {"roof_ridge", TILE_ROOF_RIDGE},
+};
+
+const NamedValue<InteractableType> ZONE_NAMES[] = {
+    {"HOUSE", InteractableType::HOUSE},
+    {"FARM", InteractableType::FARM},
+    {"FARM_FLOWERS", InteractableType::FARM_FLOWERS},
+    {"GARDEN", InteractableType::GARDEN},
+    {"GARDEN_FLOWER", InteractableType::GARDEN_FLOWER},
+    {"GARDEN_BUSH", InteractableType::GARDEN_BUSH},
+    {"WATER", InteractableType::WATER},
+};
+
+const NamedValue<EntityKind> KIND_NAMES[] = {
+    {"NPC", EntityKind::NPC}, {"DOG", EntityKind::DOG}, {"FLOWER_PATCH", EntityKind::FLOWER_PATCH},
+    {"LANTERN", EntityKind::LANTERN},
+};
+
+template <typename T, size_t N>
+bool Lookup(const NamedValue<T> (&table)[N], const std::string& name, T& value) {
+    for (const auto& entry : table) {
+        if (name == entry.name) {
+            value = entry.value;
+            return true;
+        }
+    }
+    return false;
+}
+
+struct CompiledWorld {
+    int width = 0;
+    int height = 0;
+    std::vector<TileRecord> tiles;
+    std::vector<RectRecord> colliders;
+    std::vector<ZoneRecord> zones;
+    std::vector<SpawnRecord> spawns;      // Source order, grouped by chunk when written
+    std::vector<ChunkRecord> chunks;
+    std::vector<uint32_t> chunkColliders;
+    std::vector<uint32_t> lines;
+    std::string strings;
+    std::map<std::string, uint32_t> stringOffsets;
+
+    uint32_t AddString(const std::string& text) {
+        auto it = stringOffsets.find(text);
+        if (it != stringOffsets.end()) return it->second;
+
+        uint32_t offset = static_cast<uint32_t>(strings.size());
+        strings += text;
+        strings += '\0';
+        stringOffsets[text] = offset;
+        return offset;
+    }
+};
+
+class Parser {
+public:
+    Parser(const std::string& path, CompiledWorld& world) : path_(path), world_(world), lineNumber_(0) {}
+
+    bool Parse() {
+        std::ifstream source(path_);
+        if (!source) {
+            std::cerr << "Failed to open " << path_ << std::endl;
+            return false;
+        }
+
+        std::string line;
+        while (std::getline(source, line)) {
+            lineNumber_++;
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.empty() || line[0] == '#') continue;
+
+            std::istringstream fields(line);
+            std::string directive;
+            if (!(fields >> directive)) continue;
+
+            bool ok;
+            if (directive == "size") ok = ParseSize(fields);
+            else if (directive == "tile") ok = ParseTile(fields);
+            else if (directive == "map") ok = ParseMap(source);
+            else if (directive == "collider") ok = ParseCollider(fields);
+            else if (directive == "zone") ok = ParseZone(fields);
+            else if (directive == "spawn") ok = ParseSpawn(fields);
+            else if (directive == "line") ok = ParseLine(line);
+            else ok = Error("unknown directive '" + directive + "'");
+
+            if (!ok) return false;
+            if (directive != "line" && directive != "zone" && directive != "spawn") {
+                lineCount_ = nullptr;
+            }
+        }
+
+        if (world_.tiles.empty()) {
+            return Error("no map");
+        }
+        return true;
+    }
+
+private:
+    bool Error(const std::string& message) {
+        std::cerr << path_ << ":" << lineNumber_ << ": " << message << std::endl;
+        return false;
+    }
+
+    bool ParseSize(std::istringstream& fields) {
+        if (!(fields >> world_.width >> world_.height) || world_.width <= 0 || world_.height <= 0) {
+            return Error("expected size <width> <height>");
+        }
+        return true;
+    }
+
+    bool ParseTile(std::istringstream& fields) {
+        std::string symbol, groundName, overlayName, flagName;
+        if (!(fields >> symbol >> groundName >> overlayName) || symbol.size() != 1) {
+            return Error("expected tile <char> <ground> <overlay> [flags...]");
+        }
+
+        Tile tile;
+        if (!Lookup(GROUND_NAMES, groundName, tile.ground)) return Error("unknown ground '" + groundName + "'");
+        if (!Lookup(OVERLAY_NAMES, overlayName, tile.overlay)) return Error("unknown overlay '" + overlayName + "'");
+        while (fields >> flagName) {
+            Uint8 flag = 0;
+            if (!Lookup(FLAG_NAMES, flagName, flag)) return Error("unknown tile flag '" + flagName + "'");
+            tile.flags |= flag;
+        }
+
+        legend_[symbol[0]] = tile;
+        return true;
+    }
+
+    bool ParseMap(std::istream& source) {
+        if (world_.width <= 0) return Error("map before size");
+
+        std::string row;
+        int y = 0;
+        while (std::getline(source, row)) {
+            lineNumber_++;
+            if (!row.empty() && row.back() == '\r') row.pop_back();
+            if (row == "end") break;
+
+            if (y >= world_.height) return Error("map has more than " + std::to_string(world_.height) + " rows");
+            if (static_cast<int>(row.size()) != world_.width) {
+                return Error("map row is " + std::to_string(row.size()) + " tiles, expected " + std::to_string(world_.width));
+            }
+
+            for (char symbol : row) {
+                auto it = legend_.find(symbol);
+                if (it == legend_.end()) return Error(std::string("no tile defined for '") + symbol + "'");
+
+                const Tile& tile = it->second;
+                world_.tiles.push_back({static_cast<uint8_t>(tile.ground), static_cast<uint8_t>(tile.overlay), tile.flags, 0});
+            }
+            y++;
+        }
+
+        if (y != world_.height) return Error("map has " + std::to_string(y) + " rows, expected " + std::to_string(world_.height));
+        return true;
+    }
+
+    bool ParseCollider(std::istringstream& fields) {
+        RectRecord rect;
+        if (!(fields >> rect.x >> rect.y >> rect.w >> rect.h) || rect.w <= 0 || rect.h <= 0) {
+            return Error("expected collider <x> <y> <w> <h>");
+        }
+        world_.colliders.push_back(rect);
+        return true;
+    }
+
+    bool ParseZone(std::istringstream& fields) {
+        std::string typeName;
+        ZoneRecord zone = {};
+        if (!(fields >> typeName >> zone.bounds.x >> zone.bounds.y >> zone.bounds.w >> zone.bounds.h)) {
+            return Error("expected zone <type> <x> <y> <w> <h>");
+        }
+
+        InteractableType type;
+        if (!Lookup(ZONE_NAMES, typeName, type)) return Error("unknown zone type '" + typeName + "'");
+        zone.type = static_cast<uint32_t>(type);
+        zone.firstLine = static_cast<uint32_t>(world_.lines.size());
+
+        world_.zones.push_back(zone);
+        lineCount_ = &world_.zones.back().lineCount;
+        return true;
+    }
+
+    bool ParseSpawn(std::istringstream& fields) {
+        std::string kindName, name;
+        SpawnRecord spawn = {};
+        if (!(fields >> kindName >> name >> spawn.x >> spawn.y)) {
+            return Error("expected spawn <kind> <name> <x> <y> [patrol width]");
+        }
+        fields >> spawn.patrolWidth;
+
+        EntityKind kind;
+        if (!Lookup(KIND_NAMES, kindName, kind)) return Error("unknown entity kind '" + kindName + "'");
+        if (spawn.x < 0 || spawn.y < 0 || spawn.x >= world_.width * WorldChunkData::TILE_SIZE ||
+            spawn.y >= world_.height * WorldChunkData::TILE_SIZE) {
+            return Error("spawn '" + name + "' is outside the map");
+        }
+        spawn.kind = static_cast<uint32_t>(kind);
+        spawn.name = world_.AddString(name);
+        spawn.firstLine = static_cast<uint32_t>(world_.lines.size());
+
+        world_.spawns.push_back(spawn);
+        lineCount_ = &world_.spawns.back().lineCount;
+        return true;
+    }
+
+    bool ParseLine(const std::string& line) {
+        if (!lineCount_) return Error("line without a zone or spawn above it");
+
+        // Everything after "line " is the text, spaces included
+        size_t start = line.find_first_not_of(' ', line.find("line") + 4);
+        world_.lines.push_back(world_.AddString(start == std::string::npos ? "" : line.substr(start)));
+        (*lineCount_)++;
+        return true;
+    }
+
+    std::string path_;
+    CompiledWorld& world_;
+    int lineNumber_;
+    std::map<char, Tile> legend_;
+    uint32_t* lineCount_ = nullptr; // Zone or spawn the next "line" belongs to
+};
+
+bool RectsOverlap(const RectRecord& a, const RectRecord& b) {
+    return a.x < b.x + b.w && a.x + a.w > b.x &&
+           a.y < b.y + b.h && a.y + a.h > b.y;
+}
+
+// Groups spawns by chunk and lists the colliders touching each chunk
+void BuildChunks(CompiledWorld& world) {
+    const int TILES = WorldChunkData::TILES;
+    const int CHUNK_SIZE = WorldChunkData::CHUNK_SIZE;
+    int widthChunks = (world.width + TILES - 1) / TILES;
+    int heightChunks = (world.height + TILES - 1) / TILES;
+
+    std::vector<SpawnRecord> grouped;
+    for (int chunkY = 0; chunkY < heightChunks; ++chunkY) {
+        for (int chunkX = 0; chunkX < widthChunks; ++chunkX) {
+            ChunkRecord chunk = {};
+            chunk.firstSpawn = static_cast<uint32_t>(grouped.size());
+            chunk.firstCollider = static_cast<uint32_t>(world.chunkColliders.size());
+
+            for (const auto& spawn : world.spawns) {
+                if (static_cast<int>(spawn.x) / CHUNK_SIZE == chunkX && static_cast<int>(spawn.y) / CHUNK_SIZE == chunkY) {
+                    grouped.push_back(spawn);
+                    chunk.spawnCount++;
+                }
+            }
+
+            RectRecord bounds = {chunkX * CHUNK_SIZE, chunkY * CHUNK_SIZE, CHUNK_SIZE, CHUNK_SIZE};
+            for (size_t i = 0; i < world.colliders.size(); ++i) {
+                if (RectsOverlap(world.colliders[i], bounds)) {
+                    world.chunkColliders.push_back(static_cast<uint32_t>(i));
+                    chunk.colliderCount++;
+                }
+            }
+
+            world.chunks.push_back(chunk);
+        }
+    }
+    world.spawns = grouped;
+}
+
+template <typename T>
+Section PlaceSection(const std::vector<T>& records, uint32_t& offset) {
+    Section section = {offset, static_cast<uint32_t>(records.size())};
+    offset += static_cast<uint32_t>((records.size() * sizeof(T) + 3) & ~size_t(3));
+    return section;
+}
+
+template <typename T>
+void WriteSection(std::ofstream& out, const std::vector<T>& records) {
+    size_t bytes = records.size() * sizeof(T);
+    if (bytes > 0) {
+        out.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(bytes));
+    }
+    const char padding[4] = {0, 0, 0, 0};
+    out.write(padding, static_cast<std::streamsize>(((bytes + 3) & ~size_t(3)) - bytes));
+}
+
+bool WriteWorld(const CompiledWorld& world, const std::string& path) {
+    std::vector<char> strings(world.strings.begin(), world.strings.end());
+
+    Header header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.widthTiles = static_cast<uint32_t>(world.width);
+    header.heightTiles = static_cast<uint32_t>(world.height);
+    header.tileSize = WorldChunkData::TILE_SIZE;
+    header.chunkTiles = WorldChunkData::TILES;
+
+    uint32_t offset = sizeof(Header);
+    header.tiles = PlaceSection(world.tiles, offset);
+    header.colliders = PlaceSection(world.colliders, offset);
+    header.zones = PlaceSection(world.zones, offset);
+    header.spawns = PlaceSection(world.spawns, offset);
+    header.chunks = PlaceSection(world.chunks, offset);
+    header.chunkColliders = PlaceSection(world.chunkColliders, offset);
+    header.lines = PlaceSection(world.lines, offset);
+    header.strings = PlaceSection(strings, offset);
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        std::cerr << "Failed to open " << path << std::endl;
+        return false;
+    }
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    WriteSection(out, world.tiles);
+    WriteSection(out, world.colliders);
+    WriteSection(out, world.zones);
+    WriteSection(out, world.spawns);
+    WriteSection(out, world.chunks);
+    WriteSection(out, world.chunkColliders);
+    WriteSection(out, world.lines);
+    WriteSection(out, strings);
+    return static_cast<bool>(out);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <source.world> <output.ywld>" << std::endl;
+        return 1;
+    }
+
+    CompiledWorld world;
+    world.AddString(""); // Offset 0 is always the empty string
+
+    Parser parser(argv[1], world);
+    if (!parser.Parse()) {
+        return 1;
+    }
+
+    BuildChunks(world);
+    if (!WriteWorld(world, argv[2])) {
+        return 1;
+    }
+
+    std::cout << "Compiled " << argv[1] << ": " << world.width << "x" << world.height << " tiles, "
+              << world.zones.size() << " zones, " << world.spawns.size() << " spawns, "
+              << world.colliders.size() << " colliders" << std::endl;
+    return 0;
+}